@@ -65,6 +65,13 @@ public:
 	typedef void *(*PairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int);
 	typedef void (*UnpairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int, void *);
 	typedef void *(*CheckPairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int, void *);
+	// Must call the function for every index below the count, possibly from several threads,
+	// and only return once all the calls are done.
+	typedef void (*ParallelForCallback)(void *, void (*)(void *, uint32_t), void *, uint32_t);
+
+	// Default number of changed items below which the pairing queries are run serially,
+	// as dispatching them to other threads costs more than it saves.
+	static constexpr uint32_t DEFAULT_PARALLEL_PAIRING_MIN_ITEMS = 64;
 
 	// allow locally toggling thread safety if the template has been compiled with BVH_THREAD_SAFE
 	void params_set_thread_safe(bool p_enable) {
@@ -88,6 +95,20 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// When set, the tree queries of the changed items are dispatched through this callback when checking
+	// for collisions. Pair and unpair callbacks are still sent from the calling thread, in the same order.
+	void params_set_parallel_pairing(ParallelForCallback p_callback, void *p_userdata) {
+		BVH_LOCKED_FUNCTION
+		parallel_pairing_callback = p_callback;
+		parallel_pairing_callback_userdata = p_userdata;
+	}
+
+	// The queries are only dispatched to the parallel pairing callback when at least this many items changed.
+	void params_set_parallel_pairing_min_items(uint32_t p_count) {
+		BVH_LOCKED_FUNCTION
+		_parallel_pairing_min_items = p_count;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -381,6 +402,38 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Culls many segments at once, traversing the tree once per packet of BVH_SEGMENT_PACKET_SIZE segments.
+	// The results of segment i are written from p_result_array[i * p_result_max], their count to r_result_counts[i].
+	void cull_segments(const POINT *p_from, const POINT *p_to, int p_segment_count, T **p_result_array, int *r_result_counts, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		BVH_LOCKED_FUNCTION
+		typename BVHTREE_CLASS::CullSegmentsParams params;
+
+		params.tester = p_tester;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.result_max = p_result_max;
+
+		for (int packet_start = 0; packet_start < p_segment_count; packet_start += BVH_SEGMENT_PACKET_SIZE) {
+			params.segment_count = MIN(p_segment_count - packet_start, BVH_SEGMENT_PACKET_SIZE);
+			params.result_array = p_result_array + packet_start * p_result_max;
+			params.subindex_array = p_subindex_array ? p_subindex_array + packet_start * p_result_max : nullptr;
+			params.result_counts = r_result_counts + packet_start;
+
+			for (int i = 0; i < BVH_SEGMENT_PACKET_SIZE; i++) {
+				// unused lanes repeat the last segment, they are masked out of the results
+				int segment_index = packet_start + MIN(i, params.segment_count - 1);
+				const POINT &from = p_from[segment_index];
+				POINT dir = p_to[segment_index] - from;
+				for (int axis = 0; axis < POINT::AXIS_COUNT; axis++) {
+					params.from[axis][i] = from[axis];
+					// a large value instead of infinity keeps the slab test free of NaNs
+					params.inv_dir[axis][i] = dir[axis] != 0 ? 1.0 / dir[axis] : 1e30;
+				}
+			}
+
+			tree.cull_segments(params);
+		}
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -444,26 +497,41 @@ private:
 		params.result_array = nullptr;
 		params.subindex_array = nullptr;
 
-		for (const BVHHandle &h : changed_items) {
+		// The pairing callbacks don't modify the tree, so the queries can all be done up front.
+		bool parallel_pairing = parallel_pairing_callback && changed_items.size() >= _parallel_pairing_min_items;
+		if (parallel_pairing) {
+			if (_changed_item_hits.size() < changed_items.size()) {
+				_changed_item_hits.resize(changed_items.size());
+			}
+			parallel_pairing_callback(parallel_pairing_callback_userdata, &BVH_Manager::_cull_changed_item, this, changed_items.size());
+		}
+
+		for (uint32_t changed_item_index = 0; changed_item_index < changed_items.size(); changed_item_index++) {
+			const BVHHandle &h = changed_items[changed_item_index];
+
 			// use the expanded aabb for pairing
 			const BOUNDS &expanded_aabb = tree._pairs[h.id()].expanded_aabb;
 			BVHABB_CLASS abb;
 			abb.from(expanded_aabb);
 
-			tree.item_fill_cullparams(h, params);
-
 			// find all the existing paired aabbs that are no longer
 			// paired, and send callbacks
 			_find_leavers(h, abb, p_full_check);
 
 			uint32_t changed_item_ref_id = h.id();
 
-			params.abb = abb;
+			const LocalVector<uint32_t, uint32_t, true> *hits = &tree._cull_hits;
+			if (parallel_pairing) {
+				hits = &_changed_item_hits[changed_item_index];
+			} else {
+				tree.item_fill_cullparams(h, params);
+				params.abb = abb;
 
-			params.result_count_overall = 0; // might not be needed
-			tree.cull_aabb(params, false);
+				params.result_count_overall = 0; // might not be needed
+				tree.cull_aabb(params, false);
+			}
 
-			for (const uint32_t ref_id : tree._cull_hits) {
+			for (const uint32_t ref_id : *hits) {
 				// don't collide against ourself
 				if (ref_id == changed_item_ref_id) {
 					continue;
@@ -480,6 +548,24 @@ private:
 		_reset();
 	}
 
+	static void _cull_changed_item(void *p_self, uint32_t p_index) {
+		BVH_Manager *self = static_cast<BVH_Manager *>(p_self);
+		BVHTREE_CLASS &tree = self->tree;
+		const BVHHandle &h = self->changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_hits(params, self->_changed_item_hits[p_index]);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -765,12 +851,16 @@ private:
 	void *pair_callback_userdata = nullptr;
 	void *unpair_callback_userdata = nullptr;
 	void *check_pair_callback_userdata = nullptr;
+	ParallelForCallback parallel_pairing_callback = nullptr;
+	void *parallel_pairing_callback_userdata = nullptr;
 
 	BVHTREE_CLASS tree;
 
 	// for collision pairing,
 	// maintain a list of all items moved etc on each frame / tick
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _changed_item_hits;
+	uint32_t _parallel_pairing_min_items = DEFAULT_PARALLEL_PAIRING_MIN_ITEMS;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
 	class BVHLockedFunction {
@@ -52,6 +52,9 @@
 // not sure if this is better yet so making optional
 #define BVH_EXPAND_LEAF_AABBS
 
+// number of segments culled together by cull_segments
+#define BVH_SEGMENT_PACKET_SIZE 32
+
 // never do these checks in release
 #ifdef DEV_ENABLED
 //#define BVH_VERBOSE
@@ -364,6 +367,7 @@ private:
 			// we defer the refit updates until the update function is called once per frame
 			if (refit) {
 				leaf.set_dirty(true);
+				_refit_tree_mask |= 1 << p_tree_id;
 			}
 		} else {
 			// remove node if empty
@@ -480,6 +480,13 @@ uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) co
 	task_mutex.unlock();
 	return elements;
 }
+
+int WorkerThreadPool::get_thread_index() const {
+	// Thread IDs are only inserted in init(), before any task runs.
+	const int *index = thread_ids.getptr(Thread::get_caller_id());
+	return index ? *index : -1;
+}
+
 bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 	task_mutex.lock();
 	const Group *const *groupp = groups.getptr(p_group);
@@ -70,7 +70,9 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 	return &sync_sems[idx];
 }
 
-CommandQueueMT::CommandQueueMT(bool p_sync) {
+CommandQueueMT::CommandQueueMT(bool p_sync, bool p_defer_nested_flush) {
+	defer_nested_flush = p_defer_nested_flush;
+
 	if (p_sync) {
 		sync = memnew(Semaphore);
 	}
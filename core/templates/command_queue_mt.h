@@ -36,6 +36,7 @@
 #include "core/os/semaphore.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
@@ -336,19 +337,29 @@ class CommandQueueMT {
 		SYNC_SEMAPHORES = 8
 	};
 
-	LocalVector<uint8_t> command_mem;
+	// Commands are pushed into one buffer while the other one is being flushed,
+	// so pushing never has to wait for the commands being run.
+	LocalVector<uint8_t> command_buffers[2];
+	LocalVector<uint8_t> *command_mem = &command_buffers[0];
+	LocalVector<uint8_t> *flush_mem = &command_buffers[1];
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex mutex;
+	Mutex flush_mutex;
+	bool flushing = false;
+	bool defer_nested_flush = false;
+	// Whether command_mem holds any command, so it can be checked without locking.
+	SafeFlag pending;
 	Semaphore *sync = nullptr;
 
 	template <class T>
 	T *allocate() {
 		// alloc size is size+T+safeguard
 		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
+		uint64_t size = command_mem->size();
+		command_mem->resize(size + alloc_size + 8);
+		*(uint64_t *)&(*command_mem)[size] = alloc_size;
+		T *cmd = memnew_placement(&(*command_mem)[size + 8], T);
+		pending.set();
 		return cmd;
 	}
 
@@ -359,16 +370,14 @@ class CommandQueueMT {
 		return ret;
 	}
 
-	void _flush() {
-		lock();
-
+	void _run_commands(LocalVector<uint8_t> &p_mem) {
 		uint64_t read_ptr = 0;
-		uint64_t limit = command_mem.size();
+		uint64_t limit = p_mem.size();
 
 		while (read_ptr < limit) {
-			uint64_t size = *(uint64_t *)&command_mem[read_ptr];
+			uint64_t size = *(uint64_t *)&p_mem[read_ptr];
 			read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(&p_mem[read_ptr]);
 
 			cmd->call(); //execute the function
 			cmd->post(); //release in case it needs sync/ret
@@ -376,9 +385,38 @@ class CommandQueueMT {
 
 			read_ptr += size;
 		}
+	}
 
-		command_mem.clear();
+	void _flush() {
+		MutexLock flush_lock(flush_mutex);
+		if (flushing) {
+			// Flushing from one of the commands being run.
+			if (defer_nested_flush) {
+				// Anything it pushed is run by the next flush.
+				return;
+			}
+
+			// Run what it pushed right away, moved to a buffer of its own since both are in use.
+			LocalVector<uint8_t> nested_mem;
+			lock();
+			nested_mem = *command_mem;
+			command_mem->clear();
+			pending.clear();
+			unlock();
+
+			_run_commands(nested_mem);
+			return;
+		}
+
+		lock();
+		SWAP(command_mem, flush_mem);
+		pending.clear();
 		unlock();
+
+		flushing = true;
+		_run_commands(*flush_mem);
+		flush_mem->clear();
+		flushing = false;
 	}
 
 	void lock();
@@ -400,7 +438,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(pending.is_set())) {
 			_flush();
 		}
 	}
@@ -414,7 +452,7 @@ public:
 		_flush();
 	}
 
-	CommandQueueMT(bool p_sync);
+	CommandQueueMT(bool p_sync, bool p_defer_nested_flush = false);
 	~CommandQueueMT();
 };
 
@@ -84,6 +84,7 @@ using namespace NavigationUtilities;
 GodotNavigationServer::GodotNavigationServer() {}
 
 GodotNavigationServer::~GodotNavigationServer() {
+	_finish_path_query_batches();
 	flush_queries();
 }
 
@@ -222,6 +223,20 @@ real_t GodotNavigationServer::map_get_link_connection_radius(RID p_map) const {
 	return map->get_link_connection_radius();
 }
 
+COMMAND_2(map_set_path_cluster_size, RID, p_map, real_t, p_cluster_size) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND(map == nullptr);
+
+	map->set_path_cluster_size(p_cluster_size);
+}
+
+real_t GodotNavigationServer::map_get_path_cluster_size(RID p_map) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND_V(map == nullptr, 0);
+
+	return map->get_path_cluster_size();
+}
+
 Vector<Vector3> GodotNavigationServer::map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector<Vector3>());
@@ -1015,9 +1030,15 @@ void GodotNavigationServer::set_active(bool p_active) {
 void GodotNavigationServer::flush_queries() {
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
-	MutexLock lock(commands_mutex);
-	MutexLock lock2(operations_mutex);
+	MutexLock lock(operations_mutex);
+	MutexLock commands_lock(commands_mutex);
 
+	MutexLock gate_lock(maps_write_gate);
+	RWLockWrite write_lock(maps_rwlock);
+	_flush_commands();
+}
+
+void GodotNavigationServer::_flush_commands() {
 	for (SetCommand *command : commands) {
 		command->exec(this);
 		memdelete(command);
@@ -1026,16 +1047,38 @@ void GodotNavigationServer::flush_queries() {
 }
 
 void GodotNavigationServer::map_force_update(RID p_map) {
-	NavMap *map = map_owner.get_or_null(p_map);
-	ERR_FAIL_COND(map == nullptr);
+	MutexLock lock(operations_mutex);
+	MutexLock commands_lock(commands_mutex);
 
-	flush_queries();
+	// Same write section for the commands and the synchronization, see process().
+	MutexLock gate_lock(maps_write_gate);
+	RWLockWrite write_lock(maps_rwlock);
+	_flush_commands();
 
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND(map == nullptr);
 	map->sync();
 }
 
 void GodotNavigationServer::process(real_t p_delta_time) {
-	flush_queries();
+	// In c++ we can't be sure that this is performed in the main thread
+	// even with mutable functions.
+	MutexLock lock(operations_mutex);
+	{
+		// Freed regions and links leave their polygons in the map until the synchronization removes them,
+		// so path queries solved on the WorkerThreadPool must not run between the commands and the synchronization.
+		// They only wait for this section, not the map steps and callbacks.
+		MutexLock commands_lock(commands_mutex);
+		MutexLock gate_lock(maps_write_gate);
+		RWLockWrite write_lock(maps_rwlock);
+		_flush_commands();
+
+		if (active) {
+			for (uint32_t i(0); i < active_maps.size(); i++) {
+				active_maps[i]->sync();
+			}
+		}
+	}
 
 	if (!active) {
 		return;
@@ -1050,11 +1093,7 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
 
-	// In c++ we can't be sure that this is performed in the main thread
-	// even with mutable functions.
-	MutexLock lock(operations_mutex);
 	for (uint32_t i(0); i < active_maps.size(); i++) {
-		active_maps[i]->sync();
 		active_maps[i]->step(p_delta_time);
 		active_maps[i]->dispatch_callbacks();
 
@@ -1088,6 +1127,12 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_parameters) const {
 	PathQueryResult r_query_result;
 
+	{
+		// Let a waiting map update go first, so a long path query batch can't hold it back.
+		MutexLock gate_lock(maps_write_gate);
+	}
+	RWLockRead read_lock(maps_rwlock);
+
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
 	ERR_FAIL_COND_V(map == nullptr, r_query_result);
 
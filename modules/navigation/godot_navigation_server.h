@@ -37,6 +37,7 @@
 #include "nav_obstacle.h"
 #include "nav_region.h"
 
+#include "core/os/rw_lock.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -67,13 +68,19 @@ class GodotNavigationServer : public NavigationServer3D {
 	/// Mutex used to make any operation threadsafe.
 	Mutex operations_mutex;
 
+	/// Path queries run under the read lock, the maps are only modified under the write lock.
+	/// Writers take `maps_write_gate` first, it stops new queries from starting while they wait.
+	mutable RWLock maps_rwlock;
+	mutable Mutex maps_write_gate;
+
 	LocalVector<SetCommand *> commands;
 
-	mutable RID_Owner<NavLink> link_owner;
-	mutable RID_Owner<NavMap> map_owner;
-	mutable RID_Owner<NavRegion> region_owner;
-	mutable RID_Owner<NavAgent> agent_owner;
-	mutable RID_Owner<NavObstacle> obstacle_owner;
+	// Thread safe, path query batches look up the maps from the WorkerThreadPool.
+	mutable RID_Owner<NavLink, true> link_owner;
+	mutable RID_Owner<NavMap, true> map_owner;
+	mutable RID_Owner<NavRegion, true> region_owner;
+	mutable RID_Owner<NavAgent, true> agent_owner;
+	mutable RID_Owner<NavObstacle, true> obstacle_owner;
 
 	bool active = true;
 	LocalVector<NavMap *> active_maps;
@@ -119,6 +126,9 @@ public:
 	COMMAND_2(map_set_link_connection_radius, RID, p_map, real_t, p_connection_radius);
 	virtual real_t map_get_link_connection_radius(RID p_map) const override;
 
+	COMMAND_2(map_set_path_cluster_size, RID, p_map, real_t, p_cluster_size);
+	virtual real_t map_get_path_cluster_size(RID p_map) const override;
+
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const override;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const override;
@@ -233,6 +243,7 @@ public:
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
+	void _flush_commands();
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
 };
@@ -102,6 +102,14 @@ void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
 	regenerate_links = true;
 }
 
+void NavMap::set_path_cluster_size(real_t p_path_cluster_size) {
+	if (path_cluster_size == p_path_cluster_size) {
+		return;
+	}
+	path_cluster_size = p_path_cluster_size;
+	regenerate_links = true;
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = static_cast<int>(Math::floor(p_pos.x / cell_size));
 	const int y = static_cast<int>(Math::floor(p_pos.y / cell_height));
@@ -136,33 +144,9 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
 	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+	// Only consider the polygons in regions with compatible layers.
+	begin_poly = _get_closest_polygon(p_origin, true, p_navigation_layers, begin_d, begin_point);
+	end_poly = _get_closest_polygon(p_destination, true, p_navigation_layers, end_d, end_point);
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -194,24 +178,34 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	// Take the buffers of an idle query slot, they are sized for all the map polygons
+	// so reached polygons are indexed by their id instead of being searched.
+	PathQuerySlot *path_query_slot = _acquire_path_query_slot();
+	LocalVector<gd::NavigationPoly> &navigation_polys = path_query_slot->navigation_polys;
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostLessThan, gd::NavPolyHeapIndexer> &traversable_polys = path_query_slot->traversable_polys;
 
 	// Add the start polygon to the reachable navigation polygons.
-	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
-	begin_navigation_poly.self_id = 0;
+	gd::NavigationPoly &begin_navigation_poly = navigation_polys[begin_poly->id];
+	begin_navigation_poly = gd::NavigationPoly(begin_poly);
+	begin_navigation_poly.query_id = path_query_slot->query_id;
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	// When the start and end polygons are in different clusters first search the route between
+	// the clusters, then only search the polygons of the clusters on that route.
+	bool use_corridor = false;
+	if (!path_clusters.is_empty()) {
+		const uint32_t begin_cluster = polygon_clusters[begin_poly->id];
+		const uint32_t end_cluster = polygon_clusters[end_poly->id];
+		if (begin_cluster != end_cluster) {
+			use_corridor = _find_path_corridor(path_query_slot, begin_cluster, end_cluster, end_point, p_navigation_layers);
+		}
+	}
+	const LocalVector<gd::NavigationCluster> &navigation_clusters = path_query_slot->navigation_clusters;
 
 	// This is an implementation of the A* algorithm.
-	int least_cost_id = 0;
+	int least_cost_id = begin_poly->id;
 	int prev_least_cost_id = -1;
 	bool found_route = false;
 
@@ -231,6 +225,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Stay in the clusters of the route found between them.
+				if (use_corridor && navigation_clusters[polygon_clusters[connection.polygon->id]].corridor_query_id != path_query_slot->query_id) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -244,42 +243,59 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
-
-				if (already_visited_polygon_index != -1) {
-					// Polygon already visited, check if we can reduce the travel cost.
-					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
-					if (new_distance < avp.traveled_distance) {
-						avp.back_navigation_poly_id = least_cost_id;
-						avp.back_navigation_edge = connection.edge;
-						avp.back_navigation_edge_pathway_start = connection.pathway_start;
-						avp.back_navigation_edge_pathway_end = connection.pathway_end;
-						avp.traveled_distance = new_distance;
-						avp.entry = new_entry;
+				gd::NavigationPoly &neighbor_poly = navigation_polys[connection.polygon->id];
+				if (neighbor_poly.query_id == path_query_slot->query_id) {
+					// Polygon already reached, check if we can reduce the travel cost.
+					// Polygons already visited are updated too. Their entry point moves with the path,
+					// so a later path can still be shorter and the path is traced back through them.
+					if (new_distance < neighbor_poly.traveled_distance) {
+						neighbor_poly.back_navigation_poly_id = least_cost_id;
+						neighbor_poly.back_navigation_edge = connection.edge;
+						neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+						neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+						neighbor_poly.traveled_distance = new_distance;
+						neighbor_poly.distance_to_destination = new_entry.distance_to(end_point) * neighbor_poly.poly->owner->get_travel_cost();
+						neighbor_poly.entry = new_entry;
+
+						// Move the polygon up in the heap now that it is cheaper, if it still waits to be visited.
+						if (neighbor_poly.traversable_poly_index != UINT32_MAX) {
+							traversable_polys.shift(neighbor_poly.traversable_poly_index);
+						}
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
-					gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
-					new_navigation_poly.self_id = navigation_polys.size();
-					new_navigation_poly.back_navigation_poly_id = least_cost_id;
-					new_navigation_poly.back_navigation_edge = connection.edge;
-					new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
-					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
-					new_navigation_poly.traveled_distance = new_distance;
-					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
+					neighbor_poly = gd::NavigationPoly(connection.polygon);
+					neighbor_poly.query_id = path_query_slot->query_id;
+					neighbor_poly.back_navigation_poly_id = least_cost_id;
+					neighbor_poly.back_navigation_edge = connection.edge;
+					neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+					neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+					neighbor_poly.traveled_distance = new_distance;
+					neighbor_poly.distance_to_destination = new_entry.distance_to(end_point) * neighbor_poly.poly->owner->get_travel_cost();
+					neighbor_poly.entry = new_entry;
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					traversable_polys.push(&neighbor_poly);
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
+		// When there are no more polygons to visit at this point it means the End Polygon is not reachable
+		if (traversable_polys.is_empty()) {
+			if (use_corridor) {
+				// The route between the clusters could not be followed, search all the polygons instead.
+				use_corridor = false;
+				path_query_slot->next_query();
+				navigation_polys[begin_poly->id].query_id = path_query_slot->query_id;
+				least_cost_id = begin_poly->id;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+
+				continue;
+			}
 
-		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -301,13 +317,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				}
 			}
 
-			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
-			least_cost_id = 0;
+			// Forget the reached polygons, only keeping the start one.
+			path_query_slot->next_query();
+			navigation_polys[begin_poly->id].query_id = path_query_slot->query_id;
+			least_cost_id = begin_poly->id;
 			prev_least_cost_id = -1;
 
 			reachable_end = nullptr;
@@ -315,32 +328,22 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			real_t cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
+		// Take the polygon with the minimum cost from the polygons to visit.
+		gd::NavigationPoly *least_cost_poly = traversable_polys.pop();
+		least_cost_poly->traversable_poly_index = UINT32_MAX;
+		least_cost_id = least_cost_poly->poly->id;
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
-			real_t d = navigation_polys[least_cost_id].entry.distance_to(p_destination) * navigation_polys[least_cost_id].poly->owner->get_travel_cost();
+			real_t d = least_cost_poly->entry.distance_to(p_destination) * least_cost_poly->poly->owner->get_travel_cost();
 			if (reachable_d > d) {
 				reachable_d = d;
-				reachable_end = navigation_polys[least_cost_id].poly;
+				reachable_end = least_cost_poly->poly;
 			}
 		}
 
 		// Check if we reached the end
-		if (navigation_polys[least_cost_id].poly == end_poly) {
+		if (least_cost_poly->poly == end_poly) {
 			found_route = true;
 			break;
 		}
@@ -348,6 +351,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 	// If we did not find a route, return an empty path.
 	if (!found_route) {
+		_release_path_query_slot(path_query_slot);
 		return Vector<Vector3>();
 	}
 
@@ -481,6 +485,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		}
 	}
 
+	_release_path_query_slot(path_query_slot);
+
 	// Ensure post conditions (path arrays MUST match in size).
 	CRASH_COND(r_path_types && path.size() != r_path_types->size());
 	CRASH_COND(r_path_rids && path.size() != r_path_rids->size());
@@ -489,51 +495,152 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	return path;
 }
 
-Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
-	ERR_FAIL_COND_V_MSG(map_update_id == 0, Vector3(), "NavigationServer map query failed because it was made before first map synchronization.");
-	bool use_collision = p_use_collision;
-	Vector3 closest_point;
-	real_t closest_point_d = FLT_MAX;
+NavMap::PathQuerySlot *NavMap::_acquire_path_query_slot() const {
+	PathQuerySlot *path_query_slot = nullptr;
+	{
+		MutexLock lock(path_query_slots_mutex);
+		if (free_path_query_slots.is_empty()) {
+			path_query_slot = memnew(PathQuerySlot);
+			path_query_slots.push_back(path_query_slot);
+		} else {
+			path_query_slot = free_path_query_slots[free_path_query_slots.size() - 1];
+			free_path_query_slots.resize(free_path_query_slots.size() - 1);
+		}
+	}
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
+	const uint32_t polygon_count = region_polygon_count + link_polygons.size();
+	if (path_query_slot->navigation_polys.get_capacity() > polygon_count * 2) {
+		// The map shrank a lot since this slot was used, give the memory back.
+		path_query_slot->navigation_polys.reset();
+	}
+	if (path_query_slot->navigation_polys.size() < polygon_count) {
+		path_query_slot->navigation_polys.resize(polygon_count);
+	}
+	if (path_query_slot->navigation_clusters.size() < path_clusters.size()) {
+		path_query_slot->navigation_clusters.resize(path_clusters.size());
+	}
+	path_query_slot->traversable_polys.clear();
+	path_query_slot->next_query();
+
+	return path_query_slot;
+}
+
+void NavMap::_release_path_query_slot(PathQuerySlot *p_path_query_slot) const {
+	MutexLock lock(path_query_slots_mutex);
+	// Each slot is sized for the whole map, only keep as many as the queries that usually run
+	// at the same time: one per worker thread plus the main thread.
+	const uint32_t max_free_path_query_slots = WorkerThreadPool::get_singleton()->get_thread_count() + 1;
+	if (free_path_query_slots.size() >= max_free_path_query_slots) {
+		path_query_slots.erase(p_path_query_slot);
+		memdelete(p_path_query_slot);
+		return;
+	}
+	free_path_query_slots.push_back(p_path_query_slot);
+}
+
+void NavMap::PathQuerySlot::next_query() {
+	query_id++;
+	if (query_id == 0) {
+		// Wrapped around, forget the old ids so they cannot match a new query.
+		for (gd::NavigationPoly &navigation_poly : navigation_polys) {
+			navigation_poly.query_id = 0;
+		}
+		for (gd::NavigationCluster &navigation_cluster : navigation_clusters) {
+			navigation_cluster.query_id = 0;
+			navigation_cluster.corridor_query_id = 0;
+		}
+		query_id = 1;
+	}
+}
+
+bool NavMap::_find_path_corridor(PathQuerySlot *p_path_query_slot, uint32_t p_begin_cluster, uint32_t p_end_cluster, const Vector3 &p_end_point, uint32_t p_navigation_layers) const {
+	LocalVector<gd::NavigationCluster> &navigation_clusters = p_path_query_slot->navigation_clusters;
+	gd::Heap<gd::NavigationCluster *, gd::NavClusterTravelCostLessThan, gd::NavClusterHeapIndexer> &traversable_clusters = p_path_query_slot->traversable_clusters;
+	const uint32_t query_id = p_path_query_slot->query_id;
+	traversable_clusters.clear();
+
+	gd::NavigationCluster &begin_navigation_cluster = navigation_clusters[p_begin_cluster];
+	begin_navigation_cluster = gd::NavigationCluster();
+	begin_navigation_cluster.id = p_begin_cluster;
+	begin_navigation_cluster.query_id = query_id;
+	traversable_clusters.push(&begin_navigation_cluster);
+
+	// A* over the clusters, travelling between their centers.
+	bool found_route = false;
+	while (!traversable_clusters.is_empty()) {
+		gd::NavigationCluster *least_cost_cluster = traversable_clusters.pop();
+		least_cost_cluster->traversable_cluster_index = UINT32_MAX;
+		if (least_cost_cluster->id == p_end_cluster) {
+			found_route = true;
+			break;
 		}
 
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
+		const gd::PathCluster &cluster = path_clusters[least_cost_cluster->id];
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+		for (uint32_t neighbor_cluster_id : cluster.connections) {
+			const gd::PathCluster &neighbor_cluster = path_clusters[neighbor_cluster_id];
+			if ((p_navigation_layers & neighbor_cluster.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
 
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
+			const real_t new_distance = least_cost_cluster->traveled_distance + cluster.center.distance_to(neighbor_cluster.center) * travel_cost;
 
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
+			gd::NavigationCluster &neighbor = navigation_clusters[neighbor_cluster_id];
+			if (neighbor.query_id == query_id) {
+				if (neighbor.traversable_cluster_index != UINT32_MAX && new_distance < neighbor.traveled_distance) {
+					neighbor.back_navigation_cluster_id = least_cost_cluster->id;
+					neighbor.traveled_distance = new_distance;
+					traversable_clusters.shift(neighbor.traversable_cluster_index);
 				}
+			} else {
+				neighbor = gd::NavigationCluster();
+				neighbor.id = neighbor_cluster_id;
+				neighbor.query_id = query_id;
+				neighbor.back_navigation_cluster_id = least_cost_cluster->id;
+				neighbor.traveled_distance = new_distance;
+				neighbor.distance_to_destination = neighbor_cluster.center.distance_to(p_end_point) * neighbor_cluster.owner->get_travel_cost();
+				traversable_clusters.push(&neighbor);
 			}
 		}
 	}
 
+	if (!found_route) {
+		// Let the polygon search handle the unreachable destination.
+		return false;
+	}
+
+	// Flag the clusters of the route.
+	uint32_t cluster_id = p_end_cluster;
+	while (cluster_id != UINT32_MAX) {
+		navigation_clusters[cluster_id].corridor_query_id = query_id;
+		cluster_id = navigation_clusters[cluster_id].back_navigation_cluster_id;
+	}
+
+	return true;
+}
+
+Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
+	ERR_FAIL_COND_V_MSG(map_update_id == 0, Vector3(), "NavigationServer map query failed because it was made before first map synchronization.");
+	Vector3 closest_point;
+	real_t closest_point_d = FLT_MAX;
+	bool collided = false;
+
+	// Check the faces intersecting the segment, keeping the one closest to the segment start.
+	for (const PolygonRegion *polygon_region : polygon_regions) {
+		if (polygon_region->region->get_polygons_bvh().intersect_segment(polygon_region->polygons.ptr(), p_from, p_to, closest_point_d, closest_point) != -1) {
+			collided = true;
+		}
+	}
+
+	if (collided || p_use_collision) {
+		return closest_point;
+	}
+
+	// Otherwise fall back to the polygon edge closest to the segment.
+	for (const PolygonRegion *polygon_region : polygon_regions) {
+		polygon_region->region->get_polygons_bvh().get_closest_point_to_segment(polygon_region->polygons.ptr(), p_from, p_to, closest_point_d, closest_point);
+	}
+
 	return closest_point;
 }
 
@@ -559,47 +666,147 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	gd::ClosestPointQueryResult result;
 	real_t closest_point_ds = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
+	const gd::Polygon *closest_polygon = _get_closest_polygon(p_point, false, 0, closest_point_ds, result.point, &result.normal);
+	if (closest_polygon) {
+		result.owner = closest_polygon->owner->get_self();
+	}
+
+	return result;
+}
+
+Vector3i NavMap::_get_path_cluster_cell(const Vector3 &p_point) const {
+	return Vector3i((p_point / path_cluster_size).floor());
+}
+
+void NavMap::_update_path_clusters() {
+	path_clusters.clear();
+	polygon_clusters.clear();
+
+	if (path_cluster_size <= 0.0) {
+		return;
+	}
+
+	const uint32_t polygon_count = region_polygon_count + link_polygons.size();
+	polygon_clusters.resize(polygon_count);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		polygon_clusters[i] = UINT32_MAX;
+	}
+
+	// The polygons grouped by cluster.
+	LocalVector<const gd::Polygon *> cluster_polygons;
+	cluster_polygons.reserve(polygon_count);
+	for (const PolygonRegion *polygon_region : polygon_regions) {
+		for (const gd::Polygon &polygon : polygon_region->polygons) {
+			_flood_fill_path_cluster(polygon, cluster_polygons);
+		}
+	}
+	for (const gd::Polygon &polygon : link_polygons) {
+		_flood_fill_path_cluster(polygon, cluster_polygons);
+	}
+
+	// Connect the clusters following the polygon connections between them.
+	for (const gd::Polygon *polygon : cluster_polygons) {
+		const uint32_t cluster_id = polygon_clusters[polygon->id];
+		LocalVector<uint32_t> &cluster_connections = path_clusters[cluster_id].connections;
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other_cluster_id = polygon_clusters[connection.polygon->id];
+				if (other_cluster_id != cluster_id && cluster_connections.find(other_cluster_id) == -1) {
+					cluster_connections.push_back(other_cluster_id);
+				}
 			}
 		}
 	}
+}
 
-	return result;
+void NavMap::_flood_fill_path_cluster(const gd::Polygon &p_polygon, LocalVector<const gd::Polygon *> &r_cluster_polygons) {
+	if (p_polygon.owner == nullptr || polygon_clusters[p_polygon.id] != UINT32_MAX) {
+		// Unused link polygon or already in a cluster.
+		return;
+	}
+
+	const uint32_t cluster_id = path_clusters.size();
+	path_clusters.push_back(gd::PathCluster());
+	gd::PathCluster &cluster = path_clusters[cluster_id];
+	cluster.owner = p_polygon.owner;
+
+	// Visit the connected polygons of the same owner inside the cell, the visited ones are the queue.
+	const Vector3i cell = _get_path_cluster_cell(p_polygon.center);
+	const uint32_t first_polygon = r_cluster_polygons.size();
+	uint32_t next_polygon = first_polygon;
+	polygon_clusters[p_polygon.id] = cluster_id;
+	r_cluster_polygons.push_back(&p_polygon);
+	while (next_polygon < r_cluster_polygons.size()) {
+		const gd::Polygon *cluster_polygon = r_cluster_polygons[next_polygon++];
+		cluster.center += cluster_polygon->center;
+
+		for (const gd::Edge &edge : cluster_polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const gd::Polygon *other_polygon = connection.polygon;
+				if (other_polygon->owner != cluster.owner || polygon_clusters[other_polygon->id] != UINT32_MAX || _get_path_cluster_cell(other_polygon->center) != cell) {
+					continue;
+				}
+				polygon_clusters[other_polygon->id] = cluster_id;
+				r_cluster_polygons.push_back(other_polygon);
+			}
+		}
+	}
+	cluster.center /= real_t(r_cluster_polygons.size() - first_polygon);
+}
+
+gd::Polygon *NavMap::_get_closest_polygon(const Vector3 &p_point, bool p_use_layers, uint32_t p_navigation_layers, real_t &r_distance_squared, Vector3 &r_point, Vector3 *r_normal, bool p_include_bound) const {
+	gd::Polygon *closest_polygon = nullptr;
+
+	for (PolygonRegion *polygon_region : polygon_regions) {
+		if (p_use_layers && (p_navigation_layers & polygon_region->region->get_navigation_layers()) == 0) {
+			continue;
+		}
+
+		// Once a polygon is found the bound is its distance, the polygons of the next regions have to be closer.
+		const int index = polygon_region->region->get_polygons_bvh().get_closest_point(polygon_region->polygons.ptr(), p_point, r_distance_squared, r_point, r_normal, p_include_bound && !closest_polygon);
+		if (index != -1) {
+			closest_polygon = &polygon_region->polygons[index];
+		}
+	}
+
+	return closest_polygon;
 }
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
+
+	PolygonRegion *polygon_region = memnew(PolygonRegion);
+	polygon_region->region = p_region;
+	polygon_regions.push_back(polygon_region);
+	polygon_regions_map.insert(p_region, polygon_region);
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+	}
+
+	HashMap<const NavBase *, PolygonRegion *>::Iterator E = polygon_regions_map.find(p_region);
+	if (E) {
+		// The polygons stay until the next synchronization disconnects them from the other regions.
+		PolygonRegion *polygon_region = E->value;
+		polygon_regions_map.remove(E);
+		polygon_regions.remove_at_unordered(polygon_regions.find(polygon_region));
+		removed_polygon_regions.push_back(polygon_region);
 	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
 	links.push_back(p_link);
-	regenerate_links = true;
+	regenerate_link_polygons = true;
 }
 
 void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index >= 0) {
 		links.remove_at_unordered(link_index);
-		regenerate_links = true;
+		regenerate_link_polygons = true;
 	}
 }
 
@@ -702,211 +909,70 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
-	for (NavRegion *region : regions) {
-		if (region->sync()) {
-			regenerate_links = true;
+	// Only the regions that changed, were added or removed need to be connected again.
+	bool regions_changed = regenerate_links || !removed_polygon_regions.is_empty();
+	for (PolygonRegion *polygon_region : polygon_regions) {
+		if (polygon_region->region->sync()) {
+			polygon_region->dirty = true;
+		}
+		if (polygon_region->dirty) {
+			regions_changed = true;
 		}
 	}
 
 	for (NavLink *link : links) {
 		if (link->check_dirty()) {
-			regenerate_links = true;
+			regenerate_link_polygons = true;
 		}
 	}
 
-	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
-		_new_pm_edge_merge_count = 0;
-		_new_pm_edge_connection_count = 0;
-		_new_pm_edge_free_count = 0;
-
-		// Remove regions connections.
-		for (NavRegion *region : regions) {
-			region->get_connections().clear();
-		}
-
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			count += region->get_polygons().size();
-		}
-		polygons.resize(count);
-
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
-			}
-			count += region->get_polygons().size();
-		}
-
-		_new_pm_polygon_count = polygons.size();
-
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'.");
+	if (regions_changed || regenerate_link_polygons) {
+		// Remove the connections to the link polygons, the links are connected again below.
+		for (gd::Polygon *polygon : link_connected_polygons) {
+			Vector<gd::Edge::Connection> &connections = polygon->edges[0].connections;
+			for (int64_t i = int64_t(connections.size()) - 1; i >= 0; i--) {
+				if (connections[i].edge == -1) {
+					connections.remove_at(i);
 				}
 			}
 		}
+		link_connected_polygons.clear();
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
-				}
-			}
+		if (regions_changed) {
+			_update_region_connections(regenerate_links);
 		}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
-
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
-
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
-
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
-
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
-
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
-				}
-
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
-				}
-
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
-
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
-			}
+		_new_pm_polygon_count = region_polygon_count;
+		_new_pm_edge_count = edge_connections.size();
+		_new_pm_edge_merge_count = edge_merge_count;
+		_new_pm_edge_connection_count = edge_connection_count;
+		_new_pm_edge_free_count = 0;
+		for (const PolygonRegion *polygon_region : polygon_regions) {
+			_new_pm_edge_free_count += polygon_region->free_edges.size();
 		}
 
 		uint32_t link_poly_idx = 0;
 		link_polygons.resize(links.size());
+		for (uint32_t i = 0; i < link_polygons.size(); i++) {
+			// Link polygons are indexed after the region polygons.
+			link_polygons[i] = gd::Polygon();
+			link_polygons[i].id = region_polygon_count + i;
+		}
 
 		// Search for polygons within range of a nav link.
 		for (const NavLink *link : links) {
 			const Vector3 start = link->get_start_position();
 			const Vector3 end = link->get_end_position();
 
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
+			real_t closest_start_distance = link_connection_radius * link_connection_radius;
 			Vector3 closest_start_point;
 
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
+			real_t closest_end_distance = link_connection_radius * link_connection_radius;
 			Vector3 closest_end_point;
 
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+			// Pick the polygons within the search radius of the start and end points that are the closest, the radius is inclusive.
+			gd::Polygon *closest_start_polygon = _get_closest_polygon(start, false, 0, closest_start_distance, closest_start_point, nullptr, true);
+			gd::Polygon *closest_end_polygon = _get_closest_polygon(end, false, 0, closest_end_distance, closest_end_point, nullptr, true);
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
 			if (closest_start_polygon && closest_end_polygon) {
@@ -939,6 +1005,7 @@ void NavMap::sync() {
 					entry_connection.pathway_start = new_polygon.points[0].pos;
 					entry_connection.pathway_end = new_polygon.points[1].pos;
 					closest_start_polygon->edges[0].connections.push_back(entry_connection);
+					link_connected_polygons.push_back(closest_start_polygon);
 
 					gd::Edge::Connection exit_connection;
 					exit_connection.polygon = closest_end_polygon;
@@ -956,6 +1023,7 @@ void NavMap::sync() {
 					entry_connection.pathway_start = new_polygon.points[2].pos;
 					entry_connection.pathway_end = new_polygon.points[3].pos;
 					closest_end_polygon->edges[0].connections.push_back(entry_connection);
+					link_connected_polygons.push_back(closest_end_polygon);
 
 					gd::Edge::Connection exit_connection;
 					exit_connection.polygon = closest_start_polygon;
@@ -967,6 +1035,8 @@ void NavMap::sync() {
 			}
 		}
 
+		_update_path_clusters();
+
 		// Update the update ID.
 		map_update_id = (map_update_id + 1) % 9999999;
 	}
@@ -991,6 +1061,7 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	regenerate_link_polygons = false;
 	obstacles_dirty = false;
 	agents_dirty = false;
 
@@ -1005,6 +1076,360 @@ void NavMap::sync() {
 	pm_edge_free_count = _new_pm_edge_free_count;
 }
 
+NavMap::PolygonRegion *NavMap::_get_polygon_region(const gd::Polygon *p_polygon) const {
+	PolygonRegion *const *polygon_region = polygon_regions_map.getptr(p_polygon->owner);
+	if (!polygon_region) {
+		return nullptr;
+	}
+	// The owner could be a new region reusing the address of a removed one.
+	const gd::Polygon *region_polygons = (*polygon_region)->polygons.ptr();
+	if (p_polygon < region_polygons || p_polygon >= region_polygons + (*polygon_region)->polygons.size()) {
+		return nullptr;
+	}
+	return *polygon_region;
+}
+
+bool NavMap::_is_free_edge_allowed(const PolygonRegion *p_polygon_region) const {
+	return use_edge_connections && p_polygon_region->region->get_use_edge_connections();
+}
+
+bool NavMap::_get_edge_connection_pathway(const gd::Edge::Connection &p_edge, const gd::Edge::Connection &p_other_edge, Vector3 &r_pathway_start, Vector3 &r_pathway_end) const {
+	const Vector3 edge_p1 = p_edge.polygon->points[p_edge.edge].pos;
+	const Vector3 edge_p2 = p_edge.polygon->points[(p_edge.edge + 1) % p_edge.polygon->points.size()].pos;
+	const Vector3 other_edge_p1 = p_other_edge.polygon->points[p_other_edge.edge].pos;
+	const Vector3 other_edge_p2 = p_other_edge.polygon->points[(p_other_edge.edge + 1) % p_other_edge.polygon->points.size()].pos;
+
+	// Compute the projection of the opposite edge on the current one
+	const Vector3 edge_vector = edge_p2 - edge_p1;
+	const real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+	const real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return false;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	const Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = other_edge_p1;
+	} else {
+		other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_to(self1) > edge_connection_margin) {
+		return false;
+	}
+
+	const Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = other_edge_p2;
+	} else {
+		other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_to(self2) > edge_connection_margin) {
+		return false;
+	}
+
+	r_pathway_start = (self1 + other1) / 2.0;
+	r_pathway_end = (self2 + other2) / 2.0;
+	return true;
+}
+
+int NavMap::_remove_edge_connections_to(gd::Polygon *p_polygon, int p_edge, const gd::Polygon *p_to_polygon) {
+	Vector<gd::Edge::Connection> &connections = p_polygon->edges[p_edge].connections;
+	int removed_count = 0;
+	for (int64_t i = int64_t(connections.size()) - 1; i >= 0; i--) {
+		if (connections[i].polygon == p_to_polygon) {
+			connections.remove_at(i);
+			removed_count++;
+		}
+	}
+	return removed_count;
+}
+
+void NavMap::_remove_free_edge_connections_to(const PolygonRegion *p_polygon_region, const gd::Polygon *p_from_polygon, const gd::Polygon *p_to_polygon, int p_edge) {
+	// The connections between near edges are not always symmetric, so the
+	// ones ending on the given polygons are found from the other free edges.
+	for (PolygonRegion *other_polygon_region : polygon_regions) {
+		if (other_polygon_region == p_polygon_region) {
+			continue;
+		}
+		for (const gd::Edge::Connection &other_free_edge : other_polygon_region->free_edges) {
+			Vector<gd::Edge::Connection> &connections = other_free_edge.polygon->edges[other_free_edge.edge].connections;
+			for (int64_t i = int64_t(connections.size()) - 1; i >= 0; i--) {
+				const gd::Edge::Connection &connection = connections[i];
+				if (connection.polygon >= p_from_polygon && connection.polygon < p_to_polygon && (p_edge < 0 || connection.edge == p_edge)) {
+					connections.remove_at(i);
+					edge_connection_count--;
+					other_polygon_region->connections_dirty = true;
+				}
+			}
+		}
+	}
+}
+
+void NavMap::_unlink_polygon_region(PolygonRegion *p_polygon_region, LocalVector<gd::Edge::Connection> &r_freed_edges) {
+	if (!p_polygon_region->free_edges.is_empty()) {
+		const gd::Polygon *polygons = p_polygon_region->polygons.ptr();
+		_remove_free_edge_connections_to(p_polygon_region, polygons, polygons + p_polygon_region->polygons.size(), -1);
+	}
+
+	for (gd::Polygon &polygon : p_polygon_region->polygons) {
+		for (uint32_t p = 0; p < polygon.points.size(); p++) {
+			const gd::EdgeKey ek(polygon.points[p].key, polygon.points[(p + 1) % polygon.points.size()].key);
+			HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey>::Iterator E = edge_connections.find(ek);
+			const bool merged = E && E->value.size() == 2;
+
+			for (const gd::Edge::Connection &connection : polygon.edges[p].connections) {
+				if (merged) {
+					// Remove the connection going back to this edge.
+					_remove_edge_connections_to(connection.polygon, connection.edge, &polygon);
+				} else {
+					edge_connection_count--;
+					PolygonRegion *other_polygon_region = _get_polygon_region(connection.polygon);
+					if (other_polygon_region) {
+						other_polygon_region->connections_dirty = true;
+					}
+				}
+			}
+
+			if (!E) {
+				continue;
+			}
+			LocalVector<gd::Edge::Connection> &key_connections = E->value;
+			for (uint32_t i = 0; i < key_connections.size(); i++) {
+				if (key_connections[i].polygon == &polygon && key_connections[i].edge == int(p)) {
+					key_connections.remove_at(i);
+					break;
+				}
+			}
+			if (key_connections.is_empty()) {
+				edge_connections.remove(E);
+			} else if (merged) {
+				// The other edge lost its polygon on this side, it may now connect to the near edges.
+				edge_merge_count--;
+				if (_get_polygon_region(key_connections[0].polygon)) {
+					r_freed_edges.push_back(key_connections[0]);
+				}
+			}
+		}
+	}
+}
+
+void NavMap::_unlink_free_edge(PolygonRegion *p_polygon_region, gd::Polygon *p_polygon, int p_edge) {
+	_remove_free_edge_connections_to(p_polygon_region, p_polygon, p_polygon + 1, p_edge);
+
+	Vector<gd::Edge::Connection> &connections = p_polygon->edges[p_edge].connections;
+	for (const gd::Edge::Connection &connection : connections) {
+		edge_connection_count--;
+		PolygonRegion *other_polygon_region = _get_polygon_region(connection.polygon);
+		if (other_polygon_region) {
+			other_polygon_region->connections_dirty = true;
+		}
+	}
+	connections.clear();
+
+	for (uint32_t i = 0; i < p_polygon_region->free_edges.size(); i++) {
+		if (p_polygon_region->free_edges[i].polygon == p_polygon && p_polygon_region->free_edges[i].edge == p_edge) {
+			p_polygon_region->free_edges.remove_at_unordered(i);
+			break;
+		}
+	}
+	p_polygon_region->connections_dirty = true;
+}
+
+void NavMap::_update_region_connections(bool p_relink_all) {
+	// Edges of the unchanged regions that lost the polygon on their other side.
+	LocalVector<gd::Edge::Connection> freed_edges;
+
+	if (p_relink_all) {
+		edge_connections.clear();
+		edge_merge_count = 0;
+		edge_connection_count = 0;
+		for (PolygonRegion *polygon_region : polygon_regions) {
+			polygon_region->dirty = true;
+		}
+	} else {
+		// Disconnect the removed and changed regions from the others.
+		for (PolygonRegion *polygon_region : removed_polygon_regions) {
+			_unlink_polygon_region(polygon_region, freed_edges);
+		}
+		for (PolygonRegion *polygon_region : polygon_regions) {
+			if (polygon_region->dirty) {
+				_unlink_polygon_region(polygon_region, freed_edges);
+			}
+		}
+	}
+
+	for (PolygonRegion *polygon_region : removed_polygon_regions) {
+		memdelete(polygon_region);
+	}
+	removed_polygon_regions.clear();
+
+	// Copy the polygons of the changed regions and give all the polygons their id.
+	uint32_t polygon_offset = 0;
+	for (PolygonRegion *polygon_region : polygon_regions) {
+		if (polygon_region->dirty) {
+			polygon_region->polygons = polygon_region->region->get_polygons();
+			polygon_region->free_edges.clear();
+		}
+		if (polygon_region->dirty || polygon_region->polygon_offset != polygon_offset) {
+			polygon_region->polygon_offset = polygon_offset;
+			for (uint32_t n = 0; n < polygon_region->polygons.size(); n++) {
+				polygon_region->polygons[n].id = polygon_offset + n;
+			}
+		}
+		polygon_offset += polygon_region->polygons.size();
+	}
+	region_polygon_count = polygon_offset;
+
+	// Connect the edges of the changed regions shared with another polygon.
+	for (PolygonRegion *polygon_region : polygon_regions) {
+		if (!polygon_region->dirty) {
+			continue;
+		}
+
+		for (gd::Polygon &poly : polygon_region->polygons) {
+			for (uint32_t p = 0; p < poly.points.size(); p++) {
+				int next_point = (p + 1) % poly.points.size();
+				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+				HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = edge_connections.find(ek);
+				if (!connection) {
+					connection = edge_connections.insert(ek, LocalVector<gd::Edge::Connection>());
+				}
+				if (connection->value.size() <= 1) {
+					// Add the polygon/edge tuple to this key.
+					gd::Edge::Connection new_connection;
+					new_connection.polygon = &poly;
+					new_connection.edge = p;
+					new_connection.pathway_start = poly.points[p].pos;
+					new_connection.pathway_end = poly.points[next_point].pos;
+
+					if (connection->value.size() == 1) {
+						// Connect edge that are shared in different polygons.
+						gd::Edge::Connection &other_connection = connection->value[0];
+						PolygonRegion *other_polygon_region = _get_polygon_region(other_connection.polygon);
+						if (other_polygon_region && !other_polygon_region->dirty) {
+							// The edge of the unchanged region is not free anymore.
+							_unlink_free_edge(other_polygon_region, other_connection.polygon, other_connection.edge);
+						}
+						other_connection.polygon->edges[other_connection.edge].connections.push_back(new_connection);
+						poly.edges[p].connections.push_back(other_connection);
+						// Note: The pathway_start/end are full for those connection and do not need to be modified.
+						edge_merge_count++;
+					}
+					connection->value.push_back(new_connection);
+				} else {
+					// The edge is already connected with another edge, skip.
+					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'.");
+				}
+			}
+		}
+	}
+
+	// Collect the edges that can newly connect to the near edges of other regions.
+	for (PolygonRegion *polygon_region : polygon_regions) {
+		polygon_region->old_free_edge_count = polygon_region->dirty ? 0 : polygon_region->free_edges.size();
+		if (!polygon_region->dirty || !_is_free_edge_allowed(polygon_region)) {
+			continue;
+		}
+
+		for (gd::Polygon &poly : polygon_region->polygons) {
+			for (uint32_t p = 0; p < poly.points.size(); p++) {
+				const gd::EdgeKey ek(poly.points[p].key, poly.points[(p + 1) % poly.points.size()].key);
+				const LocalVector<gd::Edge::Connection> *connection = edge_connections.getptr(ek);
+				if (connection && connection->size() == 1 && (*connection)[0].polygon == &poly) {
+					polygon_region->free_edges.push_back((*connection)[0]);
+				}
+			}
+		}
+	}
+	for (const gd::Edge::Connection &freed_edge : freed_edges) {
+		PolygonRegion *polygon_region = _get_polygon_region(freed_edge.polygon);
+		if (!polygon_region || polygon_region->dirty || !_is_free_edge_allowed(polygon_region)) {
+			continue;
+		}
+
+		// The edge could have been connected again to a changed region.
+		const gd::EdgeKey ek(freed_edge.polygon->points[freed_edge.edge].key, freed_edge.polygon->points[(freed_edge.edge + 1) % freed_edge.polygon->points.size()].key);
+		const LocalVector<gd::Edge::Connection> *connection = edge_connections.getptr(ek);
+		if (connection && connection->size() == 1) {
+			polygon_region->free_edges.push_back(freed_edge);
+			polygon_region->connections_dirty = true;
+		}
+	}
+
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	//
+	// Only the new free edges are matched, against all the free edges of the
+	// other regions near enough. Each direction is checked on its own by
+	// projecting the opposite edge on the current one, so an edge can be
+	// connected to another one without the reverse connection.
+	for (PolygonRegion *polygon_region : polygon_regions) {
+		if (polygon_region->old_free_edge_count == polygon_region->free_edges.size()) {
+			continue;
+		}
+		const AABB region_aabb = polygon_region->region->get_polygons_bvh().get_aabb().grow(edge_connection_margin);
+
+		for (PolygonRegion *other_polygon_region : polygon_regions) {
+			if (other_polygon_region->region == polygon_region->region || other_polygon_region->free_edges.is_empty()) {
+				continue;
+			}
+			if (!region_aabb.intersects(other_polygon_region->region->get_polygons_bvh().get_aabb())) {
+				continue;
+			}
+
+			for (uint32_t i = polygon_region->old_free_edge_count; i < polygon_region->free_edges.size(); i++) {
+				const gd::Edge::Connection &free_edge = polygon_region->free_edges[i];
+
+				for (uint32_t j = 0; j < other_polygon_region->free_edges.size(); j++) {
+					// New edges of both regions are matched once, from the region with the lowest offset.
+					if (j >= other_polygon_region->old_free_edge_count && other_polygon_region->polygon_offset < polygon_region->polygon_offset) {
+						continue;
+					}
+					const gd::Edge::Connection &other_edge = other_polygon_region->free_edges[j];
+
+					// The edges can now be connected.
+					gd::Edge::Connection new_connection = other_edge;
+					if (_get_edge_connection_pathway(free_edge, other_edge, new_connection.pathway_start, new_connection.pathway_end)) {
+						free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+						edge_connection_count++;
+					}
+
+					gd::Edge::Connection other_new_connection = free_edge;
+					if (_get_edge_connection_pathway(other_edge, free_edge, other_new_connection.pathway_start, other_new_connection.pathway_end)) {
+						other_edge.polygon->edges[other_edge.edge].connections.push_back(other_new_connection);
+						edge_connection_count++;
+						other_polygon_region->connections_dirty = true;
+					}
+				}
+			}
+		}
+	}
+
+	// Update the region_connection map of the regions whose free edges changed.
+	for (PolygonRegion *polygon_region : polygon_regions) {
+		if (polygon_region->dirty || polygon_region->connections_dirty) {
+			Vector<gd::Edge::Connection> &region_connections = polygon_region->region->get_connections();
+			region_connections.clear();
+			for (const gd::Edge::Connection &free_edge : polygon_region->free_edges) {
+				for (const gd::Edge::Connection &connection : free_edge.polygon->edges[free_edge.edge].connections) {
+					region_connections.push_back(connection);
+				}
+			}
+		}
+		polygon_region->dirty = false;
+		polygon_region->connections_dirty = false;
+	}
+}
+
 void NavMap::_update_rvo_obstacles_tree_2d() {
 	int obstacle_vertex_count = 0;
 	for (NavObstacle *obstacle : obstacles) {
@@ -1196,4 +1621,13 @@ NavMap::NavMap() {
 }
 
 NavMap::~NavMap() {
+	for (PathQuerySlot *path_query_slot : path_query_slots) {
+		memdelete(path_query_slot);
+	}
+	for (PolygonRegion *polygon_region : polygon_regions) {
+		memdelete(polygon_region);
+	}
+	for (PolygonRegion *polygon_region : removed_polygon_regions) {
+		memdelete(polygon_region);
+	}
 }
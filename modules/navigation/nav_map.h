@@ -35,7 +35,10 @@
 #include "nav_utils.h"
 
 #include "core/math/math_defs.h"
+#include "core/math/vector3i.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
 
 #include <KdTree2d.h>
 #include <KdTree3d.h>
@@ -63,8 +66,13 @@ class NavMap : public NavRid {
 	/// This value is used to limit how far links search to find polygons to connect to.
 	real_t link_connection_radius = 1.0;
 
+	/// Size of the cells grouping the map polygons in clusters for the hierarchical path queries.
+	/// Zero disables the clusters, the path queries then search all the polygons.
+	real_t path_cluster_size = 0.0;
+
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
+	bool regenerate_link_polygons = true;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
@@ -73,8 +81,54 @@ class NavMap : public NavRid {
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
 
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	/// Map polygons, copied from each region so they can be connected to the other regions.
+	/// Only the copies of the changed regions are replaced and connected again during the synchronization.
+	struct PolygonRegion {
+		NavRegion *region = nullptr;
+		/// Id of the first polygon of the region.
+		uint32_t polygon_offset = 0;
+		LocalVector<gd::Polygon> polygons;
+		/// Edges without a polygon on the other side, that can be connected to the near edges of other regions.
+		LocalVector<gd::Edge::Connection> free_edges;
+		/// The region polygons changed, they need to be copied and connected again.
+		bool dirty = true;
+		/// The connections between the free edges of this region and the other regions changed.
+		bool connections_dirty = false;
+		/// Free edges already matched with the near edges of other regions, the next ones are new.
+		uint32_t old_free_edge_count = 0;
+	};
+	LocalVector<PolygonRegion *> polygon_regions;
+	HashMap<const NavBase *, PolygonRegion *> polygon_regions_map;
+	LocalVector<PolygonRegion *> removed_polygon_regions;
+	uint32_t region_polygon_count = 0;
+
+	/// Edges of the map polygons grouped by their points, the polygons sharing an edge are connected through it.
+	HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey> edge_connections;
+	int edge_merge_count = 0;
+	int edge_connection_count = 0;
+
+	/// Map polygons connected to the entry of a link.
+	LocalVector<gd::Polygon *> link_connected_polygons;
+
+	/// Map polygon clusters, indexed by the polygon id.
+	LocalVector<gd::PathCluster> path_clusters;
+	LocalVector<uint32_t> polygon_clusters;
+
+	/// Buffers reused by the path queries, so searching allocates nothing once they are
+	/// large enough. Each query running at the same time takes its own slot, and only
+	/// one idle slot per thread is kept since each one is sized for the whole map.
+	struct PathQuerySlot {
+		uint32_t query_id = 0;
+		LocalVector<gd::NavigationPoly> navigation_polys;
+		gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostLessThan, gd::NavPolyHeapIndexer> traversable_polys;
+		LocalVector<gd::NavigationCluster> navigation_clusters;
+		gd::Heap<gd::NavigationCluster *, gd::NavClusterTravelCostLessThan, gd::NavClusterHeapIndexer> traversable_clusters;
+
+		void next_query();
+	};
+	mutable Mutex path_query_slots_mutex;
+	mutable LocalVector<PathQuerySlot *> path_query_slots;
+	mutable LocalVector<PathQuerySlot *> free_path_query_slots;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
@@ -148,6 +202,11 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_path_cluster_size(real_t p_path_cluster_size);
+	real_t get_path_cluster_size() const {
+		return path_cluster_size;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
@@ -210,6 +269,25 @@ private:
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
 
+	PathQuerySlot *_acquire_path_query_slot() const;
+	void _release_path_query_slot(PathQuerySlot *p_path_query_slot) const;
+
+	Vector3i _get_path_cluster_cell(const Vector3 &p_point) const;
+	void _update_path_clusters();
+	bool _find_path_corridor(PathQuerySlot *p_path_query_slot, uint32_t p_begin_cluster, uint32_t p_end_cluster, const Vector3 &p_end_point, uint32_t p_navigation_layers) const;
+
+	gd::Polygon *_get_closest_polygon(const Vector3 &p_point, bool p_use_layers, uint32_t p_navigation_layers, real_t &r_distance_squared, Vector3 &r_point, Vector3 *r_normal = nullptr, bool p_include_bound = false) const;
+
+	PolygonRegion *_get_polygon_region(const gd::Polygon *p_polygon) const;
+	bool _is_free_edge_allowed(const PolygonRegion *p_polygon_region) const;
+	bool _get_edge_connection_pathway(const gd::Edge::Connection &p_edge, const gd::Edge::Connection &p_other_edge, Vector3 &r_pathway_start, Vector3 &r_pathway_end) const;
+	int _remove_edge_connections_to(gd::Polygon *p_polygon, int p_edge, const gd::Polygon *p_to_polygon);
+	void _remove_free_edge_connections_to(const PolygonRegion *p_polygon_region, const gd::Polygon *p_from_polygon, const gd::Polygon *p_to_polygon, int p_edge);
+	void _unlink_polygon_region(PolygonRegion *p_polygon_region, LocalVector<gd::Edge::Connection> &r_freed_edges);
+	void _unlink_free_edge(PolygonRegion *p_polygon_region, gd::Polygon *p_polygon, int p_edge);
+	void _update_region_connections(bool p_relink_all);
+	void _flood_fill_path_cluster(const gd::Polygon &p_polygon, LocalVector<const gd::Polygon *> &r_cluster_polygons);
+
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
@@ -0,0 +1,305 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#include "nav_polygon_bvh.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+using namespace gd;
+
+int PolygonBVH::_create_bvh(Node *p_nodes, Node **p_bb, int p_from, int p_size, int p_depth, int &r_max_depth, int &r_max_alloc) {
+	if (p_depth > r_max_depth) {
+		r_max_depth = p_depth;
+	}
+
+	if (p_size == 1) {
+		return p_bb[p_from] - p_nodes;
+	} else if (p_size == 0) {
+		return -1;
+	}
+
+	AABB aabb;
+	aabb = p_bb[p_from]->aabb;
+	for (int i = 1; i < p_size; i++) {
+		aabb.merge_with(p_bb[p_from + i]->aabb);
+	}
+
+	int li = aabb.get_longest_axis_index();
+
+	switch (li) {
+		case Vector3::AXIS_X: {
+			SortArray<Node *, NodeCmpX> sort_x;
+			sort_x.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
+		} break;
+		case Vector3::AXIS_Y: {
+			SortArray<Node *, NodeCmpY> sort_y;
+			sort_y.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
+		} break;
+		case Vector3::AXIS_Z: {
+			SortArray<Node *, NodeCmpZ> sort_z;
+			sort_z.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
+		} break;
+	}
+
+	int left = _create_bvh(p_nodes, p_bb, p_from, p_size / 2, p_depth + 1, r_max_depth, r_max_alloc);
+	int right = _create_bvh(p_nodes, p_bb, p_from + p_size / 2, p_size - p_size / 2, p_depth + 1, r_max_depth, r_max_alloc);
+
+	int index = r_max_alloc++;
+	Node *_new = &p_nodes[index];
+	_new->aabb = aabb;
+	_new->center = aabb.get_center();
+	_new->polygon_index = -1;
+	_new->left = left;
+	_new->right = right;
+
+	return index;
+}
+
+void PolygonBVH::build(const LocalVector<Polygon> &p_polygons) {
+	clear();
+
+	// A binary tree never needs more than twice the amount of leaves.
+	nodes.resize(p_polygons.size() * 2);
+
+	int leaf_count = 0;
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const Polygon &polygon = p_polygons[i];
+		if (polygon.points.size() == 0) {
+			continue;
+		}
+
+		Node &leaf = nodes[leaf_count++];
+		leaf.aabb = AABB(polygon.points[0].pos, Vector3());
+		for (uint32_t j = 1; j < polygon.points.size(); j++) {
+			leaf.aabb.expand_to(polygon.points[j].pos);
+		}
+		// Flat polygons have flat bounds, grow them so segment tests stay robust.
+		leaf.aabb.grow_by(CMP_EPSILON);
+		leaf.center = leaf.aabb.get_center();
+		leaf.left = -1;
+		leaf.right = -1;
+		leaf.polygon_index = i;
+	}
+
+	if (leaf_count == 0) {
+		nodes.clear();
+		return;
+	}
+
+	LocalVector<Node *> leaf_ptrs;
+	leaf_ptrs.resize(leaf_count);
+	for (int i = 0; i < leaf_count; i++) {
+		leaf_ptrs[i] = &nodes[i];
+	}
+
+	int max_alloc = leaf_count;
+	root = _create_bvh(nodes.ptr(), leaf_ptrs.ptr(), 0, leaf_count, 1, max_depth, max_alloc);
+	nodes.resize(max_alloc);
+}
+
+void PolygonBVH::clear() {
+	nodes.clear();
+	root = -1;
+	max_depth = 0;
+}
+
+AABB PolygonBVH::get_aabb() const {
+	if (root == -1) {
+		return AABB();
+	}
+	return nodes[root].aabb;
+}
+
+real_t PolygonBVH::get_aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 begin = p_aabb.position;
+	const Vector3 end = p_aabb.position + p_aabb.size;
+	const Vector3 delta(
+			MAX(MAX(begin.x - p_point.x, p_point.x - end.x), (real_t)0.0),
+			MAX(MAX(begin.y - p_point.y, p_point.y - end.y), (real_t)0.0),
+			MAX(MAX(begin.z - p_point.z, p_point.z - end.z), (real_t)0.0));
+	return delta.length_squared();
+}
+
+int PolygonBVH::get_closest_point(const Polygon *p_polygons, const Vector3 &p_point, real_t &r_distance_squared, Vector3 &r_point, Vector3 *r_normal, bool p_include_bound) const {
+	if (root == -1) {
+		return -1;
+	}
+
+	// Depth first, there is at most one pending sibling per level.
+	int *stack = (int *)alloca(sizeof(int) * (max_depth + 1));
+	int level = 0;
+	stack[0] = root;
+
+	const Node *nodes_ptr = nodes.ptr();
+	int closest_index = -1;
+
+	while (level >= 0) {
+		const Node &node = nodes_ptr[stack[level--]];
+		if (get_aabb_distance_squared(node.aabb, p_point) > r_distance_squared) {
+			continue;
+		}
+
+		if (node.polygon_index < 0) {
+			// Visit the nearest child first so the search bound shrinks quickly.
+			const real_t left_distance = get_aabb_distance_squared(nodes_ptr[node.left].aabb, p_point);
+			const real_t right_distance = get_aabb_distance_squared(nodes_ptr[node.right].aabb, p_point);
+			if (left_distance <= right_distance) {
+				stack[++level] = node.right;
+				stack[++level] = node.left;
+			} else {
+				stack[++level] = node.left;
+				stack[++level] = node.right;
+			}
+			continue;
+		}
+
+		const Polygon &polygon = p_polygons[node.polygon_index];
+		const bool lower_index = closest_index != -1 && node.polygon_index < closest_index;
+
+		// For each face check the distance to the point.
+		for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+			const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+			const Vector3 point = face.get_closest_point_to(p_point);
+			const real_t distance_squared = point.distance_squared_to(p_point);
+			const bool at_bound = p_include_bound && closest_index == -1 && distance_squared == r_distance_squared;
+			if (distance_squared < r_distance_squared || at_bound || (lower_index && distance_squared == r_distance_squared && closest_index != node.polygon_index)) {
+				r_distance_squared = distance_squared;
+				r_point = point;
+				if (r_normal) {
+					*r_normal = face.get_plane().normal;
+				}
+				closest_index = node.polygon_index;
+			}
+		}
+	}
+
+	return closest_index;
+}
+
+int PolygonBVH::intersect_segment(const Polygon *p_polygons, const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const {
+	if (root == -1) {
+		return -1;
+	}
+
+	int *stack = (int *)alloca(sizeof(int) * (max_depth + 1));
+	int level = 0;
+	stack[0] = root;
+
+	const Node *nodes_ptr = nodes.ptr();
+	int closest_index = -1;
+
+	while (level >= 0) {
+		const Node &node = nodes_ptr[stack[level--]];
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.polygon_index < 0) {
+			stack[++level] = node.right;
+			stack[++level] = node.left;
+			continue;
+		}
+
+		const Polygon &polygon = p_polygons[node.polygon_index];
+		const bool lower_index = closest_index != -1 && node.polygon_index < closest_index;
+
+		for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+			const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+			Vector3 intersection;
+			if (face.intersects_segment(p_from, p_to, &intersection)) {
+				const real_t distance = p_from.distance_to(intersection);
+				if (distance < r_distance || (lower_index && distance == r_distance && closest_index != node.polygon_index)) {
+					r_distance = distance;
+					r_point = intersection;
+					closest_index = node.polygon_index;
+				}
+			}
+		}
+	}
+
+	return closest_index;
+}
+
+int PolygonBVH::get_closest_point_to_segment(const Polygon *p_polygons, const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const {
+	if (root == -1) {
+		return -1;
+	}
+
+	int *stack = (int *)alloca(sizeof(int) * (max_depth + 1));
+	int level = 0;
+	stack[0] = root;
+
+	const Node *nodes_ptr = nodes.ptr();
+	const Vector3 segment[2] = { p_from, p_to };
+	int closest_index = -1;
+
+	while (level >= 0) {
+		const Node &node = nodes_ptr[stack[level--]];
+
+		// Conservative bound, the bounding sphere of the node is never further than the box itself.
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			const Vector3 center = node.aabb.get_center();
+			const real_t bound = center.distance_to(Geometry3D::get_closest_point_to_segment(center, segment)) - node.aabb.size.length() * 0.5;
+			if (bound > r_distance) {
+				continue;
+			}
+		}
+
+		if (node.polygon_index < 0) {
+			stack[++level] = node.right;
+			stack[++level] = node.left;
+			continue;
+		}
+
+		const Polygon &polygon = p_polygons[node.polygon_index];
+		const bool lower_index = closest_index != -1 && node.polygon_index < closest_index;
+
+		for (uint32_t point_id = 0; point_id < polygon.points.size(); point_id++) {
+			Vector3 a, b;
+			Geometry3D::get_closest_points_between_segments(
+					p_from,
+					p_to,
+					polygon.points[point_id].pos,
+					polygon.points[(point_id + 1) % polygon.points.size()].pos,
+					a,
+					b);
+
+			const real_t distance = a.distance_to(b);
+			if (distance < r_distance || (lower_index && distance == r_distance && closest_index != node.polygon_index)) {
+				r_distance = distance;
+				r_point = b;
+				closest_index = node.polygon_index;
+			}
+		}
+	}
+
+	return closest_index;
+}
@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+
+namespace gd {
+
+/// Static bounding volume hierarchy over the polygons of a navigation region.
+/// Polygons are referenced by their index, so the queries can run against any
+/// array holding a copy of the polygons it was built with.
+class PolygonBVH {
+	struct Node {
+		AABB aabb;
+		Vector3 center; // Used for sorting.
+		int left = -1;
+		int right = -1;
+
+		int polygon_index = -1;
+	};
+
+	struct NodeCmpX {
+		bool operator()(const Node *p_left, const Node *p_right) const {
+			return p_left->center.x < p_right->center.x;
+		}
+	};
+
+	struct NodeCmpY {
+		bool operator()(const Node *p_left, const Node *p_right) const {
+			return p_left->center.y < p_right->center.y;
+		}
+	};
+
+	struct NodeCmpZ {
+		bool operator()(const Node *p_left, const Node *p_right) const {
+			return p_left->center.z < p_right->center.z;
+		}
+	};
+
+	LocalVector<Node> nodes;
+	int root = -1;
+	int max_depth = 0;
+
+	int _create_bvh(Node *p_nodes, Node **p_bb, int p_from, int p_size, int p_depth, int &r_max_depth, int &r_max_alloc);
+
+public:
+	void build(const LocalVector<Polygon> &p_polygons);
+	void clear();
+
+	bool is_empty() const { return root == -1; }
+	AABB get_aabb() const;
+
+	/// Finds the closest point to `p_point` on the polygons faces.
+	/// Only points closer than `r_distance_squared` are considered, or at that distance when `p_include_bound` is set.
+	/// On success it is updated and the index of the polygon is returned, otherwise -1. On equal distances the lowest index wins.
+	int get_closest_point(const Polygon *p_polygons, const Vector3 &p_point, real_t &r_distance_squared, Vector3 &r_point, Vector3 *r_normal = nullptr, bool p_include_bound = false) const;
+
+	/// Finds the intersection between the segment and the polygons faces that is the closest to `p_from`.
+	/// Only intersections closer than `r_distance` are considered, on success it is updated and the
+	/// index of the polygon is returned, otherwise -1.
+	int intersect_segment(const Polygon *p_polygons, const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const;
+
+	/// Finds the point on the polygons edges that is the closest to the segment.
+	/// Only points closer than `r_distance` are considered, on success it is updated and the
+	/// index of the polygon is returned, otherwise -1.
+	int get_closest_point_to_segment(const Polygon *p_polygons, const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const;
+
+	static real_t get_aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point);
+};
+
+} // namespace gd
+
+#endif // NAV_POLYGON_BVH_H
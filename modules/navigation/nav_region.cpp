@@ -103,6 +103,7 @@ void NavRegion::update_polygons() {
 		return;
 	}
 	polygons.clear();
+	polygons_bvh.clear();
 	polygons_dirty = false;
 
 	if (map == nullptr) {
@@ -181,4 +182,6 @@ void NavRegion::update_polygons() {
 			p.center = center / real_t(mesh_poly.size());
 		}
 	}
+
+	polygons_bvh.build(polygons);
 }
@@ -32,6 +32,7 @@
 #define NAV_REGION_H
 
 #include "nav_base.h"
+#include "nav_polygon_bvh.h"
 #include "nav_utils.h"
 
 #include "scene/resources/navigation_mesh.h"
@@ -48,6 +49,7 @@ class NavRegion : public NavBase {
 
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
+	gd::PolygonBVH polygons_bvh;
 
 public:
 	NavRegion() {
@@ -89,6 +91,10 @@ public:
 		return polygons;
 	}
 
+	const gd::PolygonBVH &get_polygons_bvh() const {
+		return polygons_bvh;
+	}
+
 	bool sync();
 
 private:
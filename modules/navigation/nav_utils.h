@@ -98,6 +98,9 @@ struct Edge {
 };
 
 struct Polygon {
+	/// Index of this polygon in the map, set during the map synchronization.
+	uint32_t id = UINT32_MAX;
+
 	/// Navigation region or link that contains this polygon.
 	const NavBase *owner = nullptr;
 
@@ -115,10 +118,15 @@ struct Polygon {
 };
 
 struct NavigationPoly {
-	uint32_t self_id = 0;
 	/// This poly.
 	const Polygon *poly;
 
+	/// Id of the path query that last initialized this poly, used to reuse the buffers between queries.
+	uint32_t query_id = 0;
+
+	/// Index of this poly in the heap of polygons to visit, UINT32_MAX once it is no longer in it.
+	uint32_t traversable_poly_index = UINT32_MAX;
+
 	/// Those 4 variables are used to travel the path backwards.
 	int back_navigation_poly_id = -1;
 	int back_navigation_edge = -1;
@@ -127,8 +135,10 @@ struct NavigationPoly {
 
 	/// The entry position of this poly.
 	Vector3 entry;
-	/// The distance to the destination.
+	/// The distance traveled until now (g cost).
 	real_t traveled_distance = 0.0;
+	/// The estimated distance to the destination (h cost).
+	real_t distance_to_destination = 0.0;
 
 	NavigationPoly() { poly = nullptr; }
 
@@ -142,6 +152,156 @@ struct NavigationPoly {
 	bool operator!=(const NavigationPoly &other) const {
 		return !operator==(other);
 	}
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+};
+
+struct NavPolyTravelCostLessThan {
+	bool operator()(const NavigationPoly *p_poly_a, const NavigationPoly *p_poly_b) const {
+		return p_poly_a->total_travel_cost() < p_poly_b->total_travel_cost();
+	}
+};
+
+struct NavPolyHeapIndexer {
+	void operator()(NavigationPoly *p_poly, uint32_t p_heap_index) const {
+		p_poly->traversable_poly_index = p_heap_index;
+	}
+};
+
+/// Connected polygons of the same region or link inside one cell of the map cluster grid.
+/// The clusters form the abstract graph searched first by the hierarchical path queries.
+struct PathCluster {
+	/// Navigation region or link that contains the polygons of this cluster.
+	const NavBase *owner = nullptr;
+
+	/// The average center of the cluster polygons.
+	Vector3 center;
+
+	/// Indices of the clusters reached by the connections of the cluster polygons.
+	LocalVector<uint32_t> connections;
+};
+
+struct NavigationCluster {
+	/// Index of this cluster in the map.
+	uint32_t id = UINT32_MAX;
+
+	/// Id of the path query that last initialized this cluster.
+	uint32_t query_id = 0;
+
+	/// Id of the path query that found this cluster on its route, its polygons can then be searched.
+	uint32_t corridor_query_id = 0;
+
+	/// Index of this cluster in the heap of clusters to visit, UINT32_MAX once it is no longer in it.
+	uint32_t traversable_cluster_index = UINT32_MAX;
+
+	/// The cluster this one was reached from.
+	uint32_t back_navigation_cluster_id = UINT32_MAX;
+
+	/// The distance traveled until now (g cost).
+	real_t traveled_distance = 0.0;
+	/// The estimated distance to the destination (h cost).
+	real_t distance_to_destination = 0.0;
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+};
+
+struct NavClusterTravelCostLessThan {
+	bool operator()(const NavigationCluster *p_cluster_a, const NavigationCluster *p_cluster_b) const {
+		return p_cluster_a->total_travel_cost() < p_cluster_b->total_travel_cost();
+	}
+};
+
+struct NavClusterHeapIndexer {
+	void operator()(NavigationCluster *p_cluster, uint32_t p_heap_index) const {
+		p_cluster->traversable_cluster_index = p_heap_index;
+	}
+};
+
+template <class T>
+struct NoopIndexer {
+	void operator()(const T &p_value, uint32_t p_index) const {}
+};
+
+/// Binary heap that keeps the lowest element, according to `LessThan`, on top.
+/// `Indexer` is notified every time an element moves so it can be updated in place.
+template <class T, class LessThan = Comparator<T>, class Indexer = NoopIndexer<T>>
+class Heap {
+	LocalVector<T> buffer;
+	LessThan less_than;
+	Indexer indexer;
+
+	void _shift_up(uint32_t p_index) {
+		T element = buffer[p_index];
+		while (p_index > 0) {
+			const uint32_t parent_index = (p_index - 1) / 2;
+			if (!less_than(element, buffer[parent_index])) {
+				break;
+			}
+			buffer[p_index] = buffer[parent_index];
+			indexer(buffer[p_index], p_index);
+			p_index = parent_index;
+		}
+		buffer[p_index] = element;
+		indexer(buffer[p_index], p_index);
+	}
+
+	void _shift_down(uint32_t p_index) {
+		T element = buffer[p_index];
+		const uint32_t count = buffer.size();
+		while (true) {
+			uint32_t child_index = p_index * 2 + 1;
+			if (child_index >= count) {
+				break;
+			}
+			if (child_index + 1 < count && less_than(buffer[child_index + 1], buffer[child_index])) {
+				child_index++;
+			}
+			if (!less_than(buffer[child_index], element)) {
+				break;
+			}
+			buffer[p_index] = buffer[child_index];
+			indexer(buffer[p_index], p_index);
+			p_index = child_index;
+		}
+		buffer[p_index] = element;
+		indexer(buffer[p_index], p_index);
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return buffer.size(); }
+	_FORCE_INLINE_ bool is_empty() const { return buffer.is_empty(); }
+
+	void reserve(uint32_t p_size) { buffer.reserve(p_size); }
+	void clear() { buffer.clear(); }
+
+	void push(const T &p_element) {
+		buffer.push_back(p_element);
+		_shift_up(buffer.size() - 1);
+	}
+
+	T pop() {
+		ERR_FAIL_COND_V(buffer.is_empty(), T());
+		T top = buffer[0];
+		const uint32_t last = buffer.size() - 1;
+		if (last > 0) {
+			buffer[0] = buffer[last];
+			buffer.resize(last);
+			_shift_down(0);
+		} else {
+			buffer.resize(0);
+		}
+		return top;
+	}
+
+	/// Restores the heap order after the element at `p_index` decreased.
+	void shift(uint32_t p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, buffer.size());
+		_shift_up(p_index);
+	}
 };
 
 struct ClosestPointQueryResult {
@@ -33,6 +33,7 @@
 #include "navigation_mesh_generator.h"
 
 #include "core/math/convex_hull.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/multimesh_instance_3d.h"
@@ -540,25 +541,8 @@ void NavigationMeshGenerator::parse_source_geometry_data(const Ref<NavigationMes
 	}
 }
 
-void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback) {
-	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
-	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
-	ERR_FAIL_COND_MSG(!p_source_geometry_data->has_data(), "NavigationMeshSourceGeometryData3D is empty. Parse source geometry first.");
-
-	generator_mutex.lock();
-	if (baking_navmeshes.has(p_navigation_mesh)) {
-		generator_mutex.unlock();
-		ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
-	} else {
-		baking_navmeshes.insert(p_navigation_mesh);
-		generator_mutex.unlock();
-	}
-
-#ifndef _3D_DISABLED
-	const Vector<float> vertices = p_source_geometry_data->get_vertices();
-	const Vector<int> indices = p_source_geometry_data->get_indices();
-
-	if (vertices.size() < 3 || indices.size() < 3) {
+void NavigationMeshGenerator::_bake_navigation_mesh(const Ref<NavigationMesh> &p_navigation_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices) {
+	if (p_vertices.size() < 3 || p_indices.size() < 3) {
 		return;
 	}
 
@@ -574,10 +558,10 @@ void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh>
 
 	bake_state = "Setting up Configuration..."; // step #1
 
-	const float *verts = vertices.ptr();
-	const int nverts = vertices.size() / 3;
-	const int *tris = indices.ptr();
-	const int ntris = indices.size() / 3;
+	const float *verts = p_vertices.ptr();
+	const int nverts = p_vertices.size() / 3;
+	const int *tris = p_indices.ptr();
+	int ntris = p_indices.size() / 3;
 
 	float bmin[3], bmax[3];
 	rcCalcBounds(verts, nverts, bmin, bmax);
@@ -598,6 +582,7 @@ void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh>
 	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
 	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
 	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+	cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
 
 	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
 		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
@@ -608,6 +593,9 @@ void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh>
 	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
 		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
 	}
+	if (!Math::is_equal_approx((float)cfg.borderSize * cfg.cs, p_navigation_mesh->get_border_size())) {
+		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
+	}
 	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
 		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
 	}
@@ -642,6 +630,49 @@ void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh>
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
+	if (cfg.borderSize > 0) {
+		// The border is baked with the rest of the geometry and cut away again when building the contours.
+		// This lets navigation meshes baked for neighboring tiles meet at the edges of their baking AABB.
+		const float border = cfg.borderSize * cfg.cs;
+		cfg.bmin[0] -= border;
+		cfg.bmin[2] -= border;
+		cfg.bmax[0] += border;
+		cfg.bmax[2] += border;
+	}
+
+	// Only rasterize the triangles that touch the baked area, a tile usually covers a small part of the source geometry.
+	Vector<int> culled_indices;
+	if (baking_aabb.has_volume()) {
+		culled_indices.resize(p_indices.size());
+		int *culled_tris = culled_indices.ptrw();
+		int culled_ntris = 0;
+
+		for (int i = 0; i < ntris; i++) {
+			const int *tri = &tris[i * 3];
+			float tri_bmin[3], tri_bmax[3];
+			for (int j = 0; j < 3; j++) {
+				tri_bmin[j] = MIN(MIN(verts[tri[0] * 3 + j], verts[tri[1] * 3 + j]), verts[tri[2] * 3 + j]);
+				tri_bmax[j] = MAX(MAX(verts[tri[0] * 3 + j], verts[tri[1] * 3 + j]), verts[tri[2] * 3 + j]);
+			}
+			if (tri_bmin[0] > cfg.bmax[0] || tri_bmax[0] < cfg.bmin[0] || tri_bmin[1] > cfg.bmax[1] || tri_bmax[1] < cfg.bmin[1] || tri_bmin[2] > cfg.bmax[2] || tri_bmax[2] < cfg.bmin[2]) {
+				continue;
+			}
+			culled_tris[culled_ntris * 3 + 0] = tri[0];
+			culled_tris[culled_ntris * 3 + 1] = tri[1];
+			culled_tris[culled_ntris * 3 + 2] = tri[2];
+			culled_ntris++;
+		}
+
+		if (culled_ntris == 0) {
+			p_navigation_mesh->set_vertices(Vector<Vector3>());
+			p_navigation_mesh->clear_polygons();
+			return;
+		}
+
+		tris = culled_tris;
+		ntris = culled_ntris;
+	}
+
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
@@ -700,11 +731,11 @@ void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh>
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
 		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, 0, cfg.minRegionArea));
+		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
 	}
 
 	bake_state = "Creating contours..."; // step #8
@@ -765,6 +796,24 @@ void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh>
 	detail_mesh = nullptr;
 
 	bake_state = "Baking finished."; // step #12
+}
+
+void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data->has_data(), "NavigationMeshSourceGeometryData3D is empty. Parse source geometry first.");
+
+	generator_mutex.lock();
+	if (baking_navmeshes.has(p_navigation_mesh)) {
+		generator_mutex.unlock();
+		ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
+	} else {
+		baking_navmeshes.insert(p_navigation_mesh);
+		generator_mutex.unlock();
+	}
+
+#ifndef _3D_DISABLED
+	_bake_navigation_mesh(p_navigation_mesh, p_source_geometry_data->get_vertices(), p_source_geometry_data->get_indices());
 #endif // _3D_DISABLED
 
 	generator_mutex.lock();
@@ -781,12 +830,68 @@ void NavigationMeshGenerator::bake_from_source_geometry_data(Ref<NavigationMesh>
 	}
 }
 
+void NavigationMeshGenerator::_bake_tile_task(uint32_t p_index, TileBakeData *p_data) {
+	_bake_navigation_mesh(p_data->navigation_meshes[p_index], p_data->vertices, p_data->indices);
+}
+
+void NavigationMeshGenerator::bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_navigation_meshes, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data->has_data(), "NavigationMeshSourceGeometryData3D is empty. Parse source geometry first.");
+
+	TileBakeData tile_data;
+	tile_data.navigation_meshes.resize(p_navigation_meshes.size());
+	for (int i = 0; i < p_navigation_meshes.size(); i++) {
+		Ref<NavigationMesh> navigation_mesh = p_navigation_meshes[i];
+		ERR_FAIL_COND_MSG(!navigation_mesh.is_valid(), "Invalid navigation mesh.");
+		tile_data.navigation_meshes[i] = navigation_mesh;
+	}
+
+	generator_mutex.lock();
+	for (uint32_t i = 0; i < tile_data.navigation_meshes.size(); i++) {
+		if (baking_navmeshes.has(tile_data.navigation_meshes[i])) {
+			for (uint32_t j = 0; j < i; j++) {
+				baking_navmeshes.erase(tile_data.navigation_meshes[j]);
+			}
+			generator_mutex.unlock();
+			ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
+		}
+		baking_navmeshes.insert(tile_data.navigation_meshes[i]);
+	}
+	generator_mutex.unlock();
+
+	tile_data.vertices = p_source_geometry_data->get_vertices();
+	tile_data.indices = p_source_geometry_data->get_indices();
+
+	if (tile_data.navigation_meshes.size() == 1) {
+		_bake_tile_task(0, &tile_data);
+	} else if (tile_data.navigation_meshes.size() > 1) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshGenerator::_bake_tile_task, &tile_data, tile_data.navigation_meshes.size(), -1, false, SNAME("NavigationMeshTileBake"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	}
+
+	generator_mutex.lock();
+	for (const Ref<NavigationMesh> &navigation_mesh : tile_data.navigation_meshes) {
+		baking_navmeshes.erase(navigation_mesh);
+	}
+	generator_mutex.unlock();
+
+	if (p_callback.is_valid()) {
+		Callable::CallError ce;
+		Variant result;
+		p_callback.callp(nullptr, 0, result, ce);
+		if (ce.error == Callable::CallError::CALL_OK) {
+			//
+		}
+	}
+}
+
 void NavigationMeshGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bake", "navigation_mesh", "root_node"), &NavigationMeshGenerator::bake);
 	ClassDB::bind_method(D_METHOD("clear", "navigation_mesh"), &NavigationMeshGenerator::clear);
 
 	ClassDB::bind_method(D_METHOD("parse_source_geometry_data", "navigation_mesh", "source_geometry_data", "root_node", "callback"), &NavigationMeshGenerator::parse_source_geometry_data, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("bake_from_source_geometry_data", "navigation_mesh", "source_geometry_data", "callback"), &NavigationMeshGenerator::bake_from_source_geometry_data, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("bake_tiles_from_source_geometry_data", "navigation_meshes", "source_geometry_data", "callback"), &NavigationMeshGenerator::bake_tiles_from_source_geometry_data, DEFVAL(Callable()));
 }
 
 #endif
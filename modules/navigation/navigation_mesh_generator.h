@@ -48,6 +48,14 @@ class NavigationMeshGenerator : public Object {
 
 	HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
+	struct TileBakeData {
+		LocalVector<Ref<NavigationMesh>> navigation_meshes;
+		Vector<float> vertices;
+		Vector<int> indices;
+	};
+
+	void _bake_tile_task(uint32_t p_index, TileBakeData *p_data);
+
 protected:
 	static void _bind_methods();
 
@@ -55,6 +63,7 @@ protected:
 	static void _add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform, Vector<float> &p_vertices, Vector<int> &p_indices);
 	static void _add_mesh_array(const Array &p_array, const Transform3D &p_xform, Vector<float> &p_vertices, Vector<int> &p_indices);
 	static void _add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform, Vector<float> &p_vertices, Vector<int> &p_indices);
+	static void _bake_navigation_mesh(const Ref<NavigationMesh> &p_navigation_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices);
 	static void _parse_geometry(const Transform3D &p_navmesh_transform, Node *p_node, Vector<float> &p_vertices, Vector<int> &p_indices, NavigationMesh::ParsedGeometryType p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
 
 public:
@@ -68,6 +77,7 @@ public:
 
 	void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable());
+	void bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_navigation_meshes, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable());
 };
 
 #endif
@@ -0,0 +1,497 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		RID scenario_rid = E.scenario;
+		RID instance_rid = E.instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	if (scenarios.has(p_scenario)) {
+		return;
+	}
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_COND(!scenario);
+
+	// There is no acceleration structure being built in the background, so the scenario can go away right now.
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		Occluder *occluder = occluder_owner.get_or_null(E.value.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, E.key));
+		}
+	}
+
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_COND(!occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	// Enabling or disabling only affects which instances get rasterized, the transformed vertices stay valid.
+	instance.enabled = p_enabled;
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	occ_inst->xformed_vertices.clear();
+	occ_inst->indices.clear();
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ || occ->vertices.is_empty()) {
+		return;
+	}
+
+	int vertices_size = occ->vertices.size();
+	const Vector3 *read_ptr = occ->vertices.ptr();
+
+	int indices_size = occ->indices.size();
+	const int32_t *indices_ptr = occ->indices.ptr();
+	for (int i = 0; i < indices_size; i++) {
+		ERR_FAIL_INDEX_MSG(indices_ptr[i], vertices_size, "Occluder mesh has out of bounds indices, it will be ignored.");
+	}
+
+	occ_inst->xformed_vertices.resize(vertices_size);
+	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+
+	for (int i = 0; i < vertices_size; i++) {
+		write_ptr[i] = occ_inst->xform.xform(read_ptr[i]);
+	}
+
+	occ_inst->aabb = AABB(write_ptr[0], Vector3());
+	for (int i = 1; i < vertices_size; i++) {
+		occ_inst->aabb.expand_to(write_ptr[i]);
+	}
+
+	occ_inst->indices.resize(indices_size);
+	memcpy(occ_inst->indices.ptr(), indices_ptr, indices_size * sizeof(int32_t));
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+	removed_instances.clear();
+
+	if (dirty_instances_array.is_empty()) {
+		return;
+	}
+
+	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < dirty_instances_array.size(); i++) {
+			_update_dirty_instance(i, dirty_instances_array.ptr());
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::_add_triangle(const Vector3 *p_view, const Projection &p_cam_projection, bool p_cam_orthogonal, const Size2i &p_size) {
+	// Clip against the near plane in view space, which leaves a triangle or a quad.
+	const float z_near = p_cam_projection.get_z_near();
+
+	Vector3 clipped[4];
+	int clipped_count = 0;
+
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_view[i];
+		const Vector3 &b = p_view[(i + 1) % 3];
+		float da = -a.z - z_near;
+		float db = -b.z - z_near;
+
+		if (da >= 0.0f) {
+			clipped[clipped_count++] = a;
+		}
+		if ((da >= 0.0f) != (db >= 0.0f)) {
+			clipped[clipped_count++] = a + (b - a) * (da / (da - db));
+		}
+	}
+
+	if (clipped_count < 3) {
+		return;
+	}
+
+	Vector2 screen[4];
+	float depth[4];
+
+	for (int i = 0; i < clipped_count; i++) {
+		Plane projected = p_cam_projection.xform4(Plane(clipped[i], 1.0));
+		float w = projected.d;
+		screen[i] = Vector2((projected.normal.x / w * 0.5f + 0.5f) * p_size.x, (projected.normal.y / w * 0.5f + 0.5f) * p_size.y);
+
+		// View depth is linear in screen space for orthogonal cameras, and its inverse is for perspective ones.
+		float view_depth = -clipped[i].z;
+		depth[i] = p_cam_orthogonal ? view_depth : 1.0f / view_depth;
+	}
+
+	for (int i = 2; i < clipped_count; i++) {
+		const Vector2 v[3] = { screen[0], screen[i - 1], screen[i] };
+		const float d[3] = { depth[0], depth[i - 1], depth[i] };
+
+		float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+		if (Math::abs(area) < CMP_EPSILON) {
+			continue;
+		}
+
+		// Pixel centers are at half coordinates, clamp in float first so huge triangles can't overflow the int conversion.
+		Vector2 rect_min = v[0].min(v[1]).min(v[2]);
+		Vector2 rect_max = v[0].max(v[1]).max(v[2]);
+
+		ScreenTriangle t;
+		t.min_x = MAX(0, (int)Math::ceil(CLAMP(rect_min.x, -1.0f, p_size.x + 1.0f) - 0.5f));
+		t.max_x = MIN(p_size.x - 1, (int)Math::floor(CLAMP(rect_max.x, -1.0f, p_size.x + 1.0f) - 0.5f));
+		t.min_y = MAX(0, (int)Math::ceil(CLAMP(rect_min.y, -1.0f, p_size.y + 1.0f) - 0.5f));
+		t.max_y = MIN(p_size.y - 1, (int)Math::floor(CLAMP(rect_max.y, -1.0f, p_size.y + 1.0f) - 0.5f));
+
+		if (t.min_x > t.max_x || t.min_y > t.max_y) {
+			continue;
+		}
+
+		float inv_area = 1.0f / area;
+		t.depth_a = 0.0f;
+		t.depth_b = 0.0f;
+		t.depth_c = 0.0f;
+
+		for (int j = 0; j < 3; j++) {
+			const Vector2 &a = v[(j + 1) % 3];
+			const Vector2 &b = v[(j + 2) % 3];
+			t.edge_a[j] = (a.y - b.y) * inv_area;
+			t.edge_b[j] = (b.x - a.x) * inv_area;
+			t.edge_c[j] = ((b.y - a.y) * a.x - (b.x - a.x) * a.y) * inv_area;
+
+			t.depth_a += t.edge_a[j] * d[j];
+			t.depth_b += t.edge_b[j] * d[j];
+			t.depth_c += t.edge_c[j] * d[j];
+		}
+
+		triangles.push_back(t);
+	}
+}
+
+void RasterOcclusionCull::_setup_triangles(const Scenario &p_scenario, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, const Size2i &p_size) {
+	triangles.clear();
+
+	Transform3D cam_inv_transform = p_cam_transform.affine_inverse();
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	const Plane *planes_ptr = planes.ptr();
+	int plane_count = planes.size();
+
+	for (const KeyValue<RID, OccluderInstance> &E : p_scenario.instances) {
+		const OccluderInstance &occ_inst = E.value;
+
+		if (!occ_inst.enabled || occ_inst.removed || occ_inst.indices.is_empty() || !occluder_owner.owns(occ_inst.occluder)) {
+			continue;
+		}
+
+		bool outside = false;
+		for (int i = 0; i < plane_count; i++) {
+			// Test the corner that lies furthest inside of each (outward facing) frustum plane.
+			const Plane &p = planes_ptr[i];
+			const AABB &aabb = occ_inst.aabb;
+			Vector3 corner(
+					p.normal.x > 0 ? aabb.position.x : aabb.position.x + aabb.size.x,
+					p.normal.y > 0 ? aabb.position.y : aabb.position.y + aabb.size.y,
+					p.normal.z > 0 ? aabb.position.z : aabb.position.z + aabb.size.z);
+			if (p.distance_to(corner) > 0) {
+				outside = true;
+				break;
+			}
+		}
+
+		if (outside) {
+			continue;
+		}
+
+		uint32_t vertex_count = occ_inst.xformed_vertices.size();
+		view_vertices.resize(vertex_count);
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			view_vertices[i] = cam_inv_transform.xform(occ_inst.xformed_vertices[i]);
+		}
+
+		const uint32_t *indices = occ_inst.indices.ptr();
+		uint32_t index_count = occ_inst.indices.size();
+
+		for (uint32_t i = 0; i + 2 < index_count; i += 3) {
+			const Vector3 triangle[3] = { view_vertices[indices[i]], view_vertices[indices[i + 1]], view_vertices[indices[i + 2]] };
+			_add_triangle(triangle, p_cam_projection, p_cam_orthogonal, p_size);
+		}
+	}
+}
+
+template <bool p_orthogonal>
+void RasterOcclusionCull::_rasterize_triangle(const ScreenTriangle &p_triangle, float *p_depth, int p_width, int p_from_y, int p_to_y) {
+	const ScreenTriangle &t = p_triangle;
+	int from_y = MAX(t.min_y, p_from_y);
+	int to_y = MIN(t.max_y + 1, p_to_y);
+
+	for (int y = from_y; y < to_y; y++) {
+		float py = y + 0.5f;
+		float row_e0 = t.edge_b[0] * py + t.edge_c[0];
+		float row_e1 = t.edge_b[1] * py + t.edge_c[1];
+		float row_e2 = t.edge_b[2] * py + t.edge_c[2];
+		float row_depth = t.depth_b * py + t.depth_c;
+		float *row = &p_depth[y * p_width];
+
+		// Kept free of branches so the compiler can vectorize the span.
+		for (int x = t.min_x; x <= t.max_x; x++) {
+			float px = x + 0.5f;
+			float e0 = t.edge_a[0] * px + row_e0;
+			float e1 = t.edge_a[1] * px + row_e1;
+			float e2 = t.edge_a[2] * px + row_e2;
+			float d = t.depth_a * px + row_depth;
+			if (!p_orthogonal) {
+				d = 1.0f / d;
+			}
+
+			bool inside = (e0 >= 0.0f) & (e1 >= 0.0f) & (e2 >= 0.0f);
+			row[x] = inside ? MIN(row[x], d) : row[x];
+		}
+	}
+}
+
+void RasterOcclusionCull::_rasterize_band(uint32_t p_band, const RasterThreadData *p_data) {
+	int width = p_data->size.x;
+	int height = p_data->size.y;
+	int from_y = p_band * height / p_data->band_count;
+	int to_y = (p_band + 1 == p_data->band_count) ? height : ((p_band + 1) * height / p_data->band_count);
+
+	float *depth = p_data->depth;
+	for (int i = from_y * width; i < to_y * width; i++) {
+		depth[i] = p_data->clear_depth;
+	}
+
+	for (const ScreenTriangle &t : triangles) {
+		if (t.max_y < from_y || t.min_y >= to_y) {
+			continue;
+		}
+
+		if (p_data->orthogonal) {
+			_rasterize_triangle<true>(t, depth, width, from_y, to_y);
+		} else {
+			_rasterize_triangle<false>(t, depth, width, from_y, to_y);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update();
+
+	Size2i size = buffer.get_size();
+	_setup_triangles(scenario, p_cam_transform, p_cam_projection, p_cam_orthogonal, size);
+
+	RasterThreadData td;
+	td.depth = buffer.get_depth();
+	td.size = size;
+	td.clear_depth = p_cam_projection.get_z_far() * 1.05f;
+	td.orthogonal = p_cam_orthogonal;
+	td.band_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), (uint32_t)size.y);
+
+	buffer.set_debug_range(td.clear_depth);
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_rasterize_band, &td, td.band_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
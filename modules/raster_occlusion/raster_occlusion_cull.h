@@ -0,0 +1,164 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/projection.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that rasterizes occluders into the HZ buffer in software,
+// so it doesn't depend on Embree and works on every architecture Godot supports.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	class RasterHZBuffer : public HZBuffer {
+	public:
+		RID scenario_rid;
+
+		_FORCE_INLINE_ float *get_depth() { return mips[0]; }
+		_FORCE_INLINE_ Size2i get_size() const { return sizes[0]; }
+		_FORCE_INLINE_ void set_debug_range(float p_range) { debug_tex_range = p_range; }
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<uint32_t> indices;
+		LocalVector<Vector3> xformed_vertices;
+		AABB aabb;
+		Transform3D xform;
+		bool enabled = true;
+		bool removed = false;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
+		LocalVector<RID> removed_instances;
+
+		void _update_dirty_instance(uint32_t p_idx, RID *p_instances);
+		void update();
+	};
+
+	// Triangle in buffer pixel coordinates, stored as plane equations so each
+	// band can walk its rows without redoing the setup. The edge functions are
+	// normalized by the triangle area, so they are positive inside regardless of
+	// winding and double as barycentric coordinates.
+	struct ScreenTriangle {
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+		float depth_a;
+		float depth_b;
+		float depth_c;
+		int min_x;
+		int max_x;
+		int min_y;
+		int max_y;
+	};
+
+	struct RasterThreadData {
+		float *depth = nullptr;
+		Size2i size;
+		float clear_depth = 0.0f;
+		uint32_t band_count = 0;
+		bool orthogonal = false;
+	};
+
+	static RasterOcclusionCull *raster_singleton;
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	LocalVector<Vector3> view_vertices;
+	LocalVector<ScreenTriangle> triangles;
+
+	void _add_triangle(const Vector3 *p_view, const Projection &p_cam_projection, bool p_cam_orthogonal, const Size2i &p_size);
+	void _setup_triangles(const Scenario &p_scenario, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, const Size2i &p_size);
+	void _rasterize_band(uint32_t p_band, const RasterThreadData *p_data);
+
+	template <bool p_orthogonal>
+	static void _rasterize_triangle(const ScreenTriangle &p_triangle, float *p_depth, int p_width, int p_from_y, int p_to_y);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,242 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "../raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+const Size2i buffer_size = Size2i(64, 64);
+
+// Sets up a scenario with a single occluder and a buffer bound to it.
+struct OcclusionScene {
+	RasterOcclusionCull *cull = nullptr;
+	RID scenario = RID::from_uint64(1);
+	RID instance = RID::from_uint64(2);
+	RID buffer = RID::from_uint64(3);
+	RID occluder;
+
+	OcclusionScene(const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+		cull = memnew(RasterOcclusionCull);
+		occluder = cull->occluder_allocate();
+		cull->occluder_initialize(occluder);
+		cull->occluder_set_mesh(occluder, p_vertices, p_indices);
+
+		cull->add_scenario(scenario);
+		cull->scenario_set_instance(scenario, instance, occluder, Transform3D(), true);
+
+		cull->add_buffer(buffer);
+		cull->buffer_set_scenario(buffer, scenario);
+		cull->buffer_set_size(buffer, buffer_size);
+	}
+
+	RasterOcclusionCull::RasterHZBuffer *render(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+		cull->buffer_update(buffer, p_cam_transform, p_cam_projection, p_cam_orthogonal);
+		return static_cast<RasterOcclusionCull::RasterHZBuffer *>(cull->buffer_get_ptr(buffer));
+	}
+
+	~OcclusionScene() {
+		cull->remove_buffer(buffer);
+		cull->scenario_remove_instance(scenario, instance);
+		cull->remove_scenario(scenario);
+		cull->free_occluder(occluder);
+		memdelete(cull);
+	}
+};
+
+// Normalized device coordinate at the center of a buffer pixel.
+float pixel_to_ndc(int p_pixel, int p_size) {
+	return (p_pixel + 0.5f) / p_size * 2.0f - 1.0f;
+}
+
+PackedInt32Array quad_indices() {
+	PackedInt32Array indices;
+	indices.push_back(0);
+	indices.push_back(1);
+	indices.push_back(2);
+	indices.push_back(0);
+	indices.push_back(2);
+	indices.push_back(3);
+	return indices;
+}
+
+TEST_CASE("[RasterOcclusionCull] Triangles crossing the near plane are clipped") {
+	// A floor below the camera that starts behind it. Every triangle has vertices on both sides of the near plane.
+	PackedVector3Array vertices;
+	vertices.push_back(Vector3(-100, -0.2, 5));
+	vertices.push_back(Vector3(100, -0.2, 5));
+	vertices.push_back(Vector3(100, -0.2, -40));
+	vertices.push_back(Vector3(-100, -0.2, -40));
+	OcclusionScene scene(vertices, quad_indices());
+
+	const float z_near = 0.5f;
+	const float z_far = 100.0f;
+	Projection projection;
+	projection.set_perspective(90, 1.0, z_near, z_far);
+
+	RasterOcclusionCull::RasterHZBuffer *buffer = scene.render(Transform3D(), projection, false);
+	REQUIRE(buffer);
+	REQUIRE(buffer->get_size() == buffer_size);
+	const float *depth = buffer->get_depth();
+	const float clear_depth = z_far * 1.05f;
+
+	int floor_pixels = 0;
+	int clipped_pixels = 0;
+	for (int y = 0; y < buffer_size.y; y++) {
+		// With a 90 degree field of view, the floor is at a view depth of 0.2 / |ndc_y| below the horizon.
+		// It is closer than the near plane for |ndc_y| > 0.4, and further than its far edge for |ndc_y| < 0.005.
+		float ndc_y = pixel_to_ndc(y, buffer_size.y);
+
+		for (int x = 0; x < buffer_size.x; x++) {
+			float d = depth[y * buffer_size.x + x];
+			CHECK_MESSAGE(d >= z_near * 0.99f, "Nothing in front of the near plane should be rasterized.");
+
+			if (ndc_y > -0.005f || ndc_y < -0.45f) {
+				CHECK_MESSAGE(d == doctest::Approx(clear_depth), "Pixels above the horizon or in front of the near plane should keep the clear depth.");
+				clipped_pixels += ndc_y < -0.45f;
+			} else if (ndc_y > -0.35f && ndc_y < -0.01f) {
+				CHECK_MESSAGE(d == doctest::Approx(0.2f / -ndc_y).epsilon(0.01), "The clipped floor should keep its perspective correct depth.");
+				floor_pixels++;
+			}
+		}
+	}
+
+	CHECK(floor_pixels > 0);
+	CHECK(clipped_pixels > 0);
+}
+
+TEST_CASE("[RasterOcclusionCull] Depth is interpolated for the camera projection") {
+	// A wall that recedes from z = -2 on the left to z = -10 on the right, along the plane z = -6 - x.
+	PackedVector3Array vertices;
+	vertices.push_back(Vector3(-4, -4, -2));
+	vertices.push_back(Vector3(4, -4, -10));
+	vertices.push_back(Vector3(4, 4, -10));
+	vertices.push_back(Vector3(-4, 4, -2));
+	OcclusionScene scene(vertices, quad_indices());
+
+	SUBCASE("Perspective") {
+		Projection projection;
+		projection.set_perspective(90, 1.0, 0.05, 100.0);
+
+		RasterOcclusionCull::RasterHZBuffer *buffer = scene.render(Transform3D(), projection, false);
+		REQUIRE(buffer);
+		const float *depth = buffer->get_depth();
+
+		int checked = 0;
+		for (int y = 0; y < buffer_size.y; y++) {
+			float ndc_y = pixel_to_ndc(y, buffer_size.y);
+			for (int x = 0; x < buffer_size.x; x++) {
+				float ndc_x = pixel_to_ndc(x, buffer_size.x);
+				if (ndc_x < -0.8f || ndc_x > 0.3f || Math::abs(ndc_y) > 0.3f) {
+					continue;
+				}
+
+				// The view ray through the pixel is (ndc_x, ndc_y, -1) * depth, which meets the wall at 6 / (1 - ndc_x).
+				CHECK(depth[y * buffer_size.x + x] == doctest::Approx(6.0f / (1.0f - ndc_x)).epsilon(0.01));
+				checked++;
+			}
+		}
+		CHECK(checked > 0);
+	}
+
+	SUBCASE("Orthogonal") {
+		Projection projection;
+		projection.set_orthogonal(16.0, 1.0, 0.05, 100.0);
+
+		RasterOcclusionCull::RasterHZBuffer *buffer = scene.render(Transform3D(), projection, true);
+		REQUIRE(buffer);
+		const float *depth = buffer->get_depth();
+
+		int checked = 0;
+		for (int y = 0; y < buffer_size.y; y++) {
+			float ndc_y = pixel_to_ndc(y, buffer_size.y);
+			for (int x = 0; x < buffer_size.x; x++) {
+				float ndc_x = pixel_to_ndc(x, buffer_size.x);
+				if (Math::abs(ndc_x) > 0.4f || Math::abs(ndc_y) > 0.4f) {
+					continue;
+				}
+
+				// The view rays are parallel, so the pixel at ndc_x looks down x = 8 * ndc_x and depth is linear in screen space.
+				CHECK(depth[y * buffer_size.x + x] == doctest::Approx(6.0f + 8.0f * ndc_x).epsilon(0.01));
+				checked++;
+			}
+		}
+		CHECK(checked > 0);
+	}
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluders hide the bounds behind them") {
+	// A wall in front of the camera that covers most of the view.
+	PackedVector3Array vertices;
+	vertices.push_back(Vector3(-4, -4, -5));
+	vertices.push_back(Vector3(4, -4, -5));
+	vertices.push_back(Vector3(4, 4, -5));
+	vertices.push_back(Vector3(-4, 4, -5));
+	OcclusionScene scene(vertices, quad_indices());
+
+	const float z_near = 0.05f;
+	Projection projection;
+	projection.set_perspective(90, 1.0, z_near, 100.0);
+	Transform3D cam_transform;
+	Transform3D cam_inv_transform = cam_transform.affine_inverse();
+
+	RasterOcclusionCull::HZBuffer *buffer = scene.render(cam_transform, projection, false);
+	REQUIRE(buffer);
+
+	const real_t behind[6] = { -1, -1, -10, 1, 1, -8 };
+	const real_t in_front[6] = { -1, -1, -3, 1, 1, -2 };
+	const real_t beside[6] = { 18, -1, -21, 19, 1, -20 };
+
+	CHECK_MESSAGE(buffer->is_occluded(behind, cam_transform.origin, cam_inv_transform, projection, z_near), "Bounds behind the wall should be occluded.");
+	CHECK_FALSE_MESSAGE(buffer->is_occluded(in_front, cam_transform.origin, cam_inv_transform, projection, z_near), "Bounds in front of the wall should be visible.");
+	CHECK_FALSE_MESSAGE(buffer->is_occluded(beside, cam_transform.origin, cam_inv_transform, projection, z_near), "Bounds past the edge of the wall should be visible.");
+
+	SUBCASE("Disabled occluders don't hide anything") {
+		scene.cull->scenario_set_instance(scene.scenario, scene.instance, scene.occluder, Transform3D(), false);
+		buffer = scene.render(cam_transform, projection, false);
+		REQUIRE(buffer);
+		CHECK_FALSE(buffer->is_occluded(behind, cam_transform.origin, cam_inv_transform, projection, z_near));
+	}
+
+	SUBCASE("Moving the occluder updates the buffer") {
+		scene.cull->scenario_set_instance(scene.scenario, scene.instance, scene.occluder, Transform3D(Basis(), Vector3(0, 0, -10)), true);
+		buffer = scene.render(cam_transform, projection, false);
+		REQUIRE(buffer);
+		CHECK_FALSE(buffer->is_occluded(behind, cam_transform.origin, cam_inv_transform, projection, z_near));
+	}
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
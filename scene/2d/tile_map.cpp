@@ -31,6 +31,8 @@
 #include "tile_map.h"
 
 #include "core/io/marshalls.h"
+#include "core/math/geometry_2d.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/resources/world_2d.h"
 #include "servers/navigation_server_2d.h"
 
@@ -38,6 +40,9 @@
 #include "servers/navigation_server_3d.h"
 #endif // DEBUG_ENABLED
 
+// Below this number of dirty cells, dispatching the physics quadrant builds costs more than running them.
+#define PHYSICS_QUADRANT_PARALLEL_CELL_MIN 1024
+
 HashMap<Vector2i, TileSet::CellNeighbor> TileMap::TerrainConstraint::get_overlapping_coords_and_peering_bits() const {
 	HashMap<Vector2i, TileSet::CellNeighbor> output;
 
@@ -757,6 +762,20 @@ bool TileMap::is_collision_animatable() const {
 	return collision_animatable;
 }
 
+void TileMap::set_collision_merging_enabled(bool p_enabled) {
+	if (collision_merging_enabled == p_enabled) {
+		return;
+	}
+	collision_merging_enabled = p_enabled;
+	_clear_internals();
+	_recreate_internals();
+	emit_signal(SNAME("changed"));
+}
+
+bool TileMap::is_collision_merging_enabled() const {
+	return collision_merging_enabled;
+}
+
 void TileMap::set_collision_visibility_mode(TileMap::VisibilityMode p_show_collision) {
 	if (collision_visibility_mode == p_show_collision) {
 		return;
@@ -1588,106 +1607,410 @@ void TileMap::_physics_notification(int p_what) {
 	}
 }
 
-void TileMap::_physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r_dirty_quadrant_list) {
-	ERR_FAIL_COND(!is_inside_tree());
-	ERR_FAIL_COND(!tile_set.is_valid());
+// Tile collision polygons, in quadrant body space, that can be merged together.
+struct TileCollisionMergeGroup {
+	bool one_way_collision = false;
+	float one_way_collision_margin = 0.0;
+	LocalVector<Vector<Vector2>> polygons;
+};
 
-	Transform2D gl_transform = get_global_transform();
-	last_valid_transform = gl_transform;
-	new_transform = gl_transform;
-	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
-	RID space = get_world_2d()->get_space();
+// A quadrant body holding the merged collision polygons of a physics layer.
+struct TileCollisionMergeBody {
+	int tile_set_physics_layer = 0;
+	Vector2 linear_velocity;
+	LocalVector<TileCollisionMergeGroup> groups;
+};
 
-	SelfList<TileMapQuadrant> *q_list_element = r_dirty_quadrant_list.first();
-	while (q_list_element) {
-		TileMapQuadrant &q = *q_list_element->self();
+struct TileCollisionEdge {
+	Vector2 from;
+	Vector2 to;
 
-		// Clear bodies.
-		for (RID body : q.bodies) {
-			bodies_coords.erase(body);
-			ps->free(body);
+	static _FORCE_INLINE_ uint32_t hash(const TileCollisionEdge &p_edge) {
+		uint32_t h = hash_murmur3_one_real(p_edge.from.x);
+		h = hash_murmur3_one_real(p_edge.from.y, h);
+		h = hash_murmur3_one_real(p_edge.to.x, h);
+		h = hash_murmur3_one_real(p_edge.to.y, h);
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const TileCollisionEdge &p_edge) const {
+		return from == p_edge.from && to == p_edge.to;
+	}
+};
+
+// Joins two counter-clockwise convex polygons along the edge p_a[p_edge] -> p_a[p_edge + 1],
+// which p_b shares in the opposite direction. Fails if the result is not convex.
+bool TileMap::merge_convex_polygon_pair(const Vector<Vector2> &p_a, int p_edge, const Vector<Vector2> &p_b, Vector<Vector2> &r_merged) {
+	const int size_a = p_a.size();
+	const int size_b = p_b.size();
+	const Vector2 edge_to = p_a[(p_edge + 1) % size_a];
+
+	int b_start = -1;
+	for (int i = 0; i < size_b; i++) {
+		if (p_b[i] == edge_to && p_b[(i + 1) % size_b] == p_a[p_edge]) {
+			b_start = i;
+			break;
 		}
-		q.bodies.clear();
+	}
+	if (b_start == -1) {
+		return false;
+	}
 
-		// Recreate bodies and shapes.
-		for (const Vector2i &E_cell : q.cells) {
-			TileMapCell c = get_cell(q.layer, E_cell, true);
+	// Walk around A starting after the shared edge, then around B skipping the shared vertices.
+	LocalVector<Vector2> joined;
+	joined.reserve(size_a + size_b - 2);
+	for (int i = 1; i <= size_a; i++) {
+		joined.push_back(p_a[(p_edge + i) % size_a]);
+	}
+	for (int i = 2; i < size_b; i++) {
+		joined.push_back(p_b[(b_start + i) % size_b]);
+	}
+
+	// Drop the vertices which became collinear, and reject any reflex one.
+	const int joined_size = joined.size();
+	r_merged.clear();
+	for (int i = 0; i < joined_size; i++) {
+		const Vector2 &prev = joined[(i + joined_size - 1) % joined_size];
+		const Vector2 &current = joined[i];
+		const Vector2 &next = joined[(i + 1) % joined_size];
+		Vector2 edge_in = current - prev;
+		Vector2 edge_out = next - current;
+		real_t cross = edge_in.cross(edge_out);
+		real_t tolerance = CMP_EPSILON * edge_in.length() * edge_out.length();
+		if (cross > tolerance) {
+			r_merged.push_back(current);
+		} else if (cross < -tolerance || edge_in.dot(edge_out) <= 0.0) {
+			return false;
+		}
+	}
+	return r_merged.size() >= 3;
+}
 
-			TileSetSource *source;
-			if (tile_set->has_source(c.source_id)) {
-				source = *tile_set->get_source(c.source_id);
+// Greedily merges convex polygons which share a full edge, as long as the result stays convex.
+void TileMap::merge_convex_polygons(LocalVector<Vector<Vector2>> &r_polygons) {
+	// Snap the points so that the edges shared by neighboring tiles match exactly.
+	const real_t snap = 1.0 / 256.0;
+	for (Vector<Vector2> &polygon : r_polygons) {
+		Vector2 *w = polygon.ptrw();
+		for (int i = 0; i < polygon.size(); i++) {
+			w[i] = w[i].snapped(Vector2(snap, snap));
+		}
+		if (Geometry2D::is_polygon_clockwise(polygon)) {
+			polygon.reverse();
+		}
+	}
 
-				if (!source->has_tile(c.get_atlas_coords()) || !source->has_alternative_tile(c.get_atlas_coords(), c.alternative_tile)) {
+	HashMap<TileCollisionEdge, uint32_t, TileCollisionEdge> edges;
+	for (uint32_t i = 0; i < r_polygons.size(); i++) {
+		const Vector<Vector2> &polygon = r_polygons[i];
+		for (int j = 0; j < polygon.size(); j++) {
+			edges[TileCollisionEdge{ polygon[j], polygon[(j + 1) % polygon.size()] }] = i;
+		}
+	}
+
+	Vector<Vector2> merged;
+	for (uint32_t i = 0; i < r_polygons.size(); i++) {
+		bool merged_any = true;
+		while (merged_any && !r_polygons[i].is_empty()) {
+			merged_any = false;
+			const Vector<Vector2> &polygon = r_polygons[i];
+			for (int j = 0; j < polygon.size(); j++) {
+				const uint32_t *other = edges.getptr(TileCollisionEdge{ polygon[(j + 1) % polygon.size()], polygon[j] });
+				if (!other || *other == i || r_polygons[*other].is_empty()) {
+					continue;
+				}
+				if (!merge_convex_polygon_pair(polygon, j, r_polygons[*other], merged)) {
 					continue;
 				}
 
-				TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(source);
-				if (atlas_source) {
-					const TileData *tile_data;
-					if (q.runtime_tile_data_cache.has(E_cell)) {
-						tile_data = q.runtime_tile_data_cache[E_cell];
-					} else {
-						tile_data = atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile);
+				// Replace both polygons with the merged one.
+				const uint32_t replaced[2] = { i, *other };
+				for (uint32_t index : replaced) {
+					const Vector<Vector2> &old_polygon = r_polygons[index];
+					for (int k = 0; k < old_polygon.size(); k++) {
+						TileCollisionEdge edge = { old_polygon[k], old_polygon[(k + 1) % old_polygon.size()] };
+						const uint32_t *owner = edges.getptr(edge);
+						if (owner && *owner == index) {
+							edges.erase(edge);
+						}
 					}
-					for (int tile_set_physics_layer = 0; tile_set_physics_layer < tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
-						Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(tile_set_physics_layer);
-						uint32_t physics_layer = tile_set->get_physics_layer_collision_layer(tile_set_physics_layer);
-						uint32_t physics_mask = tile_set->get_physics_layer_collision_mask(tile_set_physics_layer);
-
-						// Create the body.
-						RID body = ps->body_create();
-						bodies_coords[body] = E_cell;
-						bodies_layers[body] = q.layer;
-						ps->body_set_mode(body, collision_animatable ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
-						ps->body_set_space(body, space);
+				}
+				r_polygons[replaced[1]].clear();
+				r_polygons[i] = merged;
+				for (int k = 0; k < merged.size(); k++) {
+					edges[TileCollisionEdge{ merged[k], merged[(k + 1) % merged.size()] }] = i;
+				}
+				merged_any = true;
+				break;
+			}
+		}
+	}
 
-						Transform2D xform;
-						xform.set_origin(map_to_local(E_cell));
-						xform = gl_transform * xform;
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
-
-						ps->body_attach_object_instance_id(body, get_instance_id());
-						ps->body_set_collision_layer(body, physics_layer);
-						ps->body_set_collision_mask(body, physics_mask);
-						ps->body_set_pickable(body, false);
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, tile_data->get_constant_linear_velocity(tile_set_physics_layer));
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, tile_data->get_constant_angular_velocity(tile_set_physics_layer));
-
-						if (!physics_material.is_valid()) {
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
-						} else {
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
-						}
+	for (uint32_t i = 0; i < r_polygons.size();) {
+		if (r_polygons[i].is_empty()) {
+			r_polygons.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+}
 
-						q.bodies.push_back(body);
+// A body, and the shapes to add to it, computed off the main thread.
+struct TileCollisionBodyBuild {
+	struct Shape {
+		RID shape; // Shape owned by the TileSet, or invalid for merged polygons.
+		Vector<Vector2> points;
+		bool one_way_collision = false;
+		float one_way_collision_margin = 0.0;
+	};
+
+	Vector2i coords;
+	int tile_set_physics_layer = 0;
+	Vector2 linear_velocity;
+	real_t angular_velocity = 0.0;
+	LocalVector<Shape> shapes;
+};
 
-						// Add the shapes to the body.
-						int body_shape_index = 0;
+struct TileMap::PhysicsQuadrantBuild {
+	TileMapQuadrant *quadrant = nullptr;
+	LocalVector<TileCollisionBodyBuild> bodies;
+};
+
+void TileMap::_physics_build_quadrant(uint32_t p_index, PhysicsQuadrantBuild *p_builds) {
+	// Runs on worker threads: only read the TileMap, do not touch the servers.
+	PhysicsQuadrantBuild &build = p_builds[p_index];
+	TileMapQuadrant &q = *build.quadrant;
+
+	// The merged collision polygons are expressed relative to the quadrant origin.
+	LocalVector<TileCollisionMergeBody> merge_bodies;
+	Vector2i quadrant_origin_coords = q.coords * get_effective_quadrant_size(q.layer);
+	Vector2 quadrant_origin = map_to_local(quadrant_origin_coords);
+
+	for (const Vector2i &E_cell : q.cells) {
+		TileMapCell c = get_cell(q.layer, E_cell, true);
+
+		TileSetSource *source;
+		if (tile_set->has_source(c.source_id)) {
+			source = *tile_set->get_source(c.source_id);
+
+			if (!source->has_tile(c.get_atlas_coords()) || !source->has_alternative_tile(c.get_atlas_coords(), c.alternative_tile)) {
+				continue;
+			}
+
+			TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(source);
+			if (atlas_source) {
+				const TileData *tile_data;
+				HashMap<Vector2i, TileData *>::ConstIterator E_runtime = q.runtime_tile_data_cache.find(E_cell);
+				if (E_runtime) {
+					tile_data = E_runtime->value;
+				} else {
+					tile_data = atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile);
+				}
+				for (int tile_set_physics_layer = 0; tile_set_physics_layer < tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
+					Vector2 linear_velocity = tile_data->get_constant_linear_velocity(tile_set_physics_layer);
+					real_t angular_velocity = tile_data->get_constant_angular_velocity(tile_set_physics_layer);
+
+					// Tiles rotating around their own center cannot share a body.
+					if (collision_merging_enabled && angular_velocity == 0.0) {
+						TileCollisionMergeBody *merge_body = nullptr;
+						for (TileCollisionMergeBody &E : merge_bodies) {
+							if (E.tile_set_physics_layer == tile_set_physics_layer && E.linear_velocity == linear_velocity) {
+								merge_body = &E;
+								break;
+							}
+						}
+
+						Vector2 cell_offset = map_to_local(E_cell) - quadrant_origin;
 						for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
-							// Iterate over the polygons.
+							int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
+							if (shapes_count == 0) {
+								continue;
+							}
+							if (!merge_body) {
+								merge_bodies.push_back(TileCollisionMergeBody());
+								merge_body = &merge_bodies[merge_bodies.size() - 1];
+								merge_body->tile_set_physics_layer = tile_set_physics_layer;
+								merge_body->linear_velocity = linear_velocity;
+							}
+
 							bool one_way_collision = tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index);
 							float one_way_collision_margin = tile_data->get_collision_polygon_one_way_margin(tile_set_physics_layer, polygon_index);
-							int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
+							TileCollisionMergeGroup *group = nullptr;
+							for (TileCollisionMergeGroup &E : merge_body->groups) {
+								if (E.one_way_collision == one_way_collision && E.one_way_collision_margin == one_way_collision_margin) {
+									group = &E;
+									break;
+								}
+							}
+							if (!group) {
+								merge_body->groups.push_back(TileCollisionMergeGroup());
+								group = &merge_body->groups[merge_body->groups.size() - 1];
+								group->one_way_collision = one_way_collision;
+								group->one_way_collision_margin = one_way_collision_margin;
+							}
+
 							for (int shape_index = 0; shape_index < shapes_count; shape_index++) {
-								// Add decomposed convex shapes.
 								Ref<ConvexPolygonShape2D> shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index);
-								ps->body_add_shape(body, shape->get_rid());
-								ps->body_set_shape_as_one_way_collision(body, body_shape_index, one_way_collision, one_way_collision_margin);
-
-								body_shape_index++;
+								Vector<Vector2> points = shape->get_points();
+								Vector2 *w = points.ptrw();
+								for (int i = 0; i < points.size(); i++) {
+									w[i] += cell_offset;
+								}
+								group->polygons.push_back(points);
 							}
 						}
+						continue;
 					}
+
+					TileCollisionBodyBuild body;
+					body.coords = E_cell;
+					body.tile_set_physics_layer = tile_set_physics_layer;
+					body.linear_velocity = linear_velocity;
+					body.angular_velocity = angular_velocity;
+
+					for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
+						// Iterate over the polygons.
+						bool one_way_collision = tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index);
+						float one_way_collision_margin = tile_data->get_collision_polygon_one_way_margin(tile_set_physics_layer, polygon_index);
+						int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
+						for (int shape_index = 0; shape_index < shapes_count; shape_index++) {
+							// Add decomposed convex shapes.
+							TileCollisionBodyBuild::Shape body_shape;
+							body_shape.shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index)->get_rid();
+							body_shape.one_way_collision = one_way_collision;
+							body_shape.one_way_collision_margin = one_way_collision_margin;
+							body.shapes.push_back(body_shape);
+						}
+					}
+					build.bodies.push_back(body);
 				}
 			}
 		}
+	}
 
-		q_list_element = q_list_element->next();
+	// One body per physics layer for the merged tiles.
+	for (TileCollisionMergeBody &merge_body : merge_bodies) {
+		TileCollisionBodyBuild body;
+		body.coords = quadrant_origin_coords;
+		body.tile_set_physics_layer = merge_body.tile_set_physics_layer;
+		body.linear_velocity = merge_body.linear_velocity;
+
+		for (TileCollisionMergeGroup &group : merge_body.groups) {
+			merge_convex_polygons(group.polygons);
+			for (const Vector<Vector2> &polygon : group.polygons) {
+				TileCollisionBodyBuild::Shape body_shape;
+				body_shape.points = polygon;
+				body_shape.one_way_collision = group.one_way_collision;
+				body_shape.one_way_collision_margin = group.one_way_collision_margin;
+				body.shapes.push_back(body_shape);
+			}
+		}
+		build.bodies.push_back(body);
+	}
+}
+
+void TileMap::_physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r_dirty_quadrant_list) {
+	ERR_FAIL_COND(!is_inside_tree());
+	ERR_FAIL_COND(!tile_set.is_valid());
+
+	Transform2D gl_transform = get_global_transform();
+	last_valid_transform = gl_transform;
+	new_transform = gl_transform;
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+	LocalVector<PhysicsQuadrantBuild> builds;
+	uint32_t dirty_cell_count = 0;
+	for (SelfList<TileMapQuadrant> *q_list_element = r_dirty_quadrant_list.first(); q_list_element; q_list_element = q_list_element->next()) {
+		PhysicsQuadrantBuild build;
+		build.quadrant = q_list_element->self();
+		builds.push_back(build);
+		dirty_cell_count += build.quadrant->cells.size();
+	}
+
+	// Gather the shapes of each quadrant, in parallel when there are enough cells to process.
+	// Merging makes each cell more expensive, so the threshold is lower when it is enabled.
+	uint32_t parallel_cell_min = collision_merging_enabled ? PHYSICS_QUADRANT_PARALLEL_CELL_MIN / 4 : PHYSICS_QUADRANT_PARALLEL_CELL_MIN;
+	if (builds.size() > 1 && dirty_cell_count >= parallel_cell_min) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TileMap::_physics_build_quadrant, builds.ptr(), builds.size(), -1, true, SNAME("TileMapPhysicsQuadrants"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < builds.size(); i++) {
+			_physics_build_quadrant(i, builds.ptr());
+		}
+	}
+
+	// Then commit everything to the physics server from this thread.
+	for (PhysicsQuadrantBuild &build : builds) {
+		TileMapQuadrant &q = *build.quadrant;
+
+		// Clear bodies.
+		for (RID body : q.bodies) {
+			bodies_coords.erase(body);
+			bodies_layers.erase(body);
+			ps->free(body);
+		}
+		q.bodies.clear();
+		for (RID shape : q.merged_shapes) {
+			ps->free(shape);
+		}
+		q.merged_shapes.clear();
+
+		// Recreate bodies and shapes.
+		for (const TileCollisionBodyBuild &body_build : build.bodies) {
+			RID body = _physics_create_body(q, body_build.coords, body_build.tile_set_physics_layer, body_build.linear_velocity, body_build.angular_velocity);
+
+			for (uint32_t body_shape_index = 0; body_shape_index < body_build.shapes.size(); body_shape_index++) {
+				const TileCollisionBodyBuild::Shape &body_shape = body_build.shapes[body_shape_index];
+				RID shape = body_shape.shape;
+				if (!shape.is_valid()) {
+					shape = ps->convex_polygon_shape_create();
+					ps->shape_set_data(shape, body_shape.points);
+					q.merged_shapes.push_back(shape);
+				}
+				ps->body_add_shape(body, shape);
+				ps->body_set_shape_as_one_way_collision(body, body_shape_index, body_shape.one_way_collision, body_shape.one_way_collision_margin);
+			}
+		}
 	}
 }
 
+RID TileMap::_physics_create_body(TileMapQuadrant &p_quadrant, const Vector2i &p_coords, int p_tile_set_physics_layer, const Vector2 &p_linear_velocity, real_t p_angular_velocity) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+	Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(p_tile_set_physics_layer);
+	uint32_t physics_layer = tile_set->get_physics_layer_collision_layer(p_tile_set_physics_layer);
+	uint32_t physics_mask = tile_set->get_physics_layer_collision_mask(p_tile_set_physics_layer);
+
+	RID body = ps->body_create();
+	bodies_coords[body] = p_coords;
+	bodies_layers[body] = p_quadrant.layer;
+	ps->body_set_mode(body, collision_animatable ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
+	ps->body_set_space(body, get_world_2d()->get_space());
+
+	Transform2D xform;
+	xform.set_origin(map_to_local(p_coords));
+	xform = get_global_transform() * xform;
+	ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+
+	ps->body_attach_object_instance_id(body, get_instance_id());
+	ps->body_set_collision_layer(body, physics_layer);
+	ps->body_set_collision_mask(body, physics_mask);
+	ps->body_set_pickable(body, false);
+	ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, p_linear_velocity);
+	ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, p_angular_velocity);
+
+	if (!physics_material.is_valid()) {
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
+	} else {
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
+	}
+
+	p_quadrant.bodies.push_back(body);
+	return body;
+}
+
 void TileMap::_physics_cleanup_quadrant(TileMapQuadrant *p_quadrant) {
 	// Remove a quadrant.
 	ERR_FAIL_NULL(PhysicsServer2D::get_singleton());
@@ -1697,6 +2020,10 @@ void TileMap::_physics_cleanup_quadrant(TileMapQuadrant *p_quadrant) {
 		PhysicsServer2D::get_singleton()->free(body);
 	}
 	p_quadrant->bodies.clear();
+	for (RID shape : p_quadrant->merged_shapes) {
+		PhysicsServer2D::get_singleton()->free(shape);
+	}
+	p_quadrant->merged_shapes.clear();
 }
 
 void TileMap::_physics_draw_quadrant_debug(TileMapQuadrant *p_quadrant) {
@@ -4145,6 +4472,8 @@ void TileMap::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_collision_animatable", "enabled"), &TileMap::set_collision_animatable);
 	ClassDB::bind_method(D_METHOD("is_collision_animatable"), &TileMap::is_collision_animatable);
+	ClassDB::bind_method(D_METHOD("set_collision_merging_enabled", "enabled"), &TileMap::set_collision_merging_enabled);
+	ClassDB::bind_method(D_METHOD("is_collision_merging_enabled"), &TileMap::is_collision_merging_enabled);
 	ClassDB::bind_method(D_METHOD("set_collision_visibility_mode", "collision_visibility_mode"), &TileMap::set_collision_visibility_mode);
 	ClassDB::bind_method(D_METHOD("get_collision_visibility_mode"), &TileMap::get_collision_visibility_mode);
 
@@ -4198,6 +4527,7 @@ void TileMap::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "tile_set", PROPERTY_HINT_RESOURCE_TYPE, "TileSet"), "set_tileset", "get_tileset");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "cell_quadrant_size", PROPERTY_HINT_RANGE, "1,128,1"), "set_quadrant_size", "get_quadrant_size");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_animatable"), "set_collision_animatable", "is_collision_animatable");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_merging_enabled"), "set_collision_merging_enabled", "is_collision_merging_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_visibility_mode", PROPERTY_HINT_ENUM, "Default,Force Show,Force Hide"), "set_collision_visibility_mode", "get_collision_visibility_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "navigation_visibility_mode", PROPERTY_HINT_ENUM, "Default,Force Show,Force Hide"), "set_navigation_visibility_mode", "get_navigation_visibility_mode");
 
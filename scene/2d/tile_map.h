@@ -72,6 +72,7 @@ struct TileMapQuadrant {
 
 	// Physics.
 	List<RID> bodies;
+	List<RID> merged_shapes;
 
 	// Navigation.
 	HashMap<Vector2i, Vector<RID>> navigation_regions;
@@ -89,6 +90,7 @@ struct TileMapQuadrant {
 		canvas_items = q.canvas_items;
 		occluders = q.occluders;
 		bodies = q.bodies;
+		merged_shapes = q.merged_shapes;
 		navigation_regions = q.navigation_regions;
 	}
 
@@ -100,6 +102,7 @@ struct TileMapQuadrant {
 		canvas_items = q.canvas_items;
 		occluders = q.occluders;
 		bodies = q.bodies;
+		merged_shapes = q.merged_shapes;
 		navigation_regions = q.navigation_regions;
 	}
 
@@ -187,6 +190,7 @@ private:
 	Ref<TileSet> tile_set;
 	int quadrant_size = 16;
 	bool collision_animatable = false;
+	bool collision_merging_enabled = false;
 	VisibilityMode collision_visibility_mode = VISIBILITY_MODE_DEFAULT;
 	VisibilityMode navigation_visibility_mode = VISIBILITY_MODE_DEFAULT;
 
@@ -258,7 +262,10 @@ private:
 	Transform2D last_valid_transform;
 	Transform2D new_transform;
 	void _physics_notification(int p_what);
+	struct PhysicsQuadrantBuild;
+	void _physics_build_quadrant(uint32_t p_index, PhysicsQuadrantBuild *p_builds);
 	void _physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r_dirty_quadrant_list);
+	RID _physics_create_body(TileMapQuadrant &p_quadrant, const Vector2i &p_coords, int p_tile_set_physics_layer, const Vector2 &p_linear_velocity, real_t p_angular_velocity);
 	void _physics_cleanup_quadrant(TileMapQuadrant *p_quadrant);
 	void _physics_draw_quadrant_debug(TileMapQuadrant *p_quadrant);
 
@@ -299,6 +306,10 @@ protected:
 public:
 	static Vector2i transform_coords_layout(const Vector2i &p_coords, TileSet::TileOffsetAxis p_offset_axis, TileSet::TileLayout p_from_layout, TileSet::TileLayout p_to_layout);
 
+	// Collision merging helpers, used to join the convex collision polygons of neighboring tiles.
+	static bool merge_convex_polygon_pair(const Vector<Vector2> &p_a, int p_edge, const Vector<Vector2> &p_b, Vector<Vector2> &r_merged);
+	static void merge_convex_polygons(LocalVector<Vector<Vector2>> &r_polygons);
+
 	enum {
 		INVALID_CELL = -1
 	};
@@ -338,6 +349,9 @@ public:
 	void set_collision_animatable(bool p_enabled);
 	bool is_collision_animatable() const;
 
+	void set_collision_merging_enabled(bool p_enabled);
+	bool is_collision_merging_enabled() const;
+
 	// Debug visibility modes.
 	void set_collision_visibility_mode(VisibilityMode p_show_collision);
 	VisibilityMode get_collision_visibility_mode();
@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*  hlod_cluster_3d.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "hlod_cluster_3d.h"
+
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/resources/skin.h"
+#include "scene/resources/surface_tool.h"
+
+RID HLODCluster3D::_get_children_visibility_parent() const {
+	// Without a proxy, there is nothing to swap the members with.
+	if (proxy_mesh.is_null()) {
+		return GeometryInstance3D::_get_children_visibility_parent();
+	}
+	return get_instance();
+}
+
+void HLODCluster3D::_gather_proxy_surfaces(Node *p_node, const Transform3D &p_to_local, HashMap<Ref<Material>, Ref<SurfaceTool>> &r_surfaces) const {
+	Node3D *node_3d = Object::cast_to<Node3D>(p_node);
+	if (node_3d && !node_3d->get_visibility_parent().is_empty()) {
+		// Its children inherit its own visibility parent, so none of them are swapped with the proxy.
+		return;
+	}
+
+	MeshInstance3D *mi = Object::cast_to<MeshInstance3D>(p_node);
+	if (mi && mi->is_visible_in_tree() && mi->get_mesh().is_valid() && mi->get_skin().is_null()) {
+		// Members hidden before the proxy appears would never be seen together with it.
+		float range_end = mi->get_visibility_range_end();
+		bool reaches_proxy = range_end <= 0.0 || range_end > get_visibility_range_begin();
+
+		Ref<Mesh> mesh = mi->get_mesh();
+		Transform3D xform = p_to_local * mi->get_global_transform();
+		for (int i = 0; reaches_proxy && i < mesh->get_surface_count(); i++) {
+			if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+				continue;
+			}
+
+			Ref<Material> material = mi->get_active_material(i);
+			Ref<SurfaceTool> *st = r_surfaces.getptr(material);
+			if (!st) {
+				Ref<SurfaceTool> new_st;
+				new_st.instantiate();
+				new_st->set_material(material);
+				st = &r_surfaces.insert(material, new_st)->value;
+			}
+			if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
+				(*st)->append_from(mesh, i, xform);
+			} else {
+				// The vertices of a surface without indices would not be referenced once merged with indexed ones.
+				Ref<SurfaceTool> indexed_st;
+				indexed_st.instantiate();
+				indexed_st->create_from(mesh, i);
+				indexed_st->index();
+				(*st)->append_from(indexed_st->commit(), 0, xform);
+			}
+		}
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_gather_proxy_surfaces(p_node->get_child(i), p_to_local, r_surfaces);
+	}
+}
+
+void HLODCluster3D::set_proxy_mesh(const Ref<Mesh> &p_mesh) {
+	if (proxy_mesh == p_mesh) {
+		return;
+	}
+
+	proxy_mesh = p_mesh;
+	set_base(proxy_mesh.is_valid() ? proxy_mesh->get_rid() : RID());
+
+	if (is_inside_tree()) {
+		_update_children_visibility_parent();
+	}
+	update_configuration_warnings();
+}
+
+Ref<Mesh> HLODCluster3D::get_proxy_mesh() const {
+	return proxy_mesh;
+}
+
+void HLODCluster3D::bake_proxy_mesh() {
+	ERR_FAIL_COND_MSG(!is_inside_tree(), "HLODCluster3D must be inside the scene tree to bake its proxy mesh.");
+
+	// Merge the surfaces of all descendant meshes, one surface per material.
+	HashMap<Ref<Material>, Ref<SurfaceTool>> surfaces;
+	Transform3D to_local = get_global_transform().affine_inverse();
+	for (int i = 0; i < get_child_count(); i++) {
+		_gather_proxy_surfaces(get_child(i), to_local, surfaces);
+	}
+
+	ERR_FAIL_COND_MSG(surfaces.size() > RS::MAX_MESH_SURFACES, vformat("The members of this HLODCluster3D use %d materials, but a proxy mesh can have at most %d surfaces.", surfaces.size(), RS::MAX_MESH_SURFACES));
+
+	Ref<ArrayMesh> mesh;
+	if (!surfaces.is_empty()) {
+		mesh.instantiate();
+		for (KeyValue<Ref<Material>, Ref<SurfaceTool>> &E : surfaces) {
+			E.value->commit(mesh);
+		}
+	}
+
+	set_proxy_mesh(mesh);
+}
+
+AABB HLODCluster3D::get_aabb() const {
+	if (proxy_mesh.is_valid()) {
+		return proxy_mesh->get_aabb();
+	}
+	return AABB();
+}
+
+PackedStringArray HLODCluster3D::get_configuration_warnings() const {
+	PackedStringArray warnings = GeometryInstance3D::get_configuration_warnings();
+
+	if (proxy_mesh.is_null()) {
+		warnings.push_back(RTR("No proxy mesh is set, so the members of this HLODCluster3D are always drawn individually.\nTo resolve this, call bake_proxy_mesh() or assign a mesh to the Proxy Mesh property."));
+	} else if (get_visibility_range_begin() <= 0.0) {
+		warnings.push_back(RTR("Visibility Range Begin is 0, so the proxy mesh is always drawn and the members of this HLODCluster3D are always hidden.\nTo resolve this, set Visibility Range Begin to the distance from which the proxy should replace the members."));
+	}
+
+	return warnings;
+}
+
+void HLODCluster3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_proxy_mesh", "mesh"), &HLODCluster3D::set_proxy_mesh);
+	ClassDB::bind_method(D_METHOD("get_proxy_mesh"), &HLODCluster3D::get_proxy_mesh);
+	ClassDB::bind_method(D_METHOD("bake_proxy_mesh"), &HLODCluster3D::bake_proxy_mesh);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "proxy_mesh", PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_proxy_mesh", "get_proxy_mesh");
+}
+
+HLODCluster3D::HLODCluster3D() {
+}
@@ -0,0 +1,63 @@
+/**************************************************************************/
+/*  hlod_cluster_3d.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef HLOD_CLUSTER_3D_H
+#define HLOD_CLUSTER_3D_H
+
+#include "scene/3d/visual_instance_3d.h"
+
+class SurfaceTool;
+
+class HLODCluster3D : public GeometryInstance3D {
+	GDCLASS(HLODCluster3D, GeometryInstance3D);
+
+	Ref<Mesh> proxy_mesh;
+
+	void _gather_proxy_surfaces(Node *p_node, const Transform3D &p_to_local, HashMap<Ref<Material>, Ref<SurfaceTool>> &r_surfaces) const;
+
+protected:
+	virtual RID _get_children_visibility_parent() const override;
+
+	static void _bind_methods();
+
+public:
+	void set_proxy_mesh(const Ref<Mesh> &p_mesh);
+	Ref<Mesh> get_proxy_mesh() const;
+
+	void bake_proxy_mesh();
+
+	virtual AABB get_aabb() const override;
+
+	virtual PackedStringArray get_configuration_warnings() const override;
+
+	HLODCluster3D();
+};
+
+#endif // HLOD_CLUSTER_3D_H
@@ -977,7 +977,7 @@ void Node3D::_update_visibility_parent(bool p_update_root) {
 		ERR_FAIL_NULL_MSG(gi, "The visibility parent node must be a GeometryInstance3D, at path: " + visibility_parent_path);
 		new_parent = gi ? gi->get_instance() : RID();
 	} else if (data.parent) {
-		new_parent = data.parent->data.visibility_parent;
+		new_parent = data.parent->_get_children_visibility_parent();
 	}
 
 	if (new_parent == data.visibility_parent) {
@@ -991,6 +991,14 @@ void Node3D::_update_visibility_parent(bool p_update_root) {
 		RS::get_singleton()->instance_set_visibility_parent(vi->get_instance(), data.visibility_parent);
 	}
 
+	_update_children_visibility_parent();
+}
+
+RID Node3D::_get_children_visibility_parent() const {
+	return data.visibility_parent;
+}
+
+void Node3D::_update_children_visibility_parent() {
 	for (Node3D *c : data.children) {
 		c->_update_visibility_parent(false);
 	}
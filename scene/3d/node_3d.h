@@ -147,6 +147,10 @@ private:
 protected:
 	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) { data.ignore_notification = p_ignore; }
 
+	// Visibility parent inherited by the children which don't set their own.
+	virtual RID _get_children_visibility_parent() const;
+	void _update_children_visibility_parent();
+
 	_FORCE_INLINE_ void _update_local_transform() const;
 	_FORCE_INLINE_ void _update_rotation_and_scale() const;
 
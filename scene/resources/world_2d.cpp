@@ -62,6 +62,7 @@ RID World2D::get_navigation_map() const {
 		NavigationServer2D::get_singleton()->map_set_use_edge_connections(navigation_map, GLOBAL_GET("navigation/2d/use_edge_connections"));
 		NavigationServer2D::get_singleton()->map_set_edge_connection_margin(navigation_map, GLOBAL_GET("navigation/2d/default_edge_connection_margin"));
 		NavigationServer2D::get_singleton()->map_set_link_connection_radius(navigation_map, GLOBAL_GET("navigation/2d/default_link_connection_radius"));
+		NavigationServer2D::get_singleton()->map_set_path_cluster_size(navigation_map, GLOBAL_GET("navigation/2d/default_path_cluster_size"));
 	}
 	return navigation_map;
 }
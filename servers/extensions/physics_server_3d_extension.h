@@ -243,6 +243,11 @@ public:
 	EXBIND1RC(Vector<Vector3>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	EXBIND1RC(Vector<uint8_t>, space_get_snapshot, RID)
+	EXBIND2(space_set_snapshot, RID, const Vector<uint8_t> &)
+
+	EXBIND1RC(uint32_t, space_get_state_hash, RID)
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
@@ -377,6 +377,8 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer2D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_set_link_connection_radius", "map", "radius"), &NavigationServer2D::map_set_link_connection_radius);
 	ClassDB::bind_method(D_METHOD("map_get_link_connection_radius", "map"), &NavigationServer2D::map_get_link_connection_radius);
+	ClassDB::bind_method(D_METHOD("map_set_path_cluster_size", "map", "cluster_size"), &NavigationServer2D::map_set_path_cluster_size);
+	ClassDB::bind_method(D_METHOD("map_get_path_cluster_size", "map"), &NavigationServer2D::map_get_path_cluster_size);
 	ClassDB::bind_method(D_METHOD("map_get_path", "map", "origin", "destination", "optimize", "navigation_layers"), &NavigationServer2D::map_get_path, DEFVAL(1));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point", "map", "to_point"), &NavigationServer2D::map_get_closest_point);
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_owner", "map", "to_point"), &NavigationServer2D::map_get_closest_point_owner);
@@ -389,6 +391,9 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_force_update", "map"), &NavigationServer2D::map_force_update);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer2D::query_path);
+	ClassDB::bind_method(D_METHOD("query_path_batch", "parameters", "results", "callback"), &NavigationServer2D::query_path_batch, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("is_path_query_batch_completed", "batch_id"), &NavigationServer2D::is_path_query_batch_completed);
+	ClassDB::bind_method(D_METHOD("wait_for_path_query_batch_completion", "batch_id"), &NavigationServer2D::wait_for_path_query_batch_completion);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer2D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_use_edge_connections", "region", "enabled"), &NavigationServer2D::region_set_use_edge_connections);
@@ -529,6 +534,9 @@ real_t FORWARD_1_C(map_get_edge_connection_margin, RID, p_map, rid_to_rid);
 void FORWARD_2(map_set_link_connection_radius, RID, p_map, real_t, p_connection_radius, rid_to_rid, real_to_real);
 real_t FORWARD_1_C(map_get_link_connection_radius, RID, p_map, rid_to_rid);
 
+void FORWARD_2(map_set_path_cluster_size, RID, p_map, real_t, p_cluster_size, rid_to_rid, real_to_real);
+real_t FORWARD_1_C(map_get_path_cluster_size, RID, p_map, rid_to_rid);
+
 Vector<Vector2> FORWARD_5_R_C(vector_v3_to_v2, map_get_path, RID, p_map, Vector2, p_origin, Vector2, p_destination, bool, p_optimize, uint32_t, p_layers, rid_to_rid, v2_to_v3, v2_to_v3, bool_to_bool, uint32_to_uint32);
 
 Vector2 FORWARD_2_R_C(v3_to_v2, map_get_closest_point, RID, p_map, const Vector2 &, p_point, rid_to_rid, v2_to_v3);
@@ -638,3 +646,45 @@ void NavigationServer2D::query_path(const Ref<NavigationPathQueryParameters2D> &
 	p_query_result->set_path_rids(_query_result.path_rids);
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
+
+class PathQueryBatch2D : public NavigationServer3D::PathQueryBatch {
+public:
+	LocalVector<Ref<NavigationPathQueryResult2D>> results;
+
+	virtual void set_result(uint32_t p_index, const NavigationUtilities::PathQueryResult &p_result) override {
+		const Ref<NavigationPathQueryResult2D> &query_result = results[p_index];
+		query_result->set_path(vector_v3_to_v2(p_result.path));
+		query_result->set_path_types(p_result.path_types);
+		query_result->set_path_rids(p_result.path_rids);
+		query_result->set_path_owner_ids(p_result.path_owner_ids);
+	}
+};
+
+int64_t NavigationServer2D::query_path_batch(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), 0, "The path query batch needs one result object for each parameters object.");
+
+	PathQueryBatch2D *batch = memnew(PathQueryBatch2D);
+	batch->parameters.resize(p_query_parameters.size());
+	batch->results.resize(p_query_results.size());
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters2D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult2D> query_result = p_query_results[i];
+		if (unlikely(query_parameters.is_null() || query_result.is_null())) {
+			memdelete(batch);
+			ERR_FAIL_V_MSG(0, vformat("Invalid path query parameters or result at index %d.", i));
+		}
+		batch->parameters[i] = query_parameters->get_parameters();
+		batch->results[i] = query_result;
+	}
+	batch->callback = p_callback;
+
+	return NavigationServer3D::get_singleton()->_query_path_batch(batch);
+}
+
+bool NavigationServer2D::is_path_query_batch_completed(int64_t p_batch_id) const {
+	return NavigationServer3D::get_singleton()->is_path_query_batch_completed(p_batch_id);
+}
+
+void NavigationServer2D::wait_for_path_query_batch_completion(int64_t p_batch_id) {
+	NavigationServer3D::get_singleton()->wait_for_path_query_batch_completion(p_batch_id);
+}
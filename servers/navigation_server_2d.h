@@ -85,6 +85,12 @@ public:
 	/// Returns the link connection radius of this map.
 	virtual real_t map_get_link_connection_radius(RID p_map) const;
 
+	/// Set the map cell size used to group the polygons for the hierarchical path queries, zero disables them.
+	virtual void map_set_path_cluster_size(RID p_map, real_t p_cluster_size);
+
+	/// Returns the path cluster size of this map.
+	virtual real_t map_get_path_cluster_size(RID p_map) const;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector2> map_get_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const;
 
@@ -259,6 +265,11 @@ public:
 	/// Returns a customized navigation path using a query parameters object
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const;
 
+	/// Runs many path queries in parallel, see `NavigationServer3D::query_path_batch()`.
+	int64_t query_path_batch(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results, const Callable &p_callback = Callable());
+	bool is_path_query_batch_completed(int64_t p_batch_id) const;
+	void wait_for_path_query_batch_completion(int64_t p_batch_id);
+
 	/// Destroy the `RID`
 	virtual void free(RID p_object);
 
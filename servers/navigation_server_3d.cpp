@@ -51,6 +51,8 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer3D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_set_link_connection_radius", "map", "radius"), &NavigationServer3D::map_set_link_connection_radius);
 	ClassDB::bind_method(D_METHOD("map_get_link_connection_radius", "map"), &NavigationServer3D::map_get_link_connection_radius);
+	ClassDB::bind_method(D_METHOD("map_set_path_cluster_size", "map", "cluster_size"), &NavigationServer3D::map_set_path_cluster_size);
+	ClassDB::bind_method(D_METHOD("map_get_path_cluster_size", "map"), &NavigationServer3D::map_get_path_cluster_size);
 	ClassDB::bind_method(D_METHOD("map_get_path", "map", "origin", "destination", "optimize", "navigation_layers"), &NavigationServer3D::map_get_path, DEFVAL(1));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_to_segment", "map", "start", "end", "use_collision"), &NavigationServer3D::map_get_closest_point_to_segment, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point", "map", "to_point"), &NavigationServer3D::map_get_closest_point);
@@ -65,6 +67,9 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_force_update", "map"), &NavigationServer3D::map_force_update);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_path_batch", "parameters", "results", "callback"), &NavigationServer3D::query_path_batch, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("is_path_query_batch_completed", "batch_id"), &NavigationServer3D::is_path_query_batch_completed);
+	ClassDB::bind_method(D_METHOD("wait_for_path_query_batch_completion", "batch_id"), &NavigationServer3D::wait_for_path_query_batch_completion);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_use_edge_connections", "region", "enabled"), &NavigationServer3D::region_set_use_edge_connections);
@@ -187,12 +192,14 @@ NavigationServer3D::NavigationServer3D() {
 	GLOBAL_DEF("navigation/2d/use_edge_connections", true);
 	GLOBAL_DEF_BASIC("navigation/2d/default_edge_connection_margin", 1);
 	GLOBAL_DEF_BASIC("navigation/2d/default_link_connection_radius", 4);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "navigation/2d/default_path_cluster_size", PROPERTY_HINT_RANGE, "0,10000,1,or_greater,suffix:px"), 0.0);
 
 	GLOBAL_DEF_BASIC("navigation/3d/default_cell_size", 0.25);
 	GLOBAL_DEF_BASIC("navigation/3d/default_cell_height", 0.25);
 	GLOBAL_DEF("navigation/3d/use_edge_connections", true);
 	GLOBAL_DEF_BASIC("navigation/3d/default_edge_connection_margin", 0.25);
 	GLOBAL_DEF_BASIC("navigation/3d/default_link_connection_radius", 1.0);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "navigation/3d/default_path_cluster_size", PROPERTY_HINT_RANGE, "0,1000,0.1,or_greater,suffix:m"), 0.0);
 
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_high_priority_threads", true);
@@ -875,6 +882,149 @@ void NavigationServer3D::query_path(const Ref<NavigationPathQueryParameters3D> &
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+class PathQueryBatch3D : public NavigationServer3D::PathQueryBatch {
+public:
+	LocalVector<Ref<NavigationPathQueryResult3D>> results;
+
+	virtual void set_result(uint32_t p_index, const NavigationUtilities::PathQueryResult &p_result) override {
+		const Ref<NavigationPathQueryResult3D> &query_result = results[p_index];
+		query_result->set_path(p_result.path);
+		query_result->set_path_types(p_result.path_types);
+		query_result->set_path_rids(p_result.path_rids);
+		query_result->set_path_owner_ids(p_result.path_owner_ids);
+	}
+};
+
+int64_t NavigationServer3D::query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), 0, "The path query batch needs one result object for each parameters object.");
+
+	PathQueryBatch3D *batch = memnew(PathQueryBatch3D);
+	batch->parameters.resize(p_query_parameters.size());
+	batch->results.resize(p_query_results.size());
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		if (unlikely(query_parameters.is_null() || query_result.is_null())) {
+			memdelete(batch);
+			ERR_FAIL_V_MSG(0, vformat("Invalid path query parameters or result at index %d.", i));
+		}
+		batch->parameters[i] = query_parameters->get_parameters();
+		batch->results[i] = query_result;
+	}
+	batch->callback = p_callback;
+
+	return _query_path_batch(batch);
+}
+
+int64_t NavigationServer3D::_query_path_batch(PathQueryBatch *p_batch) {
+	ERR_FAIL_NULL_V(p_batch, 0);
+
+	MutexLock lock(path_query_batches_mutex);
+
+	p_batch->id = ++last_path_query_batch_id;
+	p_batch->pending_queries.set(p_batch->parameters.size());
+
+	if (p_batch->parameters.is_empty()) {
+		// Nothing to solve, still report it the same way.
+		const int64_t batch_id = p_batch->id;
+		if (p_batch->callback.is_valid()) {
+			p_batch->callback.call_deferred(batch_id);
+		}
+		memdelete(p_batch);
+		return batch_id;
+	}
+
+	path_query_batches.insert(p_batch->id, p_batch);
+	p_batch->group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationServer3D::_path_query_batch_task, p_batch, p_batch->parameters.size(), -1, false, SNAME("NavigationPathQueryBatch"));
+
+	return p_batch->id;
+}
+
+void NavigationServer3D::_path_query_batch_task(uint32_t p_index, PathQueryBatch *p_batch) {
+	p_batch->set_result(p_index, _query_path(p_batch->parameters[p_index]));
+
+	const int64_t batch_id = p_batch->id;
+	if (p_batch->pending_queries.decrement() == 0) {
+		// Last query of the batch, report it from the main thread.
+		callable_mp(this, &NavigationServer3D::_path_query_batch_completed).call_deferred(batch_id);
+	}
+}
+
+void NavigationServer3D::_path_query_batch_completed(int64_t p_batch_id) {
+	PathQueryBatch *batch = nullptr;
+	{
+		MutexLock lock(path_query_batches_mutex);
+		HashMap<int64_t, PathQueryBatch *>::Iterator E = path_query_batches.find(p_batch_id);
+		if (!E) {
+			// Already finished by a wait.
+			return;
+		}
+		batch = E->value;
+		path_query_batches.remove(E);
+	}
+
+	_finish_path_query_batch(batch);
+}
+
+void NavigationServer3D::_finish_path_query_batch(PathQueryBatch *p_batch) {
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(p_batch->group_id);
+
+	if (p_batch->callback.is_valid()) {
+		Variant batch_id = p_batch->id;
+		const Variant *args[1] = { &batch_id };
+		Variant return_value;
+		Callable::CallError call_error;
+		p_batch->callback.callp(args, 1, return_value, call_error);
+		if (call_error.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling the path query batch callback: " + Variant::get_callable_error_text(p_batch->callback, args, 1, call_error));
+		}
+	}
+
+	memdelete(p_batch);
+}
+
+bool NavigationServer3D::is_path_query_batch_completed(int64_t p_batch_id) const {
+	MutexLock lock(path_query_batches_mutex);
+	HashMap<int64_t, PathQueryBatch *>::ConstIterator E = path_query_batches.find(p_batch_id);
+	if (!E) {
+		return true;
+	}
+	return E->value->pending_queries.get() == 0;
+}
+
+void NavigationServer3D::wait_for_path_query_batch_completion(int64_t p_batch_id) {
+	PathQueryBatch *batch = nullptr;
+	{
+		MutexLock lock(path_query_batches_mutex);
+		HashMap<int64_t, PathQueryBatch *>::Iterator E = path_query_batches.find(p_batch_id);
+		if (!E) {
+			return;
+		}
+		batch = E->value;
+		path_query_batches.remove(E);
+	}
+
+	_finish_path_query_batch(batch);
+}
+
+void NavigationServer3D::_finish_path_query_batches() {
+	LocalVector<PathQueryBatch *> batches;
+	{
+		MutexLock lock(path_query_batches_mutex);
+		if (path_query_batches.is_empty()) {
+			return;
+		}
+		for (const KeyValue<int64_t, PathQueryBatch *> &E : path_query_batches) {
+			batches.push_back(E.value);
+		}
+		path_query_batches.clear();
+	}
+
+	for (PathQueryBatch *batch : batches) {
+		_finish_path_query_batch(batch);
+	}
+}
+
 ///////////////////////////////////////////////////////
 
 NavigationServer3DCallback NavigationServer3DManager::create_callback = nullptr;
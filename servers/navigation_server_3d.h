@@ -32,7 +32,10 @@
 #define NAVIGATION_SERVER_3D_H
 
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/rid.h"
+#include "core/templates/safe_refcount.h"
 
 #include "scene/3d/navigation_region_3d.h"
 #include "scene/resources/navigation_mesh_source_geometry_data_3d.h"
@@ -99,6 +102,12 @@ public:
 	/// Returns the link connection radius of this map.
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	/// Set the map cell size used to group the polygons for the hierarchical path queries, zero disables them.
+	virtual void map_set_path_cluster_size(RID p_map, real_t p_cluster_size) = 0;
+
+	/// Returns the path cluster size of this map.
+	virtual real_t map_get_path_cluster_size(RID p_map) const = 0;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
@@ -299,6 +308,32 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Runs many path queries in parallel on the WorkerThreadPool. Each query sees the map as it was
+	/// after its last synchronization, a batch may span several navigation frames. Returns the id of
+	/// the batch, the callback receives it once all the results are written.
+	int64_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable());
+	bool is_path_query_batch_completed(int64_t p_batch_id) const;
+	void wait_for_path_query_batch_completion(int64_t p_batch_id);
+
+	/// Path queries solved together, each result is written by the thread that solved it.
+	class PathQueryBatch {
+		friend class NavigationServer3D;
+
+		int64_t id = 0;
+		WorkerThreadPool::GroupID group_id = -1;
+		SafeNumeric<uint32_t> pending_queries;
+
+	public:
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		Callable callback;
+
+		virtual void set_result(uint32_t p_index, const NavigationUtilities::PathQueryResult &p_result) = 0;
+		virtual ~PathQueryBatch() {}
+	};
+
+	/// Starts solving the batch, the server takes ownership of it.
+	int64_t _query_path_batch(PathQueryBatch *p_batch);
+
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 
@@ -322,7 +357,19 @@ public:
 	void set_debug_enabled(bool p_enabled);
 	bool get_debug_enabled() const;
 
+protected:
+	/// Waits for the running path query batches, needs to be called before the server is destroyed.
+	void _finish_path_query_batches();
+
 private:
+	mutable Mutex path_query_batches_mutex;
+	HashMap<int64_t, PathQueryBatch *> path_query_batches;
+	int64_t last_path_query_batch_id = 0;
+
+	void _path_query_batch_task(uint32_t p_index, PathQueryBatch *p_batch);
+	void _path_query_batch_completed(int64_t p_batch_id);
+	void _finish_path_query_batch(PathQueryBatch *p_batch);
+
 	bool debug_enabled = false;
 
 #ifdef DEBUG_ENABLED
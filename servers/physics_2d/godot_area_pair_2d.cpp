@@ -31,6 +31,12 @@
 #include "godot_area_pair_2d.h"
 #include "godot_collision_solver_2d.h"
 
+bool GodotAreaPair2D::_has_space_override() const {
+	return (int)area->get_param(PhysicsServer2D::AREA_PARAM_GRAVITY_OVERRIDE_MODE) != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED ||
+			(int)area->get_param(PhysicsServer2D::AREA_PARAM_LINEAR_DAMP_OVERRIDE_MODE) != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED ||
+			(int)area->get_param(PhysicsServer2D::AREA_PARAM_ANGULAR_DAMP_OVERRIDE_MODE) != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED;
+}
+
 bool GodotAreaPair2D::setup(real_t p_step) {
 	bool result = false;
 	if (area->collides_with(body) && GodotCollisionSolver2D::solve(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), Vector2(), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), Vector2(), nullptr, this)) {
@@ -40,13 +46,7 @@ bool GodotAreaPair2D::setup(real_t p_step) {
 	process_collision = false;
 	has_space_override = false;
 	if (result != colliding) {
-		if ((int)area->get_param(PhysicsServer2D::AREA_PARAM_GRAVITY_OVERRIDE_MODE) != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED) {
-			has_space_override = true;
-		} else if ((int)area->get_param(PhysicsServer2D::AREA_PARAM_LINEAR_DAMP_OVERRIDE_MODE) != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED) {
-			has_space_override = true;
-		} else if ((int)area->get_param(PhysicsServer2D::AREA_PARAM_ANGULAR_DAMP_OVERRIDE_MODE) != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED) {
-			has_space_override = true;
-		}
+		has_space_override = _has_space_override();
 		process_collision = has_space_override;
 
 		if (area->has_monitor_callback()) {
@@ -89,6 +89,55 @@ void GodotAreaPair2D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+void GodotAreaPair2D::_set_colliding(bool p_colliding) {
+	if (colliding == p_colliding) {
+		return;
+	}
+
+	// Same as a change detected in setup() and applied in pre_solve().
+	colliding = p_colliding;
+	has_space_override = _has_space_override();
+	if (colliding) {
+		if (has_space_override) {
+			body->add_area(area);
+		}
+
+		if (area->has_monitor_callback()) {
+			area->add_body_to_query(body, body_shape, area_shape);
+		}
+	} else {
+		if (has_space_override) {
+			body->remove_area(area);
+		}
+
+		if (area->has_monitor_callback()) {
+			area->remove_body_from_query(body, body_shape, area_shape);
+		}
+	}
+}
+
+bool GodotAreaPair2D::get_snapshot_pair(const GodotCollisionObject2D *&r_object_A, int &r_shape_A, const GodotCollisionObject2D *&r_object_B, int &r_shape_B) const {
+	r_object_A = body;
+	r_shape_A = body_shape;
+	r_object_B = area;
+	r_shape_B = area_shape;
+	return true;
+}
+
+void GodotAreaPair2D::save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const {
+	r_buffer->put_u8(colliding);
+}
+
+bool GodotAreaPair2D::load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) {
+	ERR_FAIL_COND_V(p_size != 1, false);
+	_set_colliding(p_buffer->get_u8() != 0);
+	return true;
+}
+
+void GodotAreaPair2D::reset_snapshot_state() {
+	_set_colliding(false);
+}
+
 GodotAreaPair2D::GodotAreaPair2D(GodotBody2D *p_body, int p_body_shape, GodotArea2D *p_area, int p_area_shape) {
 	body = p_body;
 	area = p_area;
@@ -171,6 +220,56 @@ void GodotArea2Pair2D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+void GodotArea2Pair2D::_set_colliding(bool p_colliding_a, bool p_colliding_b) {
+	// Same as a change detected in setup() and applied in pre_solve().
+	if (colliding_a != p_colliding_a) {
+		colliding_a = p_colliding_a;
+		if (area_a->has_area_monitor_callback() && area_b_monitorable) {
+			if (colliding_a) {
+				area_a->add_area_to_query(area_b, shape_b, shape_a);
+			} else {
+				area_a->remove_area_from_query(area_b, shape_b, shape_a);
+			}
+		}
+	}
+
+	if (colliding_b != p_colliding_b) {
+		colliding_b = p_colliding_b;
+		if (area_b->has_area_monitor_callback() && area_a_monitorable) {
+			if (colliding_b) {
+				area_b->add_area_to_query(area_a, shape_a, shape_b);
+			} else {
+				area_b->remove_area_from_query(area_a, shape_a, shape_b);
+			}
+		}
+	}
+}
+
+bool GodotArea2Pair2D::get_snapshot_pair(const GodotCollisionObject2D *&r_object_A, int &r_shape_A, const GodotCollisionObject2D *&r_object_B, int &r_shape_B) const {
+	r_object_A = area_a;
+	r_shape_A = shape_a;
+	r_object_B = area_b;
+	r_shape_B = shape_b;
+	return true;
+}
+
+void GodotArea2Pair2D::save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const {
+	r_buffer->put_u8(p_swapped ? colliding_b : colliding_a);
+	r_buffer->put_u8(p_swapped ? colliding_a : colliding_b);
+}
+
+bool GodotArea2Pair2D::load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) {
+	ERR_FAIL_COND_V(p_size != 2, false);
+	const bool colliding_1 = p_buffer->get_u8() != 0;
+	const bool colliding_2 = p_buffer->get_u8() != 0;
+	_set_colliding(p_swapped ? colliding_2 : colliding_1, p_swapped ? colliding_1 : colliding_2);
+	return true;
+}
+
+void GodotArea2Pair2D::reset_snapshot_state() {
+	_set_colliding(false, false);
+}
+
 GodotArea2Pair2D::GodotArea2Pair2D(GodotArea2D *p_area_a, int p_shape_a, GodotArea2D *p_area_b, int p_shape_b) {
 	area_a = p_area_a;
 	area_b = p_area_b;
@@ -44,11 +44,19 @@ class GodotAreaPair2D : public GodotConstraint2D {
 	bool has_space_override = false;
 	bool process_collision = false;
 
+	bool _has_space_override() const;
+	void _set_colliding(bool p_colliding);
+
 public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool get_snapshot_pair(const GodotCollisionObject2D *&r_object_A, int &r_shape_A, const GodotCollisionObject2D *&r_object_B, int &r_shape_B) const override;
+	virtual void save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const override;
+	virtual bool load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) override;
+	virtual void reset_snapshot_state() override;
+
 	GodotAreaPair2D(GodotBody2D *p_body, int p_body_shape, GodotArea2D *p_area, int p_area_shape);
 	~GodotAreaPair2D();
 };
@@ -65,11 +73,18 @@ class GodotArea2Pair2D : public GodotConstraint2D {
 	bool area_a_monitorable;
 	bool area_b_monitorable;
 
+	void _set_colliding(bool p_colliding_a, bool p_colliding_b);
+
 public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool get_snapshot_pair(const GodotCollisionObject2D *&r_object_A, int &r_shape_A, const GodotCollisionObject2D *&r_object_B, int &r_shape_B) const override;
+	virtual void save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const override;
+	virtual bool load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) override;
+	virtual void reset_snapshot_state() override;
+
 	GodotArea2Pair2D(GodotArea2D *p_area_a, int p_shape_a, GodotArea2D *p_area_b, int p_shape_b);
 	~GodotArea2Pair2D();
 };
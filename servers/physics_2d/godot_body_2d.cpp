@@ -366,6 +366,43 @@ void GodotBody2D::set_state(PhysicsServer2D::BodyState p_state, const Variant &p
 	}
 }
 
+void GodotBody2D::save_snapshot(StreamPeerBuffer *r_buffer) const {
+	GodotSnapshot2D::put_transform(r_buffer, get_transform());
+	GodotSnapshot2D::put_transform(r_buffer, get_inv_transform());
+	GodotSnapshot2D::put_transform(r_buffer, new_transform);
+	GodotSnapshot2D::put_vector2(r_buffer, linear_velocity);
+	GodotSnapshot2D::put_real(r_buffer, angular_velocity);
+	GodotSnapshot2D::put_vector2(r_buffer, prev_linear_velocity);
+	GodotSnapshot2D::put_real(r_buffer, prev_angular_velocity);
+	GodotSnapshot2D::put_vector2(r_buffer, applied_force);
+	GodotSnapshot2D::put_real(r_buffer, applied_torque);
+	GodotSnapshot2D::put_vector2(r_buffer, constant_force);
+	GodotSnapshot2D::put_real(r_buffer, constant_torque);
+	GodotSnapshot2D::put_real(r_buffer, still_time);
+	r_buffer->put_u8(active);
+}
+
+void GodotBody2D::load_snapshot(StreamPeerBuffer *p_buffer) {
+	const Transform2D transform = GodotSnapshot2D::get_transform(p_buffer);
+	const Transform2D inv_transform = GodotSnapshot2D::get_transform(p_buffer);
+	if (get_transform() != transform) {
+		_set_transform(transform);
+		_set_inv_transform(inv_transform);
+		_update_transform_dependent();
+	}
+	new_transform = GodotSnapshot2D::get_transform(p_buffer);
+	linear_velocity = GodotSnapshot2D::get_vector2(p_buffer);
+	angular_velocity = GodotSnapshot2D::get_real(p_buffer);
+	prev_linear_velocity = GodotSnapshot2D::get_vector2(p_buffer);
+	prev_angular_velocity = GodotSnapshot2D::get_real(p_buffer);
+	applied_force = GodotSnapshot2D::get_vector2(p_buffer);
+	applied_torque = GodotSnapshot2D::get_real(p_buffer);
+	constant_force = GodotSnapshot2D::get_vector2(p_buffer);
+	constant_torque = GodotSnapshot2D::get_real(p_buffer);
+	still_time = GodotSnapshot2D::get_real(p_buffer);
+	set_active(p_buffer->get_u8() != 0);
+}
+
 Variant GodotBody2D::get_state(PhysicsServer2D::BodyState p_state) const {
 	switch (p_state) {
 		case PhysicsServer2D::BODY_STATE_TRANSFORM: {
@@ -640,7 +677,13 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	Transform2D new_xform(angle, pos);
+	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED && get_space()->get_ccd_max_substeps() > 1) {
+		// Move through the space in sub-steps, so the body stops at what it hits instead of going through it.
+		new_xform = get_space()->substep_body_motion(this, new_xform);
+	}
+
+	_set_transform(new_xform, continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
@@ -33,6 +33,7 @@
 
 #include "godot_area_2d.h"
 #include "godot_collision_object_2d.h"
+#include "godot_snapshot_2d.h"
 
 #include "core/templates/list.h"
 #include "core/templates/pair.h"
@@ -300,6 +301,11 @@ public:
 	void set_state(PhysicsServer2D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer2D::BodyState p_state) const;
 
+	// Simulated state, saved in space snapshots.
+	static const uint32_t SNAPSHOT_SIZE = 3 * GodotSnapshot2D::TRANSFORM_SIZE + 4 * GodotSnapshot2D::VECTOR2_SIZE + 5 * GodotSnapshot2D::REAL_SIZE + 1;
+	void save_snapshot(StreamPeerBuffer *r_buffer) const;
+	void load_snapshot(StreamPeerBuffer *p_buffer);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection_mode(PhysicsServer2D::CCDMode p_mode) { continuous_cd_mode = p_mode; }
 	_FORCE_INLINE_ PhysicsServer2D::CCDMode get_continuous_collision_detection_mode() const { return continuous_cd_mode; }
 
@@ -84,6 +84,10 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	bool oneway_disabled = false;
 	bool report_contacts_only = false;
 
+	// Size of the saved state before the contacts, and of each contact.
+	static const uint32_t SNAPSHOT_STATE_SIZE = GodotSnapshot2D::VECTOR2_SIZE + 2 + 4;
+	static const uint32_t SNAPSHOT_CONTACT_SIZE = 4 * GodotSnapshot2D::VECTOR2_SIZE + 4 * GodotSnapshot2D::REAL_SIZE + 1;
+
 	bool _test_ccd(real_t p_step, GodotBody2D *p_A, int p_shape_A, const Transform2D &p_xform_A, GodotBody2D *p_B, int p_shape_B, const Transform2D &p_xform_B);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
@@ -94,6 +98,11 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool get_snapshot_pair(const GodotCollisionObject2D *&r_object_A, int &r_shape_A, const GodotCollisionObject2D *&r_object_B, int &r_shape_B) const override;
+	virtual void save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const override;
+	virtual bool load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) override;
+	virtual void reset_snapshot_state() override;
+
 	GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B);
 	~GodotBodyPair2D();
 };
@@ -64,6 +64,16 @@ public:
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// State kept from one step to the next (e.g. cached contacts or overlaps), saved in space snapshots.
+	// Collision pairs return their two objects and shapes, they are matched by RIDs and shape indices and
+	// their state is saved with the object with the lowest RID first, so it can be restored into a pair that
+	// was created the other way around (`p_swapped`). Other constraints with a state are matched by their RID.
+	virtual bool get_snapshot_pair(const GodotCollisionObject2D *&r_object_A, int &r_shape_A, const GodotCollisionObject2D *&r_object_B, int &r_shape_B) const { return false; }
+	virtual bool has_snapshot_state() const { return false; }
+	virtual void save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const {}
+	virtual bool load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) { return false; }
+	virtual void reset_snapshot_state() {}
+
 	virtual ~GodotConstraint2D() {}
 };
 
@@ -197,6 +197,20 @@ void GodotPinJoint2D::solve(real_t p_step) {
 	P += impulse;
 }
 
+void GodotPinJoint2D::save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const {
+	GodotSnapshot2D::put_vector2(r_buffer, P);
+}
+
+bool GodotPinJoint2D::load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) {
+	ERR_FAIL_COND_V(p_size != GodotSnapshot2D::VECTOR2_SIZE, false);
+	P = GodotSnapshot2D::get_vector2(p_buffer);
+	return true;
+}
+
+void GodotPinJoint2D::reset_snapshot_state() {
+	P = Vector2();
+}
+
 void GodotPinJoint2D::set_param(PhysicsServer2D::PinJointParam p_param, real_t p_value) {
 	if (p_param == PhysicsServer2D::PIN_JOINT_SOFTNESS) {
 		softness = p_value;
@@ -365,6 +379,20 @@ void GodotGrooveJoint2D::solve(real_t p_step) {
 	}
 }
 
+void GodotGrooveJoint2D::save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const {
+	GodotSnapshot2D::put_vector2(r_buffer, jn_acc);
+}
+
+bool GodotGrooveJoint2D::load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) {
+	ERR_FAIL_COND_V(p_size != GodotSnapshot2D::VECTOR2_SIZE, false);
+	jn_acc = GodotSnapshot2D::get_vector2(p_buffer);
+	return true;
+}
+
+void GodotGrooveJoint2D::reset_snapshot_state() {
+	jn_acc = Vector2();
+}
+
 GodotGrooveJoint2D::GodotGrooveJoint2D(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, GodotBody2D *p_body_a, GodotBody2D *p_body_b) :
 		GodotJoint2D(_arr, 2) {
 	A = p_body_a;
@@ -98,6 +98,11 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool has_snapshot_state() const override { return true; }
+	virtual void save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const override;
+	virtual bool load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) override;
+	virtual void reset_snapshot_state() override;
+
 	void set_param(PhysicsServer2D::PinJointParam p_param, real_t p_value);
 	real_t get_param(PhysicsServer2D::PinJointParam p_param) const;
 
@@ -135,6 +140,11 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool has_snapshot_state() const override { return true; }
+	virtual void save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const override;
+	virtual bool load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) override;
+	virtual void reset_snapshot_state() override;
+
 	GodotGrooveJoint2D(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, GodotBody2D *p_body_a, GodotBody2D *p_body_b);
 };
 
@@ -276,6 +276,18 @@ int GodotPhysicsServer2D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer2D::space_get_snapshot(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	return space->get_snapshot();
+}
+
+void GodotPhysicsServer2D::space_set_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND(!space);
+	space->set_snapshot(p_snapshot);
+}
+
 PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_space) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_COND_V(!space, nullptr);
@@ -1279,11 +1291,41 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	constraint_count = 0;
+	largest_island_size = 0;
+	for (int i = 0; i < GodotSpace2D::ISLAND_SIZE_MAX; i++) {
+		island_size_count[i] = 0;
+	}
+	for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+		elapsed_time[i] = 0;
+	}
+	solve_iteration_time = 0;
+	for (uint64_t &time : thread_solve_time) {
+		time = 0;
+	}
+
 	for (const GodotSpace2D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace2D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		constraint_count += E->get_constraint_count();
+		largest_island_size = MAX(largest_island_size, E->get_largest_island_size());
+		for (int i = 0; i < GodotSpace2D::ISLAND_SIZE_MAX; i++) {
+			island_size_count[i] += E->get_island_size_count(GodotSpace2D::IslandSize(i));
+		}
+		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+			elapsed_time[i] += E->get_elapsed_time(GodotSpace2D::ElapsedTime(i));
+		}
+		solve_iteration_time += E->get_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS) / MAX(E->get_solver_iterations(), 1);
+
+		const LocalVector<uint64_t> &space_thread_solve_time = E->get_thread_solve_time();
+		if (thread_solve_time.size() < space_thread_solve_time.size()) {
+			thread_solve_time.resize(space_thread_solve_time.size());
+		}
+		for (uint32_t i = 0; i < space_thread_solve_time.size(); i++) {
+			thread_solve_time[i] += space_thread_solve_time[i];
+		}
 	}
 }
 
@@ -1308,30 +1350,27 @@ void GodotPhysicsServer2D::flush_queries() {
 	flushing_queries = false;
 
 	if (EngineDebugger::is_profiling("servers")) {
-		uint64_t total_time[GodotSpace2D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace2D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"update_broadphase",
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
 			"integrate_velocities"
 		};
 
-		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
-			total_time[i] = 0;
-		}
-
-		for (const GodotSpace2D *E : active_spaces) {
-			for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
-				total_time[i] += E->get_elapsed_time(GodotSpace2D::ElapsedTime(i));
-			}
-		}
-
 		Array values;
 		values.resize(GodotSpace2D::ELAPSED_TIME_MAX * 2);
 		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
 			values[i * 2 + 0] = time_name[i];
-			values[i * 2 + 1] = USEC_TO_SEC(total_time[i]);
+			values[i * 2 + 1] = USEC_TO_SEC(elapsed_time[i]);
+		}
+		values.push_back("solve_iteration");
+		values.push_back(USEC_TO_SEC(solve_iteration_time));
+		for (uint32_t i = 0; i < thread_solve_time.size(); i++) {
+			// The first entry is the thread running the step, the others are the worker threads.
+			values.push_back(i == 0 ? String("solve_step_thread") : vformat("solve_worker_thread_%d", i - 1));
+			values.push_back(USEC_TO_SEC(thread_solve_time[i]));
 		}
 		values.push_back("flush_queries");
 		values.push_back(USEC_TO_SEC(OS::get_singleton()->get_ticks_usec() - time_beg));
@@ -1367,6 +1406,49 @@ int GodotPhysicsServer2D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_CONSTRAINT_COUNT: {
+			return constraint_count;
+		} break;
+		case INFO_LARGEST_ISLAND_SIZE: {
+			return largest_island_size;
+		} break;
+		case INFO_SMALL_ISLAND_COUNT: {
+			return island_size_count[GodotSpace2D::ISLAND_SIZE_SMALL];
+		} break;
+		case INFO_MEDIUM_ISLAND_COUNT: {
+			return island_size_count[GodotSpace2D::ISLAND_SIZE_MEDIUM];
+		} break;
+		case INFO_LARGE_ISLAND_COUNT: {
+			return island_size_count[GodotSpace2D::ISLAND_SIZE_LARGE];
+		} break;
+		case INFO_STEP_TIME: {
+			uint64_t step_time = 0;
+			for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+				step_time += elapsed_time[i];
+			}
+			return (int)step_time;
+		} break;
+		case INFO_INTEGRATE_FORCES_TIME: {
+			return (int)elapsed_time[GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES];
+		} break;
+		case INFO_UPDATE_BROADPHASE_TIME: {
+			return (int)elapsed_time[GodotSpace2D::ELAPSED_TIME_UPDATE_BROADPHASE];
+		} break;
+		case INFO_GENERATE_ISLANDS_TIME: {
+			return (int)elapsed_time[GodotSpace2D::ELAPSED_TIME_GENERATE_ISLANDS];
+		} break;
+		case INFO_SETUP_CONSTRAINTS_TIME: {
+			return (int)elapsed_time[GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS];
+		} break;
+		case INFO_SOLVE_CONSTRAINTS_TIME: {
+			return (int)elapsed_time[GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS];
+		} break;
+		case INFO_INTEGRATE_VELOCITIES_TIME: {
+			return (int)elapsed_time[GodotSpace2D::ELAPSED_TIME_INTEGRATE_VELOCITIES];
+		} break;
+		case INFO_SOLVE_ITERATION_TIME: {
+			return (int)solve_iteration_time;
+		} break;
 	}
 
 	return 0;
@@ -50,6 +50,12 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int constraint_count = 0;
+	int largest_island_size = 0;
+	int island_size_count[GodotSpace2D::ISLAND_SIZE_MAX] = {};
+	uint64_t elapsed_time[GodotSpace2D::ELAPSED_TIME_MAX] = {};
+	uint64_t solve_iteration_time = 0;
+	LocalVector<uint64_t> thread_solve_time;
 
 	bool using_threads = false;
 
@@ -116,6 +122,9 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const override;
+	virtual void space_set_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
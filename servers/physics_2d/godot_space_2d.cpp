@@ -532,6 +532,171 @@ int GodotSpace2D::_cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb)
 	return amount;
 }
 
+int GodotSpace2D::_cull_aabb_for_ccd(GodotBody2D *p_body, const Rect2 &p_aabb) {
+	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+
+	for (int i = 0; i < amount; i++) {
+		bool keep = true;
+
+		if (intersection_query_results[i] == p_body) {
+			keep = false;
+		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject2D::TYPE_AREA) {
+			keep = false;
+		} else {
+			// Same filter as GodotBodyPair2D::setup, the body must not go through anything it would be in contact with,
+			// including bodies that only collide with it from their own mask.
+			GodotBody2D *other = static_cast<GodotBody2D *>(intersection_query_results[i]);
+			if (!p_body->interacts_with(other) || other->has_exception(p_body->get_self()) || p_body->has_exception(other->get_self())) {
+				keep = false;
+			} else {
+				bool collide_body = p_body->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC && p_body->collides_with(other);
+				bool collide_other = other->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC && other->collides_with(p_body);
+				keep = collide_body || collide_other;
+			}
+		}
+
+		if (!keep) {
+			if (i < amount - 1) {
+				SWAP(intersection_query_results[i], intersection_query_results[amount - 1]);
+				SWAP(intersection_query_subindex_results[i], intersection_query_subindex_results[amount - 1]);
+			}
+
+			amount--;
+			i--;
+		}
+	}
+
+	return amount;
+}
+
+bool GodotSpace2D::_ccd_collides(GodotBody2D *p_body, const Transform2D &p_transform, int p_result_index, const Vector2 &p_motion_normal) const {
+	const GodotCollisionObject2D *col_obj = intersection_query_results[p_result_index];
+	int shape_idx = intersection_query_subindex_results[p_result_index];
+	Transform2D col_obj_shape_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+
+	for (int i = 0; i < p_body->get_shape_count(); i++) {
+		if (p_body->is_shape_disabled(i)) {
+			continue;
+		}
+
+		GodotShape2D *body_shape = p_body->get_shape(i);
+
+		// Same rule as GodotBodyPair2D for one-way collisions, only collide when moving against the one-way direction.
+		if (body_shape->allows_one_way_collision() && col_obj->is_shape_set_as_one_way_collision(shape_idx)) {
+			if (col_obj_shape_xform.columns[1].normalized().dot(p_motion_normal) < CMP_EPSILON) {
+				continue;
+			}
+		}
+
+		if (GodotCollisionSolver2D::solve(body_shape, p_transform * p_body->get_shape_transform(i), Vector2(), col_obj->get_shape(shape_idx), col_obj_shape_xform, Vector2(), nullptr, nullptr)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+Transform2D GodotSpace2D::substep_body_motion(GodotBody2D *p_body, const Transform2D &p_to) {
+	const Transform2D from = p_body->get_transform();
+	Vector2 motion = p_to.get_origin() - from.get_origin();
+	real_t motion_length = motion.length();
+	if (motion_length < CMP_EPSILON) {
+		return p_to;
+	}
+	Vector2 motion_normal = motion / motion_length;
+
+	// Each sub-step moves the body by at most half of its size along the motion,
+	// so it can't go through anything that is as thick as itself or more.
+	real_t body_size = 1e20;
+	Rect2 motion_aabb;
+	bool motion_aabb_valid = false;
+	for (int i = 0; i < p_body->get_shape_count(); i++) {
+		if (p_body->is_shape_disabled(i)) {
+			continue;
+		}
+
+		GodotShape2D *shape = p_body->get_shape(i);
+		const Transform2D &shape_xform = p_body->get_shape_transform(i);
+
+		real_t min = 0.0, max = 0.0;
+		shape->project_rangev(motion_normal, from * shape_xform, min, max);
+		body_size = MIN(body_size, max - min);
+
+		Rect2 shape_aabb = (from * shape_xform).xform(shape->get_aabb()).merge((p_to * shape_xform).xform(shape->get_aabb()));
+		if (motion_aabb_valid) {
+			motion_aabb = motion_aabb.merge(shape_aabb);
+		} else {
+			motion_aabb = shape_aabb;
+			motion_aabb_valid = true;
+		}
+	}
+
+	if (!motion_aabb_valid) {
+		return p_to;
+	}
+
+	int substep_count = ccd_max_substeps;
+	if (body_size > CMP_EPSILON) {
+		substep_count = MIN(substep_count, (int)Math::ceil(motion_length / (body_size * 0.5)));
+	}
+	if (substep_count <= 1) {
+		return p_to;
+	}
+
+	// Only the bodies along the motion are tested, so the cost only depends on the fast bodies.
+	int amount = _cull_aabb_for_ccd(p_body, motion_aabb);
+
+	// Whatever the body already touches is handled by the solver.
+	for (int i = 0; i < amount; i++) {
+		if (_ccd_collides(p_body, from, i, motion_normal)) {
+			if (i < amount - 1) {
+				SWAP(intersection_query_results[i], intersection_query_results[amount - 1]);
+				SWAP(intersection_query_subindex_results[i], intersection_query_subindex_results[amount - 1]);
+			}
+			amount--;
+			i--;
+		}
+	}
+
+	if (amount == 0) {
+		return p_to;
+	}
+
+	real_t substep = 1.0 / substep_count;
+	for (int substep_index = 1; substep_index <= substep_count; substep_index++) {
+		real_t hi = substep_index * substep;
+		Transform2D xform = substep_index == substep_count ? p_to : from.interpolate_with(p_to, hi);
+
+		int hit_index = -1;
+		for (int i = 0; i < amount; i++) {
+			if (_ccd_collides(p_body, xform, i, motion_normal)) {
+				hit_index = i;
+				break;
+			}
+		}
+
+		if (hit_index == -1) {
+			continue;
+		}
+
+		// Refine the time of impact against what was hit, and stop the body slightly inside of it,
+		// so the contact is handled by the solver on the next step with the body's velocity untouched.
+		real_t lo = hi - substep;
+		for (int i = 0; i < 4; i++) {
+			real_t mid = (lo + hi) * 0.5;
+			if (_ccd_collides(p_body, from.interpolate_with(p_to, mid), hit_index, motion_normal)) {
+				hi = mid;
+			} else {
+				lo = mid;
+			}
+		}
+
+		return from.interpolate_with(p_to, hi);
+	}
+
+	return p_to;
+}
+
 bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::MotionParameters &p_parameters, PhysicsServer2D::MotionResult *r_result) {
 	//give me back regular physics engine logic
 	//this is madness
@@ -1139,6 +1304,318 @@ void GodotSpace2D::setup() {
 	}
 }
 
+// Snapshots are laid out as a header, the bodies, then the collision pairs and the joints. Each entry
+// starts with its key and its size, fields are written one by one (see GodotSnapshot2D).
+#define SPACE_SNAPSHOT_MAGIC 0x32535350 // "PSS2"
+#define SPACE_SNAPSHOT_VERSION 1
+#define SPACE_SNAPSHOT_BODY_HEADER_SIZE (8 + 4)
+#define SPACE_SNAPSHOT_PAIR_HEADER_SIZE (8 + 4 + 8 + 4 + 4)
+#define SPACE_SNAPSHOT_JOINT_HEADER_SIZE (8 + 4)
+
+// Collision pairs are keyed by their objects and shapes, with the object with the lowest RID first.
+struct SpaceSnapshotPairKey2D {
+	uint64_t rid_A = 0;
+	uint64_t rid_B = 0;
+	int32_t shape_A = 0;
+	int32_t shape_B = 0;
+
+	static uint32_t hash(const SpaceSnapshotPairKey2D &p_key) {
+		uint32_t h = hash_murmur3_one_64(p_key.rid_A);
+		h = hash_murmur3_one_64(p_key.rid_B, h);
+		h = hash_murmur3_one_32(p_key.shape_A, h);
+		return hash_fmix32(hash_murmur3_one_32(p_key.shape_B, h));
+	}
+
+	_FORCE_INLINE_ bool operator==(const SpaceSnapshotPairKey2D &p_key) const {
+		return rid_A == p_key.rid_A && rid_B == p_key.rid_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+	}
+};
+
+static bool _get_snapshot_pair_key(const GodotConstraint2D *p_constraint, SpaceSnapshotPairKey2D &r_key, bool &r_swapped) {
+	const GodotCollisionObject2D *object_A = nullptr;
+	const GodotCollisionObject2D *object_B = nullptr;
+	int shape_A = 0;
+	int shape_B = 0;
+	if (!p_constraint->get_snapshot_pair(object_A, shape_A, object_B, shape_B)) {
+		return false;
+	}
+
+	r_swapped = object_B->get_self().get_id() < object_A->get_self().get_id();
+	if (r_swapped) {
+		SWAP(object_A, object_B);
+		SWAP(shape_A, shape_B);
+	}
+	r_key.rid_A = object_A->get_self().get_id();
+	r_key.rid_B = object_B->get_self().get_id();
+	r_key.shape_A = shape_A;
+	r_key.shape_B = shape_B;
+	return true;
+}
+
+static void _get_snapshot_constraints(const GodotCollisionObject2D *p_object, LocalVector<GodotConstraint2D *> &r_constraints) {
+	r_constraints.clear();
+	if (p_object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+		for (const Pair<GodotConstraint2D *, int> &E : static_cast<const GodotBody2D *>(p_object)->get_constraint_list()) {
+			r_constraints.push_back(E.first);
+		}
+	} else if (p_object->get_type() == GodotCollisionObject2D::TYPE_AREA) {
+		for (GodotConstraint2D *constraint : static_cast<const GodotArea2D *>(p_object)->get_constraints()) {
+			r_constraints.push_back(constraint);
+		}
+	}
+}
+
+static _FORCE_INLINE_ void _put_snapshot_entry_size(StreamPeerBuffer *r_buffer, int p_size_position) {
+	// Sizes are written once the entry is saved.
+	const int end_position = r_buffer->get_position();
+	r_buffer->seek(p_size_position);
+	r_buffer->put_u32(end_position - p_size_position - 4);
+	r_buffer->seek(end_position);
+}
+
+Vector<uint8_t> GodotSpace2D::get_snapshot() const {
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	buffer->put_u32(SPACE_SNAPSHOT_MAGIC);
+	buffer->put_u32(SPACE_SNAPSHOT_VERSION);
+
+	uint32_t body_count = 0;
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			body_count++;
+		}
+	}
+
+	buffer->put_u32(body_count);
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			buffer->put_u64(object->get_self().get_id());
+			buffer->put_u32(GodotBody2D::SNAPSHOT_SIZE);
+			static_cast<const GodotBody2D *>(object)->save_snapshot(buffer.ptr());
+		}
+	}
+
+	// Pairs are saved once, from the object with the lowest RID.
+	LocalVector<GodotConstraint2D *> object_constraints;
+	uint32_t pair_count = 0;
+	const int pair_count_position = buffer->get_position();
+	buffer->put_u32(0);
+	for (const GodotCollisionObject2D *object : objects) {
+		_get_snapshot_constraints(object, object_constraints);
+		for (const GodotConstraint2D *constraint : object_constraints) {
+			SpaceSnapshotPairKey2D key;
+			bool swapped = false;
+			if (!_get_snapshot_pair_key(constraint, key, swapped) || key.rid_A != object->get_self().get_id()) {
+				continue;
+			}
+
+			buffer->put_u64(key.rid_A);
+			buffer->put_32(key.shape_A);
+			buffer->put_u64(key.rid_B);
+			buffer->put_32(key.shape_B);
+			const int size_position = buffer->get_position();
+			buffer->put_u32(0);
+			constraint->save_snapshot_state(buffer.ptr(), swapped);
+			_put_snapshot_entry_size(buffer.ptr(), size_position);
+			pair_count++;
+		}
+	}
+	const int pairs_end = buffer->get_position();
+	buffer->seek(pair_count_position);
+	buffer->put_u32(pair_count);
+	buffer->seek(pairs_end);
+
+	// Joints are saved once, keyed by their RID.
+	HashSet<const GodotConstraint2D *> saved_joints;
+	uint32_t joint_count = 0;
+	const int joint_count_position = buffer->get_position();
+	buffer->put_u32(0);
+	for (const GodotCollisionObject2D *object : objects) {
+		_get_snapshot_constraints(object, object_constraints);
+		for (const GodotConstraint2D *constraint : object_constraints) {
+			if (!constraint->has_snapshot_state() || saved_joints.has(constraint)) {
+				continue;
+			}
+			saved_joints.insert(constraint);
+
+			buffer->put_u64(constraint->get_self().get_id());
+			const int size_position = buffer->get_position();
+			buffer->put_u32(0);
+			constraint->save_snapshot_state(buffer.ptr(), false);
+			_put_snapshot_entry_size(buffer.ptr(), size_position);
+			joint_count++;
+		}
+	}
+	const int joints_end = buffer->get_position();
+	buffer->seek(joint_count_position);
+	buffer->put_u32(joint_count);
+	buffer->seek(joints_end);
+
+	return buffer->get_data_array();
+}
+
+void GodotSpace2D::set_snapshot(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_MSG(locked, "Can't restore a snapshot while the space is being stepped.");
+
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	buffer->set_data_array(p_snapshot);
+
+	// Validate the layout of the whole snapshot and find the bodies first, so nothing is restored from a broken snapshot.
+	ERR_FAIL_COND_MSG(buffer->get_available_bytes() < 12, "Invalid space snapshot.");
+	const uint32_t magic = buffer->get_u32();
+	ERR_FAIL_COND_MSG(magic != SPACE_SNAPSHOT_MAGIC, "Invalid space snapshot.");
+	const uint32_t version = buffer->get_u32();
+	ERR_FAIL_COND_MSG(version != SPACE_SNAPSHOT_VERSION, "Space snapshot was saved by an incompatible engine version.");
+
+	const uint32_t body_count = buffer->get_u32();
+	const int bodies_position = buffer->get_position();
+	const int body_entry_size = SPACE_SNAPSHOT_BODY_HEADER_SIZE + GodotBody2D::SNAPSHOT_SIZE;
+	ERR_FAIL_COND_MSG(body_count > uint32_t(buffer->get_available_bytes() / body_entry_size), "Invalid space snapshot.");
+
+	// Bodies are saved in the order of the space objects, so they are usually found in the same order here.
+	snapshot_bodies.resize(body_count);
+	HashMap<uint64_t, GodotBody2D *> body_map;
+	HashSet<GodotCollisionObject2D *>::Iterator object_it = objects.begin();
+	for (uint32_t body_index = 0; body_index < body_count; body_index++) {
+		const uint64_t rid = buffer->get_u64();
+		const uint32_t size = buffer->get_u32();
+		ERR_FAIL_COND_MSG(size != GodotBody2D::SNAPSHOT_SIZE, "Invalid space snapshot.");
+		buffer->seek(buffer->get_position() + GodotBody2D::SNAPSHOT_SIZE);
+
+		while (object_it != objects.end() && (*object_it)->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			++object_it;
+		}
+
+		GodotBody2D *body = nullptr;
+		if (object_it != objects.end() && (*object_it)->get_self().get_id() == rid) {
+			body = static_cast<GodotBody2D *>(*object_it);
+			++object_it;
+		} else {
+			if (body_map.is_empty()) {
+				for (GodotCollisionObject2D *object : objects) {
+					if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+						body_map.insert(object->get_self().get_id(), static_cast<GodotBody2D *>(object));
+					}
+				}
+			}
+			GodotBody2D **body_ptr = body_map.getptr(rid);
+			if (body_ptr) {
+				body = *body_ptr;
+			}
+		}
+		snapshot_bodies[body_index] = body;
+	}
+
+	ERR_FAIL_COND_MSG(buffer->get_available_bytes() < 4, "Invalid space snapshot.");
+	const uint32_t pair_count = buffer->get_u32();
+	const int pairs_position = buffer->get_position();
+	for (uint32_t pair_index = 0; pair_index < pair_count; pair_index++) {
+		ERR_FAIL_COND_MSG(buffer->get_available_bytes() < SPACE_SNAPSHOT_PAIR_HEADER_SIZE, "Invalid space snapshot.");
+		buffer->seek(buffer->get_position() + SPACE_SNAPSHOT_PAIR_HEADER_SIZE - 4);
+		const uint32_t size = buffer->get_u32();
+		ERR_FAIL_COND_MSG(size > uint32_t(buffer->get_available_bytes()), "Invalid space snapshot.");
+		buffer->seek(buffer->get_position() + size);
+	}
+
+	ERR_FAIL_COND_MSG(buffer->get_available_bytes() < 4, "Invalid space snapshot.");
+	const uint32_t joint_count = buffer->get_u32();
+	const int joints_position = buffer->get_position();
+	for (uint32_t joint_index = 0; joint_index < joint_count; joint_index++) {
+		ERR_FAIL_COND_MSG(buffer->get_available_bytes() < SPACE_SNAPSHOT_JOINT_HEADER_SIZE, "Invalid space snapshot.");
+		buffer->seek(buffer->get_position() + SPACE_SNAPSHOT_JOINT_HEADER_SIZE - 4);
+		const uint32_t size = buffer->get_u32();
+		ERR_FAIL_COND_MSG(size > uint32_t(buffer->get_available_bytes()), "Invalid space snapshot.");
+		buffer->seek(buffer->get_position() + size);
+	}
+
+	ERR_FAIL_COND_MSG(buffer->get_available_bytes() != 0, "Invalid space snapshot.");
+
+	// Restore the bodies. Bodies that aren't in the space anymore are skipped, bodies that weren't saved are left as they are.
+	for (uint32_t body_index = 0; body_index < body_count; body_index++) {
+		if (snapshot_bodies[body_index]) {
+			buffer->seek(bodies_position + body_index * body_entry_size + SPACE_SNAPSHOT_BODY_HEADER_SIZE);
+			snapshot_bodies[body_index]->load_snapshot(buffer.ptr());
+		}
+	}
+
+	// Update the broadphase so the collision pairs match the restored transforms.
+	update();
+
+	// Restore the state of the collision pairs. Pairs that weren't saved, or whose state can't be read, start
+	// from scratch like new pairs would.
+	HashMap<SpaceSnapshotPairKey2D, GodotConstraint2D *, SpaceSnapshotPairKey2D> pairs;
+	LocalVector<GodotConstraint2D *> object_constraints;
+	for (const GodotCollisionObject2D *object : objects) {
+		_get_snapshot_constraints(object, object_constraints);
+		for (GodotConstraint2D *constraint : object_constraints) {
+			SpaceSnapshotPairKey2D key;
+			bool swapped = false;
+			if (_get_snapshot_pair_key(constraint, key, swapped) && key.rid_A == object->get_self().get_id()) {
+				pairs.insert(key, constraint);
+			}
+		}
+	}
+
+	buffer->seek(pairs_position);
+	for (uint32_t pair_index = 0; pair_index < pair_count; pair_index++) {
+		SpaceSnapshotPairKey2D key;
+		key.rid_A = buffer->get_u64();
+		key.shape_A = buffer->get_32();
+		key.rid_B = buffer->get_u64();
+		key.shape_B = buffer->get_32();
+		const uint32_t size = buffer->get_u32();
+		const int state_position = buffer->get_position();
+
+		HashMap<SpaceSnapshotPairKey2D, GodotConstraint2D *, SpaceSnapshotPairKey2D>::Iterator E = pairs.find(key);
+		if (E) {
+			SpaceSnapshotPairKey2D pair_key;
+			bool swapped = false;
+			_get_snapshot_pair_key(E->value, pair_key, swapped);
+			if (!E->value->load_snapshot_state(buffer.ptr(), size, swapped)) {
+				E->value->reset_snapshot_state();
+			}
+			pairs.remove(E);
+		}
+		buffer->seek(state_position + size);
+	}
+
+	for (const KeyValue<SpaceSnapshotPairKey2D, GodotConstraint2D *> &E : pairs) {
+		E.value->reset_snapshot_state();
+	}
+
+	// Restore the joints the same way.
+	HashMap<uint64_t, GodotConstraint2D *> joints;
+	for (const GodotCollisionObject2D *object : objects) {
+		_get_snapshot_constraints(object, object_constraints);
+		for (GodotConstraint2D *constraint : object_constraints) {
+			if (constraint->has_snapshot_state()) {
+				joints.insert(constraint->get_self().get_id(), constraint);
+			}
+		}
+	}
+
+	buffer->seek(joints_position);
+	for (uint32_t joint_index = 0; joint_index < joint_count; joint_index++) {
+		const uint64_t rid = buffer->get_u64();
+		const uint32_t size = buffer->get_u32();
+		const int state_position = buffer->get_position();
+
+		HashMap<uint64_t, GodotConstraint2D *>::Iterator E = joints.find(rid);
+		if (E) {
+			if (!E->value->load_snapshot_state(buffer.ptr(), size, false)) {
+				E->value->reset_snapshot_state();
+			}
+			joints.remove(E);
+		}
+		buffer->seek(state_position + size);
+	}
+
+	for (const KeyValue<uint64_t, GodotConstraint2D *> &E : joints) {
+		E.value->reset_snapshot_state();
+	}
+}
+
 void GodotSpace2D::update() {
 	broadphase->update();
 }
@@ -1172,6 +1649,9 @@ void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer2D::SPACE_PARAM_CCD_MAX_SUBSTEPS:
+			ccd_max_substeps = MAX(1, (int)p_value);
+			break;
 	}
 }
 
@@ -1195,6 +1675,8 @@ real_t GodotSpace2D::get_param(PhysicsServer2D::SpaceParameter p_param) const {
 			return constraint_bias;
 		case PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer2D::SPACE_PARAM_CCD_MAX_SUBSTEPS:
+			return ccd_max_substeps;
 	}
 	return 0;
 }
@@ -1220,6 +1702,7 @@ GodotSpace2D::GodotSpace2D() {
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/2d/time_before_sleep");
 	solver_iterations = GLOBAL_GET("physics/2d/solver/solver_iterations");
+	ccd_max_substeps = MAX(1, (int)GLOBAL_GET("physics/2d/solver/ccd_max_substeps"));
 	contact_recycle_radius = GLOBAL_GET("physics/2d/solver/contact_recycle_radius");
 	contact_max_separation = GLOBAL_GET("physics/2d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
@@ -40,6 +40,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
@@ -62,6 +63,7 @@ class GodotSpace2D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_UPDATE_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
@@ -70,6 +72,13 @@ public:
 
 	};
 
+	enum IslandSize {
+		ISLAND_SIZE_SMALL,
+		ISLAND_SIZE_MEDIUM,
+		ISLAND_SIZE_LARGE,
+		ISLAND_SIZE_MAX
+	};
+
 private:
 	struct ExcludedShapeSW {
 		GodotShape2D *local_shape = nullptr;
@@ -79,6 +88,11 @@ private:
 
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
 
+	int constraint_count = 0;
+	int largest_island_size = 0;
+	int island_size_count[ISLAND_SIZE_MAX] = {};
+	LocalVector<uint64_t> thread_solve_time;
+
 	GodotPhysicsDirectSpaceState2D *direct_access = nullptr;
 	RID self;
 
@@ -93,10 +107,12 @@ private:
 	static void _broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_data, void *p_self);
 
 	HashSet<GodotCollisionObject2D *> objects;
+	LocalVector<GodotBody2D *> snapshot_bodies;
 
 	GodotArea2D *area = nullptr;
 
 	int solver_iterations = 0;
+	int ccd_max_substeps = 1;
 
 	real_t contact_recycle_radius = 0.0;
 	real_t contact_max_separation = 0.0;
@@ -124,6 +140,8 @@ private:
 	int collision_pairs = 0;
 
 	int _cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb);
+	int _cull_aabb_for_ccd(GodotBody2D *p_body, const Rect2 &p_aabb);
+	bool _ccd_collides(GodotBody2D *p_body, const Transform2D &p_transform, int p_result_index, const Vector2 &p_motion_normal) const;
 
 	Vector<Vector2> contact_debug;
 	int contact_debug_count = 0;
@@ -159,6 +177,7 @@ public:
 	const HashSet<GodotCollisionObject2D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ int get_ccd_max_substeps() const { return ccd_max_substeps; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
@@ -182,6 +201,9 @@ public:
 	void set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer2D::SpaceParameter p_param) const;
 
+	Vector<uint8_t> get_snapshot() const;
+	void set_snapshot(const Vector<uint8_t> &p_snapshot);
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
@@ -191,6 +213,7 @@ public:
 	int get_collision_pairs() const { return collision_pairs; }
 
 	bool test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::MotionParameters &p_parameters, PhysicsServer2D::MotionResult *r_result);
+	Transform2D substep_body_motion(GodotBody2D *p_body, const Transform2D &p_to);
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
 	_FORCE_INLINE_ bool is_debugging_contacts() const { return !contact_debug.is_empty(); }
@@ -207,6 +230,19 @@ public:
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
+	void set_constraint_count(int p_constraint_count) { constraint_count = p_constraint_count; }
+	int get_constraint_count() const { return constraint_count; }
+
+	void set_largest_island_size(int p_size) { largest_island_size = p_size; }
+	int get_largest_island_size() const { return largest_island_size; }
+
+	void set_island_size_count(IslandSize p_size, int p_count) { island_size_count[p_size] = p_count; }
+	int get_island_size_count(IslandSize p_size) const { return island_size_count[p_size]; }
+
+	// Time spent solving islands by each thread, the first one is the thread running the step.
+	void set_thread_solve_time(const LocalVector<uint64_t> &p_time) { thread_solve_time = p_time; }
+	const LocalVector<uint64_t> &get_thread_solve_time() const { return thread_solve_time; }
+
 	GodotSpace2D();
 	~GodotSpace2D();
 };
@@ -38,6 +38,8 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define SMALL_ISLAND_CONSTRAINT_COUNT 8
+#define LARGE_ISLAND_CONSTRAINT_COUNT 256
 
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -72,6 +74,29 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 	}
 }
 
+void GodotStep2D::_update_island_stats(GodotSpace2D *p_space, uint32_t p_island_count) const {
+	int largest_island_size = 0;
+	int island_size_count[GodotSpace2D::ISLAND_SIZE_MAX] = {};
+
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		int island_size = constraint_islands[island_index].size();
+		largest_island_size = MAX(largest_island_size, island_size);
+		if (island_size >= LARGE_ISLAND_CONSTRAINT_COUNT) {
+			island_size_count[GodotSpace2D::ISLAND_SIZE_LARGE]++;
+		} else if (island_size >= SMALL_ISLAND_CONSTRAINT_COUNT) {
+			island_size_count[GodotSpace2D::ISLAND_SIZE_MEDIUM]++;
+		} else {
+			island_size_count[GodotSpace2D::ISLAND_SIZE_SMALL]++;
+		}
+	}
+
+	p_space->set_constraint_count((int)all_constraints.size());
+	p_space->set_largest_island_size(largest_island_size);
+	for (int i = 0; i < GodotSpace2D::ISLAND_SIZE_MAX; i++) {
+		p_space->set_island_size_count(GodotSpace2D::IslandSize(i), island_size_count[i]);
+	}
+}
+
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -90,7 +115,9 @@ void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const {
+void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) {
+	uint64_t solve_begtime = OS::get_singleton()->get_ticks_usec();
+
 	const LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[p_island_index];
 
 	for (int i = 0; i < iterations; i++) {
@@ -99,6 +126,9 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 			constraint_island[constraint_index]->solve(delta);
 		}
 	}
+
+	// Each thread only writes to its own entry.
+	thread_solve_time[WorkerThreadPool::get_singleton()->get_thread_index() + 1] += OS::get_singleton()->get_ticks_usec() - solve_begtime;
 }
 
 void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
@@ -153,12 +183,20 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	p_space->set_active_objects(active_count);
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
+	/* UPDATE BROADPHASE */
+
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_UPDATE_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -230,6 +268,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	p_space->set_island_count((int)island_count);
+	_update_island_stats(p_space, island_count);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -258,11 +297,18 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	thread_solve_time.resize(WorkerThreadPool::get_singleton()->get_thread_count() + 1);
+	for (uint64_t &time : thread_solve_time) {
+		time = 0;
+	}
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	p_space->set_thread_solve_time(thread_solve_time);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
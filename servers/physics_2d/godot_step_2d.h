@@ -45,10 +45,13 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
+	LocalVector<uint64_t> thread_solve_time;
+
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
+	void _update_island_stats(GodotSpace2D *p_space, uint32_t p_island_count) const;
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
+	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
 
 public:
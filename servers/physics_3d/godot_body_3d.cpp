@@ -40,6 +40,12 @@ void GodotBody3D::_mass_properties_changed() {
 	}
 }
 
+void GodotBody3D::_dormant_changed() {
+	if (get_space() && !dormant_update_list.in_list() && get_space()->is_sleeping_bodies_dormant()) {
+		get_space()->body_add_to_dormant_update_list(&dormant_update_list);
+	}
+}
+
 void GodotBody3D::_update_transform_dependent() {
 	center_of_mass = get_transform().basis.xform(center_of_mass_local);
 	principal_inertia_axes = get_transform().basis * principal_inertia_axes_local;
@@ -187,6 +193,8 @@ void GodotBody3D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	_dormant_changed();
 }
 
 void GodotBody3D::set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value) {
@@ -336,6 +344,8 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 			set_active(true);
 		}
 	}
+
+	_dormant_changed();
 }
 
 PhysicsServer3D::BodyMode GodotBody3D::get_mode() const {
@@ -415,6 +425,43 @@ void GodotBody3D::set_state(PhysicsServer3D::BodyState p_state, const Variant &p
 	}
 }
 
+void GodotBody3D::save_snapshot(StreamPeerBuffer *r_buffer) const {
+	GodotSnapshot3D::put_transform(r_buffer, get_transform());
+	GodotSnapshot3D::put_transform(r_buffer, get_inv_transform());
+	GodotSnapshot3D::put_transform(r_buffer, new_transform);
+	GodotSnapshot3D::put_vector3(r_buffer, linear_velocity);
+	GodotSnapshot3D::put_vector3(r_buffer, angular_velocity);
+	GodotSnapshot3D::put_vector3(r_buffer, prev_linear_velocity);
+	GodotSnapshot3D::put_vector3(r_buffer, prev_angular_velocity);
+	GodotSnapshot3D::put_vector3(r_buffer, applied_force);
+	GodotSnapshot3D::put_vector3(r_buffer, applied_torque);
+	GodotSnapshot3D::put_vector3(r_buffer, constant_force);
+	GodotSnapshot3D::put_vector3(r_buffer, constant_torque);
+	GodotSnapshot3D::put_real(r_buffer, still_time);
+	r_buffer->put_u8(active);
+}
+
+void GodotBody3D::load_snapshot(StreamPeerBuffer *p_buffer) {
+	const Transform3D transform = GodotSnapshot3D::get_transform(p_buffer);
+	const Transform3D inv_transform = GodotSnapshot3D::get_transform(p_buffer);
+	if (get_transform() != transform) {
+		_set_transform(transform);
+		_set_inv_transform(inv_transform);
+		_update_transform_dependent();
+	}
+	new_transform = GodotSnapshot3D::get_transform(p_buffer);
+	linear_velocity = GodotSnapshot3D::get_vector3(p_buffer);
+	angular_velocity = GodotSnapshot3D::get_vector3(p_buffer);
+	prev_linear_velocity = GodotSnapshot3D::get_vector3(p_buffer);
+	prev_angular_velocity = GodotSnapshot3D::get_vector3(p_buffer);
+	applied_force = GodotSnapshot3D::get_vector3(p_buffer);
+	applied_torque = GodotSnapshot3D::get_vector3(p_buffer);
+	constant_force = GodotSnapshot3D::get_vector3(p_buffer);
+	constant_torque = GodotSnapshot3D::get_vector3(p_buffer);
+	still_time = GodotSnapshot3D::get_real(p_buffer);
+	set_active(p_buffer->get_u8() != 0);
+}
+
 Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	switch (p_state) {
 		case PhysicsServer3D::BODY_STATE_TRANSFORM: {
@@ -448,12 +495,16 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 		if (direct_state_query_list.in_list()) {
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
 		}
+		if (dormant_update_list.in_list()) {
+			get_space()->body_remove_from_dormant_update_list(&dormant_update_list);
+		}
 	}
 
 	_set_space(p_space);
 
 	if (get_space()) {
 		_mass_properties_changed();
+		_dormant_changed();
 		if (active) {
 			get_space()->body_add_to_active_list(&active_list);
 		}
@@ -755,6 +806,12 @@ void GodotBody3D::wakeup_neighbours() {
 	}
 }
 
+void GodotBody3D::update_dormant() {
+	// Only sleeping rigid bodies become dormant, kinematic bodies can move while inactive.
+	bool dormant = !active && mode >= PhysicsServer3D::BODY_MODE_RIGID && get_space() && get_space()->is_sleeping_bodies_dormant();
+	_set_dormant(dormant);
+}
+
 void GodotBody3D::call_queries() {
 	Variant direct_state_variant = get_direct_state();
 
@@ -825,6 +882,7 @@ GodotBody3D::GodotBody3D() :
 		GodotCollisionObject3D(TYPE_BODY),
 		active_list(this),
 		mass_properties_update_list(this),
+		dormant_update_list(this),
 		direct_state_query_list(this) {
 	_set_static(false);
 }
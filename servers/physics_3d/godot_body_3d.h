@@ -33,6 +33,7 @@
 
 #include "godot_area_3d.h"
 #include "godot_collision_object_3d.h"
+#include "godot_snapshot_3d.h"
 
 #include "core/templates/vset.h"
 
@@ -98,6 +99,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	SelfList<GodotBody3D> active_list;
 	SelfList<GodotBody3D> mass_properties_update_list;
+	SelfList<GodotBody3D> dormant_update_list;
 	SelfList<GodotBody3D> direct_state_query_list;
 
 	VSet<RID> exceptions;
@@ -109,6 +111,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool first_time_kinematic = false;
 
 	void _mass_properties_changed();
+	void _dormant_changed();
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
 
@@ -299,6 +302,11 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
+	// Simulated state, saved in space snapshots.
+	static const uint32_t SNAPSHOT_SIZE = 3 * GodotSnapshot3D::TRANSFORM_SIZE + 8 * GodotSnapshot3D::VECTOR3_SIZE + GodotSnapshot3D::REAL_SIZE + 1;
+	void save_snapshot(StreamPeerBuffer *r_buffer) const;
+	void load_snapshot(StreamPeerBuffer *p_buffer);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
 	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
 
@@ -340,6 +348,7 @@ public:
 	//void simulate_motion(const Transform3D& p_xform,real_t p_step);
 	void call_queries();
 	void wakeup_neighbours();
+	void update_dormant();
 
 	bool sleep_test(real_t p_step);
 
@@ -595,6 +595,76 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+bool GodotBodyPair3D::get_snapshot_pair(const GodotCollisionObject3D *&r_object_A, int &r_shape_A, const GodotCollisionObject3D *&r_object_B, int &r_shape_B) const {
+	r_object_A = A;
+	r_shape_A = shape_A;
+	r_object_B = B;
+	r_shape_B = shape_B;
+	return true;
+}
+
+void GodotBodyPair3D::save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const {
+	// When swapped, the contacts are saved as seen from B: normals and impulses applied to A point the other way.
+	const real_t sign = p_swapped ? -1.0 : 1.0;
+	GodotSnapshot3D::put_vector3(r_buffer, sep_axis * sign);
+	r_buffer->put_u8(collided);
+	r_buffer->put_u32(contact_count);
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		r_buffer->put_32(p_swapped ? c.index_B : c.index_A);
+		r_buffer->put_32(p_swapped ? c.index_A : c.index_B);
+		GodotSnapshot3D::put_vector3(r_buffer, p_swapped ? c.local_B : c.local_A);
+		GodotSnapshot3D::put_vector3(r_buffer, p_swapped ? c.local_A : c.local_B);
+		GodotSnapshot3D::put_vector3(r_buffer, c.normal * sign);
+		GodotSnapshot3D::put_vector3(r_buffer, c.acc_impulse * sign);
+		GodotSnapshot3D::put_vector3(r_buffer, c.acc_tangent_impulse * sign);
+		GodotSnapshot3D::put_real(r_buffer, c.acc_normal_impulse);
+		GodotSnapshot3D::put_real(r_buffer, c.acc_bias_impulse);
+		GodotSnapshot3D::put_real(r_buffer, c.acc_bias_impulse_center_of_mass);
+		r_buffer->put_u8(c.used);
+	}
+}
+
+bool GodotBodyPair3D::load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) {
+	ERR_FAIL_COND_V(p_size < SNAPSHOT_STATE_SIZE, false);
+	const real_t sign = p_swapped ? -1.0 : 1.0;
+	const Vector3 saved_sep_axis = GodotSnapshot3D::get_vector3(p_buffer) * sign;
+	const bool saved_collided = p_buffer->get_u8() != 0;
+	const uint32_t saved_contact_count = p_buffer->get_u32();
+	ERR_FAIL_COND_V(saved_contact_count > MAX_CONTACTS, false);
+	ERR_FAIL_COND_V(p_size != SNAPSHOT_STATE_SIZE + saved_contact_count * SNAPSHOT_CONTACT_SIZE, false);
+
+	sep_axis = saved_sep_axis;
+	collided = saved_collided;
+	contact_count = saved_contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		Contact &c = contacts[i];
+		c = Contact();
+		const int index_1 = p_buffer->get_32();
+		const int index_2 = p_buffer->get_32();
+		c.index_A = p_swapped ? index_2 : index_1;
+		c.index_B = p_swapped ? index_1 : index_2;
+		const Vector3 local_1 = GodotSnapshot3D::get_vector3(p_buffer);
+		const Vector3 local_2 = GodotSnapshot3D::get_vector3(p_buffer);
+		c.local_A = p_swapped ? local_2 : local_1;
+		c.local_B = p_swapped ? local_1 : local_2;
+		c.normal = GodotSnapshot3D::get_vector3(p_buffer) * sign;
+		c.acc_impulse = GodotSnapshot3D::get_vector3(p_buffer) * sign;
+		c.acc_tangent_impulse = GodotSnapshot3D::get_vector3(p_buffer) * sign;
+		c.acc_normal_impulse = GodotSnapshot3D::get_real(p_buffer);
+		c.acc_bias_impulse = GodotSnapshot3D::get_real(p_buffer);
+		c.acc_bias_impulse_center_of_mass = GodotSnapshot3D::get_real(p_buffer);
+		c.used = p_buffer->get_u8() != 0;
+	}
+	return true;
+}
+
+void GodotBodyPair3D::reset_snapshot_state() {
+	sep_axis = Vector3();
+	contact_count = 0;
+	collided = false;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -97,6 +97,10 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Size of the saved state before the contacts, and of each contact.
+	static const uint32_t SNAPSHOT_STATE_SIZE = GodotSnapshot3D::VECTOR3_SIZE + 1 + 4;
+	static const uint32_t SNAPSHOT_CONTACT_SIZE = 8 + 5 * GodotSnapshot3D::VECTOR3_SIZE + 3 * GodotSnapshot3D::REAL_SIZE + 1;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
@@ -109,6 +113,11 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool get_snapshot_pair(const GodotCollisionObject3D *&r_object_A, int &r_shape_A, const GodotCollisionObject3D *&r_object_B, int &r_shape_B) const override;
+	virtual void save_snapshot_state(StreamPeerBuffer *r_buffer, bool p_swapped) const override;
+	virtual bool load_snapshot_state(StreamPeerBuffer *p_buffer, uint32_t p_size, bool p_swapped) override;
+	virtual void reset_snapshot_state() override;
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
@@ -51,6 +51,8 @@ public:
 	virtual ID create(GodotCollisionObject3D *p_object_, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) = 0;
 	virtual void move(ID p_id, const AABB &p_aabb) = 0;
 	virtual void set_static(ID p_id, bool p_static) = 0;
+	// Dormant (sleeping) objects only pair with non-dormant ones, so they are only woken by awake objects.
+	virtual void set_dormant(ID p_id, bool p_dormant) = 0;
 	virtual void remove(ID p_id) = 0;
 
 	virtual GodotCollisionObject3D *get_object(ID p_id) const = 0;
@@ -59,6 +61,8 @@ public:
 
 	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
+	// Results of segment i start at p_results[i * p_max_results], their count is written to r_result_counts[i].
+	virtual void cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_segment_count, GodotCollisionObject3D **p_results, int *p_result_indices, int *r_result_counts, int p_max_results) = 0;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
@@ -32,9 +32,11 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? (TREE_FLAG_DYNAMIC | TREE_FLAG_DORMANT) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_DORMANT);
 	ID oid = bvh.create(p_object, true, tree_id, tree_collision_mask, p_aabb, p_subindex); // Pair everything, don't care?
 	return oid + 1;
 }
@@ -47,7 +49,19 @@ void GodotBroadPhase3DBVH::move(ID p_id, const AABB &p_aabb) {
 void GodotBroadPhase3DBVH::set_static(ID p_id, bool p_static) {
 	ERR_FAIL_COND(!p_id);
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? (TREE_FLAG_DYNAMIC | TREE_FLAG_DORMANT) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_DORMANT);
+	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
+}
+
+void GodotBroadPhase3DBVH::set_dormant(ID p_id, bool p_dormant) {
+	ERR_FAIL_COND(!p_id);
+	if (bvh.get_tree_id(p_id - 1) == TREE_STATIC) {
+		return; // Static objects never become dormant.
+	}
+	// Dormant objects keep their pairs with static and awake objects, but don't pair with each other,
+	// so sleeping piles don't keep any pairs alive and are skipped by the refit of the dynamic tree.
+	uint32_t tree_id = p_dormant ? TREE_DORMANT : TREE_DYNAMIC;
+	uint32_t tree_collision_mask = p_dormant ? (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_DORMANT);
 	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
 }
 
@@ -82,6 +96,10 @@ int GodotBroadPhase3DBVH::cull_segment(const Vector3 &p_from, const Vector3 &p_t
 	return bvh.cull_segment(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+void GodotBroadPhase3DBVH::cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_segment_count, GodotCollisionObject3D **p_results, int *p_result_indices, int *r_result_counts, int p_max_results) {
+	bvh.cull_segments(p_from, p_to, p_segment_count, p_results, r_result_counts, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
 int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) {
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
@@ -104,6 +122,11 @@ void GodotBroadPhase3DBVH::_unpair_callback(void *self, uint32_t p_A, GodotColli
 	bpo->unpair_callback(p_object_A, subindex_A, p_object_B, subindex_B, pairdata, bpo->unpair_userdata);
 }
 
+void GodotBroadPhase3DBVH::_parallel_pairing_callback(void *self, void (*p_function)(void *, uint32_t), void *p_function_userdata, uint32_t p_count) {
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(p_function, p_function_userdata, p_count, -1, true, SNAME("BVHPairingCull"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void GodotBroadPhase3DBVH::set_pair_callback(PairCallback p_pair_callback, void *p_userdata) {
 	pair_callback = p_pair_callback;
 	pair_userdata = p_userdata;
@@ -125,4 +148,5 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+	bvh.params_set_parallel_pairing(_parallel_pairing_callback, this);
 }
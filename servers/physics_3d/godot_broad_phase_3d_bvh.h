@@ -56,17 +56,20 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	enum Tree {
 		TREE_STATIC = 0,
 		TREE_DYNAMIC = 1,
+		TREE_DORMANT = 2,
 	};
 
 	enum TreeFlag {
 		TREE_FLAG_STATIC = 1 << TREE_STATIC,
 		TREE_FLAG_DYNAMIC = 1 << TREE_DYNAMIC,
+		TREE_FLAG_DORMANT = 1 << TREE_DORMANT,
 	};
 
-	BVH_Manager<GodotCollisionObject3D, 2, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
+	BVH_Manager<GodotCollisionObject3D, 3, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
 
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int, void *);
+	static void _parallel_pairing_callback(void *, void (*)(void *, uint32_t), void *, uint32_t);
 
 	PairCallback pair_callback = nullptr;
 	void *pair_userdata = nullptr;
@@ -78,6 +81,7 @@ public:
 	virtual ID create(GodotCollisionObject3D *p_object, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) override;
 	virtual void move(ID p_id, const AABB &p_aabb) override;
 	virtual void set_static(ID p_id, bool p_static) override;
+	virtual void set_dormant(ID p_id, bool p_dormant) override;
 	virtual void remove(ID p_id) override;
 
 	virtual GodotCollisionObject3D *get_object(ID p_id) const override;
@@ -86,6 +90,7 @@ public:
 
 	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual void cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_segment_count, GodotCollisionObject3D **p_results, int *p_result_indices, int *r_result_counts, int p_max_results) override;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
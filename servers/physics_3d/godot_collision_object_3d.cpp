@@ -130,6 +130,10 @@ void GodotCollisionObject3D::_set_static(bool p_static) {
 		return;
 	}
 	_static = p_static;
+	if (_static) {
+		// Static objects are never dormant, they are moved out of the dormant tree below.
+		_dormant = false;
+	}
 
 	if (!space) {
 		return;
@@ -142,6 +146,23 @@ void GodotCollisionObject3D::_set_static(bool p_static) {
 	}
 }
 
+void GodotCollisionObject3D::_set_dormant(bool p_dormant) {
+	if (_dormant == p_dormant || _static) {
+		return;
+	}
+	_dormant = p_dormant;
+
+	if (!space) {
+		return;
+	}
+	for (int i = 0; i < get_shape_count(); i++) {
+		const Shape &s = shapes[i];
+		if (s.bpid > 0) {
+			space->get_broadphase()->set_dormant(s.bpid, _dormant);
+		}
+	}
+}
+
 void GodotCollisionObject3D::_unregister_shapes() {
 	for (int i = 0; i < shapes.size(); i++) {
 		Shape &s = shapes.write[i];
@@ -176,6 +197,9 @@ void GodotCollisionObject3D::_update_shapes() {
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (_dormant) {
+				space->get_broadphase()->set_dormant(s.bpid, true);
+			}
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
@@ -203,6 +227,9 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (_dormant) {
+				space->get_broadphase()->set_dormant(s.bpid, true);
+			}
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
@@ -223,6 +250,7 @@ void GodotCollisionObject3D::_set_space(GodotSpace3D *p_space) {
 	}
 
 	space = p_space;
+	_dormant = false;
 
 	if (space) {
 		space->add_object(this);
@@ -76,6 +76,7 @@ private:
 	Transform3D transform;
 	Transform3D inv_transform;
 	bool _static = true;
+	bool _dormant = false;
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
@@ -98,6 +99,7 @@ protected:
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Transform3D &p_transform) { inv_transform = p_transform; }
 	void _set_static(bool p_static);
+	void _set_dormant(bool p_dormant);
 
 	virtual void _shapes_changed() = 0;
 	void _set_space(GodotSpace3D *p_space);
@@ -187,8 +189,16 @@ public:
 	virtual void set_space(GodotSpace3D *p_space) = 0;
 
 	_FORCE_INLINE_ bool is_static() const { return _static; }
+	_FORCE_INLINE_ bool is_dormant() const { return _dormant; }
 
 	virtual ~GodotCollisionObject3D() {}
 };
 
+// Sorts collision objects by creation order, RIDs are allocated in increasing order.
+struct CollisionObjectRIDComparator3D {
+	_FORCE_INLINE_ bool operator()(const GodotCollisionObject3D *p_a, const GodotCollisionObject3D *p_b) const {
+		return p_a->get_self() < p_b->get_self();
+	}
+};
+
 #endif // GODOT_COLLISION_OBJECT_3D_H
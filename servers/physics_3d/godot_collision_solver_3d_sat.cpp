@@ -33,6 +33,7 @@
 #include "gjk_epa.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/templates/local_vector.h"
 
 #define fallback_collision_solver gjk_epa_calculate_penetration
 
@@ -648,6 +649,12 @@ public:
 		shape_A->project_range(axis, *transform_A, min_A, max_A);
 		shape_B->project_range(axis, *transform_B, min_B, max_B);
 
+		return test_axis_range(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Same as test_axis(), when the projections of both shapes on the axis are already known.
+	// Only the relative position of the ranges matters, so they can be given relative to any point on the axis.
+	_FORCE_INLINE_ bool test_axis_range(const Vector3 &axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B) {
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -1068,6 +1075,29 @@ static void _collision_sphere_face(const GodotShape3D *p_a, const Transform3D &p
 	separator.generate_contacts();
 }
 
+// Half length of the projection of a box on an axis, from the columns of its basis and its half extents.
+static _FORCE_INLINE_ real_t _box_projection_radius(const Vector3 *p_columns, const Vector3 &p_half_extents, const Vector3 &p_axis) {
+	return Math::abs(p_columns[0].dot(p_axis)) * p_half_extents.x + Math::abs(p_columns[1].dot(p_axis)) * p_half_extents.y + Math::abs(p_columns[2].dot(p_axis)) * p_half_extents.z;
+}
+
+// Tests an axis for a pair of boxes without going through the generic shape projections,
+// with the ranges given relative to the center of A.
+template <bool withMargin>
+static _FORCE_INLINE_ bool _test_box_box_axis(SeparatorAxisTest<GodotBoxShape3D, GodotBoxShape3D, withMargin> &p_separator, const Vector3 &p_axis, const Vector3 *p_columns_A, const Vector3 &p_half_extents_A, const Vector3 *p_columns_B, const Vector3 &p_half_extents_B, const Vector3 &p_ab_vec) {
+	Vector3 axis = p_axis;
+
+	if (axis.is_zero_approx()) {
+		// strange case, try an upwards separator
+		axis = Vector3(0.0, 1.0, 0.0);
+	}
+
+	real_t radius_A = _box_projection_radius(p_columns_A, p_half_extents_A, axis);
+	real_t radius_B = _box_projection_radius(p_columns_B, p_half_extents_B, axis);
+	real_t distance = axis.dot(p_ab_vec);
+
+	return p_separator.test_axis_range(axis, -radius_A, radius_A, distance - radius_B, distance + radius_B);
+}
+
 template <bool withMargin>
 static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_transform_a, const GodotShape3D *p_b, const Transform3D &p_transform_b, _CollectorCallback *p_collector, real_t p_margin_a, real_t p_margin_b) {
 	const GodotBoxShape3D *box_A = static_cast<const GodotBoxShape3D *>(p_a);
@@ -1079,12 +1109,18 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
+	const Vector3 columns_A[3] = { p_transform_a.basis.get_column(0), p_transform_a.basis.get_column(1), p_transform_a.basis.get_column(2) };
+	const Vector3 columns_B[3] = { p_transform_b.basis.get_column(0), p_transform_b.basis.get_column(1), p_transform_b.basis.get_column(2) };
+	const Vector3 half_extents_A = box_A->get_half_extents();
+	const Vector3 half_extents_B = box_B->get_half_extents();
+	const Vector3 ab_vec = p_transform_b.origin - p_transform_a.origin;
+
 	// test faces of A
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
+		Vector3 axis = columns_A[i].normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!_test_box_box_axis<withMargin>(separator, axis, columns_A, half_extents_A, columns_B, half_extents_B, ab_vec)) {
 			return;
 		}
 	}
@@ -1092,9 +1128,9 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	// test faces of B
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
+		Vector3 axis = columns_B[i].normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!_test_box_box_axis<withMargin>(separator, axis, columns_A, half_extents_A, columns_B, half_extents_B, ab_vec)) {
 			return;
 		}
 	}
@@ -1102,14 +1138,14 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	// test combined edges
 	for (int i = 0; i < 3; i++) {
 		for (int j = 0; j < 3; j++) {
-			Vector3 axis = p_transform_a.basis.get_column(i).cross(p_transform_b.basis.get_column(j));
+			Vector3 axis = columns_A[i].cross(columns_B[j]);
 
 			if (Math::is_zero_approx(axis.length_squared())) {
 				continue;
 			}
 			axis.normalize();
 
-			if (!separator.test_axis(axis)) {
+			if (!_test_box_box_axis<withMargin>(separator, axis, columns_A, half_extents_A, columns_B, half_extents_B, ab_vec)) {
 				return;
 			}
 		}
@@ -1120,27 +1156,25 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 
 		// calculate closest point to sphere
 
-		Vector3 ab_vec = p_transform_b.origin - p_transform_a.origin;
-
 		Vector3 cnormal_a = p_transform_a.basis.xform_inv(ab_vec);
 
 		Vector3 support_a = p_transform_a.xform(Vector3(
 
-				(cnormal_a.x < 0) ? -box_A->get_half_extents().x : box_A->get_half_extents().x,
-				(cnormal_a.y < 0) ? -box_A->get_half_extents().y : box_A->get_half_extents().y,
-				(cnormal_a.z < 0) ? -box_A->get_half_extents().z : box_A->get_half_extents().z));
+				(cnormal_a.x < 0) ? -half_extents_A.x : half_extents_A.x,
+				(cnormal_a.y < 0) ? -half_extents_A.y : half_extents_A.y,
+				(cnormal_a.z < 0) ? -half_extents_A.z : half_extents_A.z));
 
 		Vector3 cnormal_b = p_transform_b.basis.xform_inv(-ab_vec);
 
 		Vector3 support_b = p_transform_b.xform(Vector3(
 
-				(cnormal_b.x < 0) ? -box_B->get_half_extents().x : box_B->get_half_extents().x,
-				(cnormal_b.y < 0) ? -box_B->get_half_extents().y : box_B->get_half_extents().y,
-				(cnormal_b.z < 0) ? -box_B->get_half_extents().z : box_B->get_half_extents().z));
+				(cnormal_b.x < 0) ? -half_extents_B.x : half_extents_B.x,
+				(cnormal_b.y < 0) ? -half_extents_B.y : half_extents_B.y,
+				(cnormal_b.z < 0) ? -half_extents_B.z : half_extents_B.z));
 
 		Vector3 axis_ab = (support_a - support_b);
 
-		if (!separator.test_axis(axis_ab.normalized())) {
+		if (!_test_box_box_axis<withMargin>(separator, axis_ab.normalized(), columns_A, half_extents_A, columns_B, half_extents_B, ab_vec)) {
 			return;
 		}
 
@@ -1148,16 +1182,16 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 
 		for (int i = 0; i < 3; i++) {
 			//a ->b
-			Vector3 axis_a = p_transform_a.basis.get_column(i);
+			Vector3 axis_a = columns_A[i];
 
-			if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
+			if (!_test_box_box_axis<withMargin>(separator, axis_ab.cross(axis_a).cross(axis_a).normalized(), columns_A, half_extents_A, columns_B, half_extents_B, ab_vec)) {
 				return;
 			}
 
 			//b ->a
-			Vector3 axis_b = p_transform_b.basis.get_column(i);
+			Vector3 axis_b = columns_B[i];
 
-			if (!separator.test_axis(axis_ab.cross(axis_b).cross(axis_b).normalized())) {
+			if (!_test_box_box_axis<withMargin>(separator, axis_ab.cross(axis_b).cross(axis_b).normalized(), columns_A, half_extents_A, columns_B, half_extents_B, ab_vec)) {
 				return;
 			}
 		}
@@ -2025,6 +2059,18 @@ static void _collision_cylinder_face(const GodotShape3D *p_a, const Transform3D
 	separator.generate_contacts();
 }
 
+struct ConvexEdge {
+	Vector3 direction;
+	Vector3 normal_a;
+	Vector3 normal_b;
+};
+
+// Narrowphase runs on WorkerThreadPool threads, so the scratch space for large hulls is kept per
+// thread and reused between calls instead of being allocated on the (limited) worker stack.
+static thread_local LocalVector<ConvexEdge> convex_world_edges;
+static thread_local LocalVector<Vector3> convex_world_vertices_a;
+static thread_local LocalVector<Vector3> convex_world_vertices_b;
+
 static _FORCE_INLINE_ bool is_minkowski_face(const Vector3 &A, const Vector3 &B, const Vector3 &B_x_A, const Vector3 &C, const Vector3 &D, const Vector3 &D_x_C) {
 	// Test if arcs AB and CD intersect on the unit sphere
 	real_t CBA = C.dot(B_x_A);
@@ -2090,22 +2136,27 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 
 	// A<->B edges
 
+	// The edges of B are transformed once here instead of once per edge of A, so the inner loop
+	// is only made of the Minkowski face test on contiguous data.
+	LocalVector<ConvexEdge> &world_edges_B = convex_world_edges;
+	world_edges_B.resize(edge_count_B);
+	for (int j = 0; j < edge_count_B; j++) {
+		ConvexEdge &edge = world_edges_B[j];
+		edge.direction = p_transform_b.basis.xform(vertices_B[edges_B[j].vertex_b] - vertices_B[edges_B[j].vertex_a]);
+		edge.normal_a = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
+		edge.normal_b = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
+	}
+
 	for (int i = 0; i < edge_count_A; i++) {
-		Vector3 p1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_a]);
-		Vector3 q1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_b]);
-		Vector3 e1 = q1 - p1;
+		Vector3 e1 = p_transform_a.basis.xform(vertices_A[edges_A[i].vertex_b] - vertices_A[edges_A[i].vertex_a]);
 		Vector3 u1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_a].plane.normal).normalized();
 		Vector3 v1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_b].plane.normal).normalized();
 
 		for (int j = 0; j < edge_count_B; j++) {
-			Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
-			Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
-			Vector3 e2 = q2 - p2;
-			Vector3 u2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
-			Vector3 v2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
+			const ConvexEdge &edge_B = world_edges_B[j];
 
-			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
-				Vector3 axis = e1.cross(e2).normalized();
+			if (is_minkowski_face(u1, v1, -e1, -edge_B.normal_a, -edge_B.normal_b, -edge_B.direction)) {
+				Vector3 axis = e1.cross(edge_B.direction).normalized();
 
 				if (!separator.test_axis(axis)) {
 					return;
@@ -2115,12 +2166,24 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	}
 
 	if (withMargin) {
+		LocalVector<Vector3> &world_vertices_A = convex_world_vertices_a;
+		world_vertices_A.resize(vertex_count_A);
+		for (int i = 0; i < vertex_count_A; i++) {
+			world_vertices_A[i] = p_transform_a.xform(vertices_A[i]);
+		}
+
+		LocalVector<Vector3> &world_vertices_B = convex_world_vertices_b;
+		world_vertices_B.resize(vertex_count_B);
+		for (int i = 0; i < vertex_count_B; i++) {
+			world_vertices_B[i] = p_transform_b.xform(vertices_B[i]);
+		}
+
 		//vertex-vertex
 		for (int i = 0; i < vertex_count_A; i++) {
-			Vector3 va = p_transform_a.xform(vertices_A[i]);
+			const Vector3 &va = world_vertices_A[i];
 
 			for (int j = 0; j < vertex_count_B; j++) {
-				if (!separator.test_axis((va - p_transform_b.xform(vertices_B[j])).normalized())) {
+				if (!separator.test_axis((va - world_vertices_B[j]).normalized())) {
 					return;
 				}
 			}
@@ -2133,7 +2196,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			Vector3 n = (e2 - e1);
 
 			for (int j = 0; j < vertex_count_B; j++) {
-				Vector3 e3 = p_transform_b.xform(vertices_B[j]);
+				const Vector3 &e3 = world_vertices_B[j];
 
 				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized())) {
 					return;
@@ -2147,7 +2210,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			Vector3 n = (e2 - e1);
 
 			for (int j = 0; j < vertex_count_A; j++) {
-				Vector3 e3 = p_transform_a.xform(vertices_A[j]);
+				const Vector3 &e3 = world_vertices_A[j];
 
 				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized())) {
 					return;
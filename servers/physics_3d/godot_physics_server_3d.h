@@ -48,6 +48,12 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int constraint_count = 0;
+	int largest_island_size = 0;
+	int island_size_count[GodotSpace3D::ISLAND_SIZE_MAX] = {};
+	uint64_t elapsed_time[GodotSpace3D::ELAPSED_TIME_MAX] = {};
+	uint64_t solve_iteration_time = 0;
+	LocalVector<uint64_t> thread_solve_time;
 
 	bool using_threads = false;
 	bool doing_sync = false;
@@ -117,6 +123,11 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const override;
+	virtual void space_set_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override;
+
+	virtual uint32_t space_get_state_hash(RID p_space) const override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
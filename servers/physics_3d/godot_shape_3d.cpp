@@ -33,7 +33,7 @@
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
-#include "core/templates/sort_array.h"
+#include "core/templates/hash_map.h"
 
 // GodotHeightMapShape3D is based on Bullet btHeightfieldTerrainShape.
 
@@ -1287,12 +1287,15 @@ GodotFaceShape3D::GodotFaceShape3D() {
 Vector<Vector3> GodotConcavePolygonShape3D::get_faces() const {
 	Vector<Vector3> rfaces;
 	rfaces.resize(faces.size() * 3);
+	Vector3 *rfacesw = rfaces.ptrw();
 
+	// Faces are stored in tree order, put them back in the order they were set.
 	for (int i = 0; i < faces.size(); i++) {
-		Face f = faces.get(i);
+		const Face &f = faces[i];
+		const int source_face_index = source_face_indices[i];
 
 		for (int j = 0; j < 3; j++) {
-			rfaces.set(i * 3 + j, vertices.get(f.indices[j]));
+			rfacesw[source_face_index * 3 + j] = vertices[f.indices[j]];
 		}
 	}
 
@@ -1345,72 +1348,92 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
-	}
-
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->collisions++;
-			}
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
-	}
-}
-
 bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result, Vector3 &r_normal, bool p_hit_back_faces) const {
 	if (faces.size() == 0) {
 		return false;
 	}
 
+	Vector3 dir = p_end - p_begin;
+	real_t length = dir.length();
+	if (length == 0) {
+		return false;
+	}
+	dir /= length;
+
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
 	const BVH *br = bvh.ptr();
+	uint32_t node_count = bvh.size();
 
 	GodotFaceShape3D face;
 	face.backface_collision = backface_collision && p_hit_back_faces;
 
-	_SegmentCullParams params;
-	params.from = p_begin;
-	params.to = p_end;
-	params.dir = (p_end - p_begin).normalized();
+	// Nodes are tested in quantized space, the affine transform keeps the parameter along the segment.
+	Vector3 from = (p_begin - bvh_quantize_origin) * bvh_quantize_scale;
+	Vector3 motion = (p_end - bvh_quantize_origin) * bvh_quantize_scale - from;
+	Vector3 inv_motion;
+	for (int i = 0; i < 3; i++) {
+		inv_motion[i] = motion[i] != 0 ? 1.0 / motion[i] : 1e30;
+	}
 
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
+	real_t min_d = 1e20;
+	Vector3 result;
+	Vector3 normal;
+	int collisions = 0;
 
-	params.face = &face;
+	uint32_t node_index = 0;
+	while (node_index < node_count) {
+		const BVH &node = br[node_index];
+
+		// Expand the node by half a quantization step to stay robust against rounding,
+		// and skip nodes which are further away than the closest hit so far.
+		real_t t_min = 0.0;
+		real_t t_max = MIN(min_d / length, (real_t)1.0);
+		for (int i = 0; i < 3; i++) {
+			real_t t0 = (node.min[i] - 0.5 - from[i]) * inv_motion[i];
+			real_t t1 = (node.max[i] + 0.5 - from[i]) * inv_motion[i];
+			if (t0 > t1) {
+				SWAP(t0, t1);
+			}
+			t_min = MAX(t_min, t0);
+			t_max = MIN(t_max, t1);
+		}
 
-	// cull
-	_cull_segment(0, &params);
+		if (t_min > t_max) {
+			node_index = node.is_leaf() ? node_index + 1 : node.get_escape_index();
+			continue;
+		}
+
+		if (node.is_leaf()) {
+			uint32_t face_end = node.get_first_face() + node.get_face_count();
+			for (uint32_t face_index = node.get_first_face(); face_index < face_end; face_index++) {
+				const Face *f = &fr[face_index];
+				face.normal = f->normal;
+				face.vertex[0] = vr[f->indices[0]];
+				face.vertex[1] = vr[f->indices[1]];
+				face.vertex[2] = vr[f->indices[2]];
+
+				Vector3 res;
+				Vector3 res_normal;
+				if (face.intersect_segment(p_begin, p_end, res, res_normal, true)) {
+					real_t d = dir.dot(res) - dir.dot(p_begin);
+					if ((d > 0) && (d < min_d)) {
+						min_d = d;
+						result = res;
+						normal = res_normal;
+						collisions++;
+					}
+				}
+			}
+		}
+
+		node_index++;
+	}
 
-	if (params.collisions > 0) {
-		r_result = params.result;
-		r_normal = params.normal;
+	if (collisions > 0) {
+		r_result = result;
+		r_normal = normal;
 		return true;
 	} else {
 		return false;
@@ -1425,40 +1448,6 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
-
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
-		}
-
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
-			}
-		}
-	}
-
-	return false;
-}
-
 void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
 	// make matrix local to concave
 	if (faces.size() == 0) {
@@ -1466,27 +1455,60 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	}
 
 	AABB local_aabb = p_local_aabb;
+	if (!local_aabb.intersects(get_aabb())) {
+		return;
+	}
 
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
 	const BVH *br = bvh.ptr();
+	uint32_t node_count = bvh.size();
 
 	GodotFaceShape3D face; // use this to send in the callback
 	face.backface_collision = backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	_CullParams params;
-	params.aabb = local_aabb;
-	params.face = &face;
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
-	params.callback = p_callback;
-	params.userdata = p_userdata;
+	// Quantizing rounds outwards, so comparing quantized bounds never misses an overlap.
+	uint16_t query_min[3];
+	uint16_t query_max[3];
+	_quantize_aabb(local_aabb, query_min, query_max);
+
+	uint32_t node_index = 0;
+	while (node_index < node_count) {
+		const BVH &node = br[node_index];
+
+		if (query_min[0] > node.max[0] || query_max[0] < node.min[0] ||
+				query_min[1] > node.max[1] || query_max[1] < node.min[1] ||
+				query_min[2] > node.max[2] || query_max[2] < node.min[2]) {
+			node_index = node.is_leaf() ? node_index + 1 : node.get_escape_index();
+			continue;
+		}
+
+		if (node.is_leaf()) {
+			uint32_t face_end = node.get_first_face() + node.get_face_count();
+			for (uint32_t face_index = node.get_first_face(); face_index < face_end; face_index++) {
+				const Face *f = &fr[face_index];
+				face.vertex[0] = vr[f->indices[0]];
+				face.vertex[1] = vr[f->indices[1]];
+				face.vertex[2] = vr[f->indices[2]];
+
+				AABB face_aabb(face.vertex[0], Vector3());
+				face_aabb.expand_to(face.vertex[1]);
+				face_aabb.expand_to(face.vertex[2]);
+				if (!local_aabb.intersects(face_aabb)) {
+					continue;
+				}
+
+				face.normal = f->normal;
+				if (p_callback(p_userdata, &face)) {
+					return;
+				}
+			}
+		}
 
-	// cull
-	_cull(0, &params);
+		node_index++;
+	}
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1505,108 +1527,207 @@ struct _Volume_BVH_Element {
 	int face_index = 0;
 };
 
-struct _Volume_BVH_CompareX {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.x < b.center.x;
+// Only shares vertices with the exact same bits, so the faces are returned unchanged (signed zeros included).
+struct _VertexBitsHasher {
+	static _FORCE_INLINE_ uint32_t hash(const Vector3 &p_vertex) {
+		return hash_murmur3_buffer(&p_vertex, sizeof(Vector3));
 	}
 };
 
-struct _Volume_BVH_CompareY {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.y < b.center.y;
+struct _VertexBitsComparator {
+	static _FORCE_INLINE_ bool compare(const Vector3 &p_lhs, const Vector3 &p_rhs) {
+		return memcmp(&p_lhs, &p_rhs, sizeof(Vector3)) == 0;
 	}
 };
 
-struct _Volume_BVH_CompareZ {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.z < b.center.z;
+#define CONCAVE_BVH_SAH_BIN_COUNT 16
+#define CONCAVE_BVH_SAH_TRAVERSAL_COST 1.0
+
+static _FORCE_INLINE_ real_t _volume_bvh_half_area(const AABB &p_aabb) {
+	const Vector3 &size = p_aabb.size;
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+static _FORCE_INLINE_ int _volume_bvh_get_bin(const _Volume_BVH_Element &p_element, int p_axis, real_t p_min, real_t p_scale) {
+	return MIN(CONCAVE_BVH_SAH_BIN_COUNT - 1, (int)((p_element.center[p_axis] - p_min) * p_scale));
+}
+
+// Partitions the elements using the surface area heuristic, evaluated over a few bins of their centers.
+// Returns the number of elements in the first half, or 0 if they should be kept in a single leaf.
+static int _volume_bvh_partition(_Volume_BVH_Element *p_elements, int p_count, int p_leaf_max, const AABB &p_aabb, const AABB &p_center_aabb) {
+	if (p_count == 1) {
+		return 0;
 	}
-};
 
-struct _Volume_BVH {
-	AABB aabb;
-	_Volume_BVH *left = nullptr;
-	_Volume_BVH *right = nullptr;
+	struct Bin {
+		AABB aabb;
+		int count = 0;
+	};
 
-	int face_index = 0;
-};
+	real_t parent_area = _volume_bvh_half_area(p_aabb);
+	real_t best_cost = p_count <= p_leaf_max ? p_count * parent_area : INFINITY;
+	int best_axis = -1;
+	int best_bin = 0;
 
-_Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int &count) {
-	_Volume_BVH *bvh = memnew(_Volume_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
+	for (int axis = 0; axis < 3; axis++) {
+		real_t extent = p_center_aabb.size[axis];
+		if (extent <= 0) {
+			continue;
+		}
+		real_t bin_min = p_center_aabb.position[axis];
+		real_t bin_scale = CONCAVE_BVH_SAH_BIN_COUNT / extent;
+
+		Bin bins[CONCAVE_BVH_SAH_BIN_COUNT];
+		for (int i = 0; i < p_count; i++) {
+			Bin &bin = bins[_volume_bvh_get_bin(p_elements[i], axis, bin_min, bin_scale)];
+			if (bin.count == 0) {
+				bin.aabb = p_elements[i].aabb;
+			} else {
+				bin.aabb.merge_with(p_elements[i].aabb);
+			}
+			bin.count++;
+		}
+
+		// Sweep from the right to get the cost of everything after each bin.
+		real_t right_cost[CONCAVE_BVH_SAH_BIN_COUNT] = {};
+		AABB right_aabb;
+		int right_count = 0;
+		for (int b = CONCAVE_BVH_SAH_BIN_COUNT - 1; b > 0; b--) {
+			if (bins[b].count) {
+				if (right_count == 0) {
+					right_aabb = bins[b].aabb;
+				} else {
+					right_aabb.merge_with(bins[b].aabb);
+				}
+				right_count += bins[b].count;
+			}
+			right_cost[b] = right_count * _volume_bvh_half_area(right_aabb);
+		}
+
+		AABB left_aabb;
+		int left_count = 0;
+		for (int b = 0; b < CONCAVE_BVH_SAH_BIN_COUNT - 1; b++) {
+			if (bins[b].count) {
+				if (left_count == 0) {
+					left_aabb = bins[b].aabb;
+				} else {
+					left_aabb.merge_with(bins[b].aabb);
+				}
+				left_count += bins[b].count;
+			}
+			if (left_count == 0 || left_count == p_count) {
+				continue;
+			}
+
+			real_t cost = CONCAVE_BVH_SAH_TRAVERSAL_COST * parent_area + left_count * _volume_bvh_half_area(left_aabb) + right_cost[b + 1];
+			if (cost < best_cost) {
+				best_cost = cost;
+				best_axis = axis;
+				best_bin = b;
+			}
+		}
 	}
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
-		} else {
-			aabb.merge_with(p_elements[i].aabb);
+	if (best_axis == -1) {
+		if (p_count <= p_leaf_max) {
+			return 0;
 		}
+		// All centers are in the same place, any split is as good as another.
+		return p_count / 2;
 	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
-		case 0: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
-			sort_x.sort(p_elements, p_size);
 
-		} break;
-		case 1: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareY> sort_y;
-			sort_y.sort(p_elements, p_size);
-		} break;
-		case 2: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareZ> sort_z;
-			sort_z.sort(p_elements, p_size);
-		} break;
+	real_t bin_min = p_center_aabb.position[best_axis];
+	real_t bin_scale = CONCAVE_BVH_SAH_BIN_COUNT / p_center_aabb.size[best_axis];
+	int split = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (_volume_bvh_get_bin(p_elements[i], best_axis, bin_min, bin_scale) <= best_bin) {
+			SWAP(p_elements[i], p_elements[split]);
+			split++;
+		}
 	}
 
-	int split = p_size / 2;
-	bvh->left = _volume_build_bvh(p_elements, split, count);
-	bvh->right = _volume_build_bvh(&p_elements[split], p_size - split, count);
+	return split;
+}
 
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
+void GodotConcavePolygonShape3D::_quantize_aabb(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const {
+	Vector3 quantized_min = (p_aabb.position - bvh_quantize_origin) * bvh_quantize_scale;
+	Vector3 quantized_max = (p_aabb.get_end() - bvh_quantize_origin) * bvh_quantize_scale;
+	for (int i = 0; i < 3; i++) {
+		r_min[i] = (uint16_t)CLAMP(Math::floor(quantized_min[i]), (real_t)0.0, (real_t)BVH_QUANTIZE_MAX);
+		r_max[i] = (uint16_t)CLAMP(Math::ceil(quantized_max[i]), (real_t)0.0, (real_t)BVH_QUANTIZE_MAX);
+	}
 }
 
-void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
+void GodotConcavePolygonShape3D::_build_bvh(_Volume_BVH_Element *p_elements, int p_count, const AABB &p_aabb) {
+	bvh_quantize_origin = p_aabb.position;
+	for (int i = 0; i < 3; i++) {
+		bvh_quantize_scale[i] = p_aabb.size[i] > 0 ? BVH_QUANTIZE_MAX / p_aabb.size[i] : 0;
+	}
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+	struct BuildTask {
+		int start = 0;
+		int count = 0;
+		// Branch for which this is the second child, if any.
+		int parent = -1;
+	};
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+	LocalVector<BVH> nodes;
+	LocalVector<uint32_t> second_children;
+	LocalVector<BuildTask> stack;
 
-	} else {
-		p_bvh_array[p_idx].left = -1;
-	}
+	nodes.reserve(p_count);
+	second_children.reserve(p_count);
+	stack.push_back({ 0, p_count, -1 });
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+	// Build depth first, so the first child of each branch immediately follows it.
+	while (stack.size()) {
+		BuildTask task = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
 
-	} else {
-		p_bvh_array[p_idx].right = -1;
+		uint32_t node_index = nodes.size();
+		if (task.parent >= 0) {
+			second_children[task.parent] = node_index;
+		}
+		nodes.push_back(BVH());
+		second_children.push_back(0);
+
+		_Volume_BVH_Element *elements = &p_elements[task.start];
+		AABB node_aabb = elements[0].aabb;
+		AABB center_aabb(elements[0].center, Vector3());
+		for (int i = 1; i < task.count; i++) {
+			node_aabb.merge_with(elements[i].aabb);
+			center_aabb.expand_to(elements[i].center);
+		}
+		_quantize_aabb(node_aabb, nodes[node_index].min, nodes[node_index].max);
+
+		int split = _volume_bvh_partition(elements, task.count, BVH_LEAF_MAX_FACES, node_aabb, center_aabb);
+		if (split == 0) {
+			nodes[node_index].data = BVH_LEAF_FLAG | ((uint32_t)(task.count - 1) << BVH_LEAF_FACE_BITS) | (uint32_t)task.start;
+			continue;
+		}
+
+		stack.push_back({ task.start + split, task.count - split, (int)node_index });
+		stack.push_back({ task.start, split, -1 });
+	}
+
+	// A subtree ends where the subtree of its second child ends, children always come after their parent.
+	for (int64_t i = (int64_t)nodes.size() - 1; i >= 0; i--) {
+		if (!nodes[i].is_leaf()) {
+			uint32_t second_child = second_children[i];
+			nodes[i].data = nodes[second_child].is_leaf() ? second_child + 1 : nodes[second_child].get_escape_index();
+		}
 	}
 
-	memdelete(p_bvh_tree);
+	bvh.resize(nodes.size());
+	memcpy(bvh.ptrw(), nodes.ptr(), nodes.size() * sizeof(BVH));
 }
 
 void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision) {
+	faces.clear();
+	source_face_indices.clear();
+	vertices.clear();
+	bvh.clear();
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
 		configure(AABB());
@@ -1614,52 +1735,59 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	}
 	ERR_FAIL_COND(src_face_count % 3);
 	src_face_count /= 3;
+	ERR_FAIL_COND_MSG(src_face_count > (1 << BVH_LEAF_FACE_BITS), "Too many faces in concave polygon shape.");
 
 	const Vector3 *facesr = p_faces.ptr();
 
-	Vector<_Volume_BVH_Element> bvh_array;
-	bvh_array.resize(src_face_count);
-
-	_Volume_BVH_Element *bvh_arrayw = bvh_array.ptrw();
-
-	faces.resize(src_face_count);
-	Face *facesw = faces.ptrw();
-
-	vertices.resize(src_face_count * 3);
-
-	Vector3 *verticesw = vertices.ptrw();
+	LocalVector<_Volume_BVH_Element> bvh_elements;
+	bvh_elements.resize(src_face_count);
 
 	AABB _aabb;
 
 	for (int i = 0; i < src_face_count; i++) {
 		Face3 face(facesr[i * 3 + 0], facesr[i * 3 + 1], facesr[i * 3 + 2]);
 
-		bvh_arrayw[i].aabb = face.get_aabb();
-		bvh_arrayw[i].center = bvh_arrayw[i].aabb.get_center();
-		bvh_arrayw[i].face_index = i;
-		facesw[i].indices[0] = i * 3 + 0;
-		facesw[i].indices[1] = i * 3 + 1;
-		facesw[i].indices[2] = i * 3 + 2;
-		facesw[i].normal = face.get_plane().normal;
-		verticesw[i * 3 + 0] = face.vertex[0];
-		verticesw[i * 3 + 1] = face.vertex[1];
-		verticesw[i * 3 + 2] = face.vertex[2];
+		bvh_elements[i].aabb = face.get_aabb();
+		bvh_elements[i].center = bvh_elements[i].aabb.get_center();
+		bvh_elements[i].face_index = i;
 		if (i == 0) {
-			_aabb = bvh_arrayw[i].aabb;
+			_aabb = bvh_elements[i].aabb;
 		} else {
-			_aabb.merge_with(bvh_arrayw[i].aabb);
+			_aabb.merge_with(bvh_elements[i].aabb);
 		}
 	}
 
-	int count = 0;
-	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
+	_build_bvh(bvh_elements.ptr(), src_face_count, _aabb);
 
-	bvh.resize(count + 1);
+	// Store the faces in tree order, so each leaf references a range of them,
+	// and share identical vertices between faces.
+	faces.resize(src_face_count);
+	Face *facesw = faces.ptrw();
+	source_face_indices.resize(src_face_count);
+	int *source_face_indicesw = source_face_indices.ptrw();
 
-	BVH *bvh_arrayw2 = bvh.ptrw();
+	LocalVector<Vector3> unique_vertices;
+	HashMap<Vector3, int, _VertexBitsHasher, _VertexBitsComparator> vertex_indices;
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	for (int i = 0; i < src_face_count; i++) {
+		source_face_indicesw[i] = bvh_elements[i].face_index;
+		const Vector3 *src_vertices = &facesr[bvh_elements[i].face_index * 3];
+		facesw[i].normal = Face3(src_vertices[0], src_vertices[1], src_vertices[2]).get_plane().normal;
+
+		for (int j = 0; j < 3; j++) {
+			const int *vertex_index = vertex_indices.getptr(src_vertices[j]);
+			if (vertex_index) {
+				facesw[i].indices[j] = *vertex_index;
+			} else {
+				facesw[i].indices[j] = unique_vertices.size();
+				vertex_indices.insert(src_vertices[j], unique_vertices.size());
+				unique_vertices.push_back(src_vertices[j]);
+			}
+		}
+	}
+
+	vertices.resize(unique_vertices.size());
+	memcpy(vertices.ptrw(), unique_vertices.ptr(), unique_vertices.size() * sizeof(Vector3));
 
 	backface_collision = p_backface_collision;
 
@@ -2050,8 +2178,31 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
+	real_t query_min_height = local_aabb.position.y;
+	real_t query_max_height = local_aabb.position.y + local_aabb.size.y;
+
 	for (int z = start_z; z < end_z; z++) {
 		for (int x = start_x; x < end_x; x++) {
+			if (!bounds_grid.is_empty()) {
+				// Skip the rest of the chunk in this row if it's entirely above or below the query.
+				int chunk_x = x / BOUNDS_CHUNK_SIZE;
+				const Range &chunk = _get_bounds_chunk(chunk_x, z / BOUNDS_CHUNK_SIZE);
+				if (chunk.max < query_min_height || chunk.min > query_max_height) {
+					x = (chunk_x + 1) * BOUNDS_CHUNK_SIZE - 1;
+					continue;
+				}
+			}
+
+			// Skip cells entirely above or below the query.
+			real_t height_00 = _get_height(x, z);
+			real_t height_10 = _get_height(x + 1, z);
+			real_t height_01 = _get_height(x, z + 1);
+			real_t height_11 = _get_height(x + 1, z + 1);
+			if (MAX(MAX(height_00, height_10), MAX(height_01, height_11)) < query_min_height ||
+					MIN(MIN(height_00, height_10), MIN(height_01, height_11)) > query_max_height) {
+				continue;
+			}
+
 			// First triangle.
 			_get_point(x, z, face.vertex[0]);
 			_get_point(x + 1, z, face.vertex[1]);
@@ -302,7 +302,7 @@ public:
 	GodotConvexPolygonShape3D();
 };
 
-struct _Volume_BVH;
+struct _Volume_BVH_Element;
 struct GodotFaceShape3D;
 
 struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
@@ -314,49 +314,43 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	};
 
 	Vector<Face> faces;
+	// Index of each face in the faces that were set, they are stored in tree order.
+	Vector<int> source_face_indices;
 	Vector<Vector3> vertices;
 
-	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+	enum {
+		BVH_LEAF_MAX_FACES = 4,
+		BVH_LEAF_FACE_BITS = 28,
+		BVH_LEAF_FLAG = 1u << 31,
+		BVH_QUANTIZE_MAX = 65535,
 	};
 
-	Vector<BVH> bvh;
-
-	struct _CullParams {
-		AABB aabb;
-		QueryCallback callback = nullptr;
-		void *userdata = nullptr;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
+	// Node of a bounding volume hierarchy with bounds quantized to 16 bits inside the shape AABB.
+	// Nodes are stored in depth first order, so the first child of a branch is the next node and
+	// traversal needs no stack: a branch stores the index of the node following its subtree,
+	// which is where traversal continues when the branch is culled.
+	// Leaves store the range of their (consecutive) faces instead.
+	struct BVH {
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		uint32_t data = 0;
+
+		_FORCE_INLINE_ bool is_leaf() const { return data & BVH_LEAF_FLAG; }
+		_FORCE_INLINE_ uint32_t get_escape_index() const { return data; }
+		_FORCE_INLINE_ uint32_t get_first_face() const { return data & ((1u << BVH_LEAF_FACE_BITS) - 1); }
+		_FORCE_INLINE_ uint32_t get_face_count() const { return ((data & ~BVH_LEAF_FLAG) >> BVH_LEAF_FACE_BITS) + 1; }
 	};
 
-	struct _SegmentCullParams {
-		Vector3 from;
-		Vector3 to;
-		Vector3 dir;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
+	static_assert(sizeof(BVH) == 16, "Quantized BVH nodes should fit four to a cache line.");
 
-		Vector3 result;
-		Vector3 normal;
-		real_t min_d = 1e20;
-		int collisions = 0;
-	};
+	Vector<BVH> bvh;
+	Vector3 bvh_quantize_origin;
+	Vector3 bvh_quantize_scale;
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
-
-	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	void _quantize_aabb(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const;
+	void _build_bvh(_Volume_BVH_Element *p_elements, int p_count, const AABB &p_aabb);
 
 	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision);
 
@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  godot_snapshot_3d.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_SNAPSHOT_3D_H
+#define GODOT_SNAPSHOT_3D_H
+
+#include "core/io/stream_peer.h"
+#include "core/math/transform_3d.h"
+
+// Space snapshots are written field by field, with reals always saved as doubles,
+// so they don't depend on struct layouts or on the precision of the build.
+class GodotSnapshot3D {
+public:
+	static const uint32_t REAL_SIZE = sizeof(double);
+	static const uint32_t VECTOR3_SIZE = 3 * REAL_SIZE;
+	static const uint32_t TRANSFORM_SIZE = 12 * REAL_SIZE;
+
+	static _FORCE_INLINE_ void put_real(StreamPeerBuffer *r_buffer, real_t p_value) {
+		r_buffer->put_double(p_value);
+	}
+
+	static _FORCE_INLINE_ real_t get_real(StreamPeerBuffer *p_buffer) {
+		return p_buffer->get_double();
+	}
+
+	static _FORCE_INLINE_ void put_vector3(StreamPeerBuffer *r_buffer, const Vector3 &p_value) {
+		for (int i = 0; i < 3; i++) {
+			r_buffer->put_double(p_value[i]);
+		}
+	}
+
+	static _FORCE_INLINE_ Vector3 get_vector3(StreamPeerBuffer *p_buffer) {
+		Vector3 value;
+		for (int i = 0; i < 3; i++) {
+			value[i] = p_buffer->get_double();
+		}
+		return value;
+	}
+
+	static _FORCE_INLINE_ void put_transform(StreamPeerBuffer *r_buffer, const Transform3D &p_value) {
+		for (int i = 0; i < 3; i++) {
+			put_vector3(r_buffer, p_value.basis.rows[i]);
+		}
+		put_vector3(r_buffer, p_value.origin);
+	}
+
+	static _FORCE_INLINE_ Transform3D get_transform(StreamPeerBuffer *p_buffer) {
+		Transform3D value;
+		for (int i = 0; i < 3; i++) {
+			value.basis.rows[i] = get_vector3(p_buffer);
+		}
+		value.origin = get_vector3(p_buffer);
+		return value;
+	}
+};
+
+#endif // GODOT_SNAPSHOT_3D_H
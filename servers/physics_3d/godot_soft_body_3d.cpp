@@ -33,9 +33,15 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
 #include "servers/rendering_server.h"
 
+// Minimum amount of links for a soft body to solve its link batches in parallel.
+#define SOFT_BODY_PARALLEL_LINK_MIN 2048
+// Amount of links solved by each element of a parallel link batch task.
+#define SOFT_BODY_LINK_TASK_SIZE 256
+
 // Based on Bullet soft body.
 
 /*
@@ -823,6 +829,63 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	memdelete_arr(link_buffer);
 }
 
+void GodotSoftBody3D::color_links() {
+	link_batch_ends.clear();
+
+	uint32_t link_count = links.size();
+	if (link_count == 0) {
+		return;
+	}
+
+	// Greedy coloring, each node keeps a mask of the colors used by its links.
+	const uint32_t max_colors = 64;
+	LocalVector<uint64_t> node_color_masks;
+	node_color_masks.resize(nodes.size());
+	memset(node_color_masks.ptr(), 0, sizeof(uint64_t) * nodes.size());
+
+	LocalVector<uint32_t> link_colors;
+	link_colors.resize(link_count);
+
+	uint32_t color_counts[max_colors + 1] = {};
+	for (uint32_t i = 0; i < link_count; i++) {
+		const Link &link = links[i];
+		uint64_t &mask_a = node_color_masks[link.n[0]->index];
+		uint64_t &mask_b = node_color_masks[link.n[1]->index];
+		uint64_t used = mask_a | mask_b;
+
+		uint32_t color = max_colors;
+		if (used != UINT64_MAX) {
+			color = 0;
+			while (used & (uint64_t(1) << color)) {
+				color++;
+			}
+			mask_a |= uint64_t(1) << color;
+			mask_b |= uint64_t(1) << color;
+		}
+
+		link_colors[i] = color;
+		color_counts[color]++;
+	}
+
+	// Stable sort by color, to keep the cache-friendly order from reoptimize_link_order() within each batch.
+	uint32_t color_offsets[max_colors + 1];
+	uint32_t offset = 0;
+	for (uint32_t color = 0; color <= max_colors; color++) {
+		color_offsets[color] = offset;
+		offset += color_counts[color];
+		if (color < max_colors && color_counts[color] > 0) {
+			link_batch_ends.push_back(offset);
+		}
+	}
+
+	LocalVector<Link> sorted_links;
+	sorted_links.resize(link_count);
+	for (uint32_t i = 0; i < link_count; i++) {
+		sorted_links[color_offsets[link_colors[i]]++] = links[i];
+	}
+	links = sorted_links;
+}
+
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 	if (p_node1 == p_node2) {
 		return;
@@ -1064,9 +1127,16 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void GodotSoftBody3D::solve_constraints(real_t p_delta) {
+void GodotSoftBody3D::solve_constraints(real_t p_delta, bool p_parallel_links) {
 	const real_t inv_delta = 1.0 / p_delta;
 
+	p_parallel_links = p_parallel_links && has_parallel_links();
+	if (p_parallel_links && link_batch_ends.is_empty()) {
+		// Links are only sorted by color once they are actually solved in parallel,
+		// bodies that are always solved serially keep their link order.
+		color_links();
+	}
+
 	for (Link &link : links) {
 		link.c3 = link.n[1]->q - link.n[0]->q;
 		link.c2 = 1 / (link.c3.length_squared() * link.c0);
@@ -1079,8 +1149,12 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
-		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+		if (p_parallel_links) {
+			solve_links_parallel(1.0);
+		} else {
+			const real_t ti = isolve / (real_t)iteration_count;
+			solve_links(1.0, ti);
+		}
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
 	for (Node &node : nodes) {
@@ -1095,19 +1169,61 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	update_normals_and_centroids();
 }
 
+bool GodotSoftBody3D::has_parallel_links() const {
+	return links.size() >= SOFT_BODY_PARALLEL_LINK_MIN;
+}
+
+void GodotSoftBody3D::_solve_link(Link &p_link, real_t p_kst) {
+	if (p_link.c0 > 0) {
+		Node &node_a = *p_link.n[0];
+		Node &node_b = *p_link.n[1];
+		const Vector3 del = node_b.x - node_a.x;
+		const real_t len = del.length_squared();
+		if (p_link.c1 + len > CMP_EPSILON) {
+			const real_t k = ((p_link.c1 - len) / (p_link.c0 * (p_link.c1 + len))) * p_kst;
+			node_a.x -= del * (k * node_a.im);
+			node_b.x += del * (k * node_b.im);
+		}
+	}
+}
+
+void GodotSoftBody3D::_solve_link_range(uint32_t p_index, const LinkRange *p_range) {
+	uint32_t begin = p_range->begin + p_index * SOFT_BODY_LINK_TASK_SIZE;
+	uint32_t end = MIN(begin + SOFT_BODY_LINK_TASK_SIZE, p_range->end);
+	for (uint32_t i = begin; i < end; i++) {
+		_solve_link(links[i], p_range->kst);
+	}
+}
+
 void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
 	for (Link &link : links) {
-		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
-			const real_t len = del.length_squared();
-			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+		_solve_link(link, kst);
+	}
+}
+
+void GodotSoftBody3D::solve_links_parallel(real_t kst) {
+	LinkRange range;
+	range.kst = kst;
+
+	for (uint32_t batch_end : link_batch_ends) {
+		range.end = batch_end;
+		uint32_t batch_size = range.end - range.begin;
+		if (batch_size < SOFT_BODY_LINK_TASK_SIZE * 2) {
+			// Not worth dispatching.
+			for (uint32_t i = range.begin; i < range.end; i++) {
+				_solve_link(links[i], kst);
 			}
+		} else {
+			uint32_t task_count = (batch_size + SOFT_BODY_LINK_TASK_SIZE - 1) / SOFT_BODY_LINK_TASK_SIZE;
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotSoftBody3D::_solve_link_range, (const LinkRange *)&range, task_count, -1, true, SNAME("SoftBody3DSolveLinks"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		}
+		range.begin = range.end;
+	}
+
+	// Links that couldn't be colored depend on each other.
+	for (uint32_t i = range.begin; i < links.size(); i++) {
+		_solve_link(links[i], kst);
 	}
 }
 
@@ -1218,6 +1334,7 @@ void GodotSoftBody3D::destroy() {
 
 	nodes.clear();
 	links.clear();
+	link_batch_ends.clear();
 	faces.clear();
 
 	bounds = AABB();
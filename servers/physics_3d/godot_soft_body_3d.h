@@ -82,6 +82,17 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
+	// Filled the first time links are solved in parallel, when they get sorted by color.
+	// Links of the same color don't share any node and can be solved in parallel.
+	// Links past the last batch end couldn't be colored and are solved serially.
+	LocalVector<uint32_t> link_batch_ends;
+
+	struct LinkRange {
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		real_t kst = 0.0;
+	};
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
@@ -202,7 +213,8 @@ public:
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
 	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	void solve_constraints(real_t p_delta, bool p_parallel_links = false);
+	bool has_parallel_links() const;
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
@@ -234,10 +246,14 @@ private:
 	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 	void generate_bending_constraints(int p_distance);
 	void reoptimize_link_order();
+	void color_links();
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
+	_FORCE_INLINE_ void _solve_link(Link &p_link, real_t p_kst);
+	void _solve_link_range(uint32_t p_index, const LinkRange *p_range);
 	void solve_links(real_t kst, real_t ti);
+	void solve_links_parallel(real_t kst);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
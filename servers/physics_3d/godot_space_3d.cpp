@@ -37,6 +37,7 @@
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+#define RAY_BATCH_CHUNK_SIZE 32
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
@@ -105,17 +106,13 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray_results(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_results, const int *p_subindex_results, int p_amount, RayResult &r_result) const {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -124,22 +121,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -201,6 +198,52 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_results(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_ray_count <= 0) {
+		return 0;
+	}
+
+	// The broadphase results are kept in buffers taken from the space instead of its shared ones,
+	// so batches can be queried from several threads while the space is not stepping.
+	const uint32_t chunk_size = MIN(p_ray_count, RAY_BATCH_CHUNK_SIZE);
+	GodotSpace3D::RayBatchBuffers *buffers = space->_acquire_ray_batch_buffers();
+	LocalVector<GodotCollisionObject3D *> &results = buffers->results;
+	LocalVector<int> &subindex_results = buffers->subindex_results;
+	int result_counts[RAY_BATCH_CHUNK_SIZE];
+	if (results.size() < chunk_size * GodotSpace3D::INTERSECTION_QUERY_MAX) {
+		results.resize(chunk_size * GodotSpace3D::INTERSECTION_QUERY_MAX);
+		subindex_results.resize(chunk_size * GodotSpace3D::INTERSECTION_QUERY_MAX);
+	}
+
+	int hit_count = 0;
+	for (int chunk_start = 0; chunk_start < p_ray_count; chunk_start += RAY_BATCH_CHUNK_SIZE) {
+		int chunk_count = MIN(p_ray_count - chunk_start, RAY_BATCH_CHUNK_SIZE);
+		space->broadphase->cull_segments(p_from + chunk_start, p_to + chunk_start, chunk_count, results.ptr(), subindex_results.ptr(), result_counts, GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+		for (int i = 0; i < chunk_count; i++) {
+			int ray_index = chunk_start + i;
+			int result_offset = i * GodotSpace3D::INTERSECTION_QUERY_MAX;
+			r_hits[ray_index] = _intersect_ray_results(p_parameters, p_from[ray_index], p_to[ray_index], results.ptr() + result_offset, subindex_results.ptr() + result_offset, result_counts[i], r_results[ray_index]);
+			if (r_hits[ray_index]) {
+				hit_count++;
+			}
+		}
+	}
+
+	space->_release_ray_batch_buffers(buffers);
+
+	return hit_count;
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1098,6 +1141,14 @@ void GodotSpace3D::body_remove_from_mass_properties_update_list(SelfList<GodotBo
 	mass_properties_update_list.remove(p_body);
 }
 
+void GodotSpace3D::body_add_to_dormant_update_list(SelfList<GodotBody3D> *p_body) {
+	dormant_update_list.add(p_body);
+}
+
+void GodotSpace3D::body_remove_from_dormant_update_list(SelfList<GodotBody3D> *p_body) {
+	dormant_update_list.remove(p_body);
+}
+
 GodotBroadPhase3D *GodotSpace3D::get_broadphase() {
 	return broadphase;
 }
@@ -1178,7 +1229,256 @@ void GodotSpace3D::setup() {
 	}
 }
 
+// Snapshots are laid out as a header, the bodies, then the collision pairs. Each entry
+// starts with its key and its size, fields are written one by one (see GodotSnapshot3D).
+#define SPACE_SNAPSHOT_MAGIC 0x33535350 // "PSS3"
+#define SPACE_SNAPSHOT_VERSION 1
+#define SPACE_SNAPSHOT_BODY_HEADER_SIZE (8 + 4)
+#define SPACE_SNAPSHOT_PAIR_HEADER_SIZE (8 + 4 + 8 + 4 + 4)
+
+// Collision pairs are keyed by their objects and shapes, with the object with the lowest RID first.
+struct SpaceSnapshotPairKey3D {
+	uint64_t rid_A = 0;
+	uint64_t rid_B = 0;
+	int32_t shape_A = 0;
+	int32_t shape_B = 0;
+
+	static uint32_t hash(const SpaceSnapshotPairKey3D &p_key) {
+		uint32_t h = hash_murmur3_one_64(p_key.rid_A);
+		h = hash_murmur3_one_64(p_key.rid_B, h);
+		h = hash_murmur3_one_32(p_key.shape_A, h);
+		return hash_fmix32(hash_murmur3_one_32(p_key.shape_B, h));
+	}
+
+	_FORCE_INLINE_ bool operator==(const SpaceSnapshotPairKey3D &p_key) const {
+		return rid_A == p_key.rid_A && rid_B == p_key.rid_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+	}
+};
+
+static bool _get_snapshot_pair_key(const GodotConstraint3D *p_constraint, SpaceSnapshotPairKey3D &r_key, bool &r_swapped) {
+	const GodotCollisionObject3D *object_A = nullptr;
+	const GodotCollisionObject3D *object_B = nullptr;
+	int shape_A = 0;
+	int shape_B = 0;
+	if (!p_constraint->get_snapshot_pair(object_A, shape_A, object_B, shape_B)) {
+		return false;
+	}
+
+	r_swapped = object_B->get_self().get_id() < object_A->get_self().get_id();
+	if (r_swapped) {
+		SWAP(object_A, object_B);
+		SWAP(shape_A, shape_B);
+	}
+	r_key.rid_A = object_A->get_self().get_id();
+	r_key.rid_B = object_B->get_self().get_id();
+	r_key.shape_A = shape_A;
+	r_key.shape_B = shape_B;
+	return true;
+}
+
+static void _get_snapshot_constraints(const GodotCollisionObject3D *p_object, LocalVector<GodotConstraint3D *> &r_constraints) {
+	r_constraints.clear();
+	if (p_object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : static_cast<const GodotBody3D *>(p_object)->get_constraint_map()) {
+			r_constraints.push_back(E.key);
+		}
+	} else if (p_object->get_type() == GodotCollisionObject3D::TYPE_AREA) {
+		for (GodotConstraint3D *constraint : static_cast<const GodotArea3D *>(p_object)->get_constraints()) {
+			r_constraints.push_back(constraint);
+		}
+	}
+}
+
+static _FORCE_INLINE_ void _put_snapshot_entry_size(StreamPeerBuffer *r_buffer, int p_size_position) {
+	// Sizes are written once the entry is saved.
+	const int end_position = r_buffer->get_position();
+	r_buffer->seek(p_size_position);
+	r_buffer->put_u32(end_position - p_size_position - 4);
+	r_buffer->seek(end_position);
+}
+
+Vector<uint8_t> GodotSpace3D::get_snapshot() const {
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	buffer->put_u32(SPACE_SNAPSHOT_MAGIC);
+	buffer->put_u32(SPACE_SNAPSHOT_VERSION);
+
+	uint32_t body_count = 0;
+	for (const GodotCollisionObject3D *object : objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			body_count++;
+		}
+	}
+
+	buffer->put_u32(body_count);
+	for (const GodotCollisionObject3D *object : objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			buffer->put_u64(object->get_self().get_id());
+			buffer->put_u32(GodotBody3D::SNAPSHOT_SIZE);
+			static_cast<const GodotBody3D *>(object)->save_snapshot(buffer.ptr());
+		}
+	}
+
+	// Pairs are saved once, from the object with the lowest RID.
+	LocalVector<GodotConstraint3D *> object_constraints;
+	uint32_t pair_count = 0;
+	const int pair_count_position = buffer->get_position();
+	buffer->put_u32(0);
+	for (const GodotCollisionObject3D *object : objects) {
+		_get_snapshot_constraints(object, object_constraints);
+		for (const GodotConstraint3D *constraint : object_constraints) {
+			SpaceSnapshotPairKey3D key;
+			bool swapped = false;
+			if (!_get_snapshot_pair_key(constraint, key, swapped) || key.rid_A != object->get_self().get_id()) {
+				continue;
+			}
+
+			buffer->put_u64(key.rid_A);
+			buffer->put_32(key.shape_A);
+			buffer->put_u64(key.rid_B);
+			buffer->put_32(key.shape_B);
+			const int size_position = buffer->get_position();
+			buffer->put_u32(0);
+			constraint->save_snapshot_state(buffer.ptr(), swapped);
+			_put_snapshot_entry_size(buffer.ptr(), size_position);
+			pair_count++;
+		}
+	}
+	const int pairs_end = buffer->get_position();
+	buffer->seek(pair_count_position);
+	buffer->put_u32(pair_count);
+	buffer->seek(pairs_end);
+	return buffer->get_data_array();
+}
+
+void GodotSpace3D::set_snapshot(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_MSG(locked, "Can't restore a snapshot while the space is being stepped.");
+
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	buffer->set_data_array(p_snapshot);
+
+	// Validate the layout of the whole snapshot and find the bodies first, so nothing is restored from a broken snapshot.
+	ERR_FAIL_COND_MSG(buffer->get_available_bytes() < 12, "Invalid space snapshot.");
+	const uint32_t magic = buffer->get_u32();
+	ERR_FAIL_COND_MSG(magic != SPACE_SNAPSHOT_MAGIC, "Invalid space snapshot.");
+	const uint32_t version = buffer->get_u32();
+	ERR_FAIL_COND_MSG(version != SPACE_SNAPSHOT_VERSION, "Space snapshot was saved by an incompatible engine version.");
+
+	const uint32_t body_count = buffer->get_u32();
+	const int bodies_position = buffer->get_position();
+	const int body_entry_size = SPACE_SNAPSHOT_BODY_HEADER_SIZE + GodotBody3D::SNAPSHOT_SIZE;
+	ERR_FAIL_COND_MSG(body_count > uint32_t(buffer->get_available_bytes() / body_entry_size), "Invalid space snapshot.");
+
+	// Bodies are saved in the order of the space objects, so they are usually found in the same order here.
+	snapshot_bodies.resize(body_count);
+	HashMap<uint64_t, GodotBody3D *> body_map;
+	HashSet<GodotCollisionObject3D *>::Iterator object_it = objects.begin();
+	for (uint32_t body_index = 0; body_index < body_count; body_index++) {
+		const uint64_t rid = buffer->get_u64();
+		const uint32_t size = buffer->get_u32();
+		ERR_FAIL_COND_MSG(size != GodotBody3D::SNAPSHOT_SIZE, "Invalid space snapshot.");
+		buffer->seek(buffer->get_position() + GodotBody3D::SNAPSHOT_SIZE);
+
+		while (object_it != objects.end() && (*object_it)->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			++object_it;
+		}
+
+		GodotBody3D *body = nullptr;
+		if (object_it != objects.end() && (*object_it)->get_self().get_id() == rid) {
+			body = static_cast<GodotBody3D *>(*object_it);
+			++object_it;
+		} else {
+			if (body_map.is_empty()) {
+				for (GodotCollisionObject3D *object : objects) {
+					if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+						body_map.insert(object->get_self().get_id(), static_cast<GodotBody3D *>(object));
+					}
+				}
+			}
+			GodotBody3D **body_ptr = body_map.getptr(rid);
+			if (body_ptr) {
+				body = *body_ptr;
+			}
+		}
+		snapshot_bodies[body_index] = body;
+	}
+
+	ERR_FAIL_COND_MSG(buffer->get_available_bytes() < 4, "Invalid space snapshot.");
+	const uint32_t pair_count = buffer->get_u32();
+	const int pairs_position = buffer->get_position();
+	for (uint32_t pair_index = 0; pair_index < pair_count; pair_index++) {
+		ERR_FAIL_COND_MSG(buffer->get_available_bytes() < SPACE_SNAPSHOT_PAIR_HEADER_SIZE, "Invalid space snapshot.");
+		buffer->seek(buffer->get_position() + SPACE_SNAPSHOT_PAIR_HEADER_SIZE - 4);
+		const uint32_t size = buffer->get_u32();
+		ERR_FAIL_COND_MSG(size > uint32_t(buffer->get_available_bytes()), "Invalid space snapshot.");
+		buffer->seek(buffer->get_position() + size);
+	}
+	ERR_FAIL_COND_MSG(buffer->get_available_bytes() != 0, "Invalid space snapshot.");
+
+	// Restore the bodies. Bodies that aren't in the space anymore are skipped, bodies that weren't saved are left as they are.
+	for (uint32_t body_index = 0; body_index < body_count; body_index++) {
+		if (snapshot_bodies[body_index]) {
+			buffer->seek(bodies_position + body_index * body_entry_size + SPACE_SNAPSHOT_BODY_HEADER_SIZE);
+			snapshot_bodies[body_index]->load_snapshot(buffer.ptr());
+		}
+	}
+
+	// Update the broadphase so the collision pairs match the restored transforms.
+	update();
+
+	// Restore the state of the collision pairs. Pairs that weren't saved, or whose state can't be read, start
+	// from scratch like new pairs would.
+	HashMap<SpaceSnapshotPairKey3D, GodotConstraint3D *, SpaceSnapshotPairKey3D> pairs;
+	LocalVector<GodotConstraint3D *> object_constraints;
+	for (const GodotCollisionObject3D *object : objects) {
+		_get_snapshot_constraints(object, object_constraints);
+		for (GodotConstraint3D *constraint : object_constraints) {
+			SpaceSnapshotPairKey3D key;
+			bool swapped = false;
+			if (_get_snapshot_pair_key(constraint, key, swapped) && key.rid_A == object->get_self().get_id()) {
+				pairs.insert(key, constraint);
+			}
+		}
+	}
+
+	buffer->seek(pairs_position);
+	for (uint32_t pair_index = 0; pair_index < pair_count; pair_index++) {
+		SpaceSnapshotPairKey3D key;
+		key.rid_A = buffer->get_u64();
+		key.shape_A = buffer->get_32();
+		key.rid_B = buffer->get_u64();
+		key.shape_B = buffer->get_32();
+		const uint32_t size = buffer->get_u32();
+		const int state_position = buffer->get_position();
+
+		HashMap<SpaceSnapshotPairKey3D, GodotConstraint3D *, SpaceSnapshotPairKey3D>::Iterator E = pairs.find(key);
+		if (E) {
+			SpaceSnapshotPairKey3D pair_key;
+			bool swapped = false;
+			_get_snapshot_pair_key(E->value, pair_key, swapped);
+			if (!E->value->load_snapshot_state(buffer.ptr(), size, swapped)) {
+				E->value->reset_snapshot_state();
+			}
+			pairs.remove(E);
+		}
+		buffer->seek(state_position + size);
+	}
+
+	for (const KeyValue<SpaceSnapshotPairKey3D, GodotConstraint3D *> &E : pairs) {
+		E.value->reset_snapshot_state();
+	}
+}
+
 void GodotSpace3D::update() {
+	// Bodies change dormancy here rather than when they fall asleep or wake up,
+	// since that can happen in the middle of a step and changes the broadphase pairs.
+	while (dormant_update_list.first()) {
+		GodotBody3D *body = dormant_update_list.first()->self();
+		dormant_update_list.remove(dormant_update_list.first());
+		body->update_dormant();
+	}
+
 	broadphase->update();
 }
 
@@ -1208,6 +1508,9 @@ void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer3D::SPACE_PARAM_SOLVER_DETERMINISTIC:
+			deterministic = p_value;
+			break;
 	}
 }
 
@@ -1229,10 +1532,56 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 			return body_time_to_sleep;
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer3D::SPACE_PARAM_SOLVER_DETERMINISTIC:
+			return deterministic;
 	}
 	return 0;
 }
 
+uint32_t GodotSpace3D::get_state_hash() const {
+	// Hashes the simulated state of all bodies sorted by creation order, the iteration order
+	// of the objects set changes when objects are removed from the space.
+	LocalVector<const GodotCollisionObject3D *> sorted_objects;
+	sorted_objects.reserve(objects.size());
+	for (const GodotCollisionObject3D *object : objects) {
+		sorted_objects.push_back(object);
+	}
+	sorted_objects.sort_custom<CollisionObjectRIDComparator3D>();
+
+	uint32_t h = hash_murmur3_one_32(sorted_objects.size());
+	for (const GodotCollisionObject3D *object : sorted_objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			const GodotBody3D *body = static_cast<const GodotBody3D *>(object);
+			const Transform3D &transform = body->get_transform();
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					h = hash_murmur3_one_real(transform.basis.rows[i][j], h);
+				}
+				h = hash_murmur3_one_real(transform.origin[i], h);
+			}
+			const Vector3 linear_velocity = body->get_linear_velocity();
+			const Vector3 angular_velocity = body->get_angular_velocity();
+			for (int i = 0; i < 3; i++) {
+				h = hash_murmur3_one_real(linear_velocity[i], h);
+				h = hash_murmur3_one_real(angular_velocity[i], h);
+			}
+			h = hash_murmur3_one_32(body->is_active(), h);
+		} else if (object->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+			const GodotSoftBody3D *soft_body = static_cast<const GodotSoftBody3D *>(object);
+			uint32_t node_count = soft_body->get_node_count();
+			for (uint32_t node_index = 0; node_index < node_count; node_index++) {
+				const Vector3 position = soft_body->get_node_position(node_index);
+				const Vector3 velocity = soft_body->get_node_velocity(node_index);
+				for (int i = 0; i < 3; i++) {
+					h = hash_murmur3_one_real(position[i], h);
+					h = hash_murmur3_one_real(velocity[i], h);
+				}
+			}
+		}
+	}
+	return hash_fmix32(h);
+}
+
 void GodotSpace3D::lock() {
 	locked = true;
 }
@@ -1253,7 +1602,9 @@ GodotSpace3D::GodotSpace3D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/3d/time_before_sleep");
+	sleeping_bodies_dormant = GLOBAL_GET("physics/3d/sleeping_bodies_dormant");
 	solver_iterations = GLOBAL_GET("physics/3d/solver/solver_iterations");
+	deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
 	contact_recycle_radius = GLOBAL_GET("physics/3d/solver/contact_recycle_radius");
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
@@ -1267,7 +1618,25 @@ GodotSpace3D::GodotSpace3D() {
 	direct_access->space = this;
 }
 
+GodotSpace3D::RayBatchBuffers *GodotSpace3D::_acquire_ray_batch_buffers() {
+	MutexLock lock(ray_batch_buffers_mutex);
+	if (free_ray_batch_buffers.is_empty()) {
+		return memnew(RayBatchBuffers);
+	}
+	RayBatchBuffers *buffers = free_ray_batch_buffers[free_ray_batch_buffers.size() - 1];
+	free_ray_batch_buffers.resize(free_ray_batch_buffers.size() - 1);
+	return buffers;
+}
+
+void GodotSpace3D::_release_ray_batch_buffers(RayBatchBuffers *p_buffers) {
+	MutexLock lock(ray_batch_buffers_mutex);
+	free_ray_batch_buffers.push_back(p_buffers);
+}
+
 GodotSpace3D::~GodotSpace3D() {
+	for (RayBatchBuffers *buffers : free_ray_batch_buffers) {
+		memdelete(buffers);
+	}
 	memdelete(broadphase);
 	memdelete(direct_access);
 }
@@ -40,17 +40,23 @@
 #include "godot_soft_body_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	bool _intersect_ray_results(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_results, const int *p_subindex_results, int p_amount, RayResult &r_result) const;
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	// Unlike the other queries, this doesn't use the space's shared result buffers, so it can run on worker threads.
+	virtual int intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -64,6 +70,7 @@ class GodotSpace3D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_UPDATE_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
@@ -72,15 +79,28 @@ public:
 
 	};
 
+	enum IslandSize {
+		ISLAND_SIZE_SMALL,
+		ISLAND_SIZE_MEDIUM,
+		ISLAND_SIZE_LARGE,
+		ISLAND_SIZE_MAX
+	};
+
 private:
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
 
+	int constraint_count = 0;
+	int largest_island_size = 0;
+	int island_size_count[ISLAND_SIZE_MAX] = {};
+	LocalVector<uint64_t> thread_solve_time;
+
 	GodotPhysicsDirectSpaceState3D *direct_access = nullptr;
 	RID self;
 
 	GodotBroadPhase3D *broadphase = nullptr;
 	SelfList<GodotBody3D>::List active_list;
 	SelfList<GodotBody3D>::List mass_properties_update_list;
+	SelfList<GodotBody3D>::List dormant_update_list;
 	SelfList<GodotBody3D>::List state_query_list;
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
@@ -90,6 +110,7 @@ private:
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
 
 	HashSet<GodotCollisionObject3D *> objects;
+	LocalVector<GodotBody3D *> snapshot_bodies;
 
 	GodotArea3D *area = nullptr;
 
@@ -107,9 +128,23 @@ private:
 	GodotCollisionObject3D *intersection_query_results[INTERSECTION_QUERY_MAX];
 	int intersection_query_subindex_results[INTERSECTION_QUERY_MAX];
 
+	// Broadphase results of the ray batches. Batches can run on several threads at once,
+	// so each one takes its own buffers and gives them back once done.
+	struct RayBatchBuffers {
+		LocalVector<GodotCollisionObject3D *> results;
+		LocalVector<int> subindex_results;
+	};
+	Mutex ray_batch_buffers_mutex;
+	LocalVector<RayBatchBuffers *> free_ray_batch_buffers;
+
+	RayBatchBuffers *_acquire_ray_batch_buffers();
+	void _release_ray_batch_buffers(RayBatchBuffers *p_buffers);
+
 	real_t body_linear_velocity_sleep_threshold = 0.0;
 	real_t body_angular_velocity_sleep_threshold = 0.0;
 	real_t body_time_to_sleep = 0.0;
+	bool sleeping_bodies_dormant = false;
+	bool deterministic = false;
 
 	bool locked = false;
 
@@ -140,6 +175,8 @@ public:
 	void body_remove_from_active_list(SelfList<GodotBody3D> *p_body);
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
+	void body_add_to_dormant_update_list(SelfList<GodotBody3D> *p_body);
+	void body_remove_from_dormant_update_list(SelfList<GodotBody3D> *p_body);
 
 	void body_add_to_state_query_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_state_query_list(SelfList<GodotBody3D> *p_body);
@@ -168,6 +205,8 @@ public:
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
+	_FORCE_INLINE_ bool is_sleeping_bodies_dormant() const { return sleeping_bodies_dormant; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
 
 	void update();
 	void setup();
@@ -183,6 +222,11 @@ public:
 	void set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer3D::SpaceParameter p_param) const;
 
+	Vector<uint8_t> get_snapshot() const;
+	void set_snapshot(const Vector<uint8_t> &p_snapshot);
+
+	uint32_t get_state_hash() const;
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
@@ -209,6 +253,19 @@ public:
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
+	void set_constraint_count(int p_constraint_count) { constraint_count = p_constraint_count; }
+	int get_constraint_count() const { return constraint_count; }
+
+	void set_largest_island_size(int p_size) { largest_island_size = p_size; }
+	int get_largest_island_size() const { return largest_island_size; }
+
+	void set_island_size_count(IslandSize p_size, int p_count) { island_size_count[p_size] = p_count; }
+	int get_island_size_count(IslandSize p_size) const { return island_size_count[p_size]; }
+
+	// Time spent solving islands by each thread, the first one is the thread running the step.
+	void set_thread_solve_time(const LocalVector<uint64_t> &p_time) { thread_solve_time = p_time; }
+	const LocalVector<uint64_t> &get_thread_solve_time() const { return thread_solve_time; }
+
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
 
 	GodotSpace3D();
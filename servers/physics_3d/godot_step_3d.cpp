@@ -40,6 +40,34 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define SMALL_ISLAND_CONSTRAINT_COUNT 8
+#define LARGE_ISLAND_CONSTRAINT_COUNT 256
+#define CONSTRAINT_COLOR_TASK_MIN_SIZE 64
+#define CONSTRAINT_COLOR_MAX 64
+#define CONSTRAINT_BODY_MAX 4
+
+void GodotStep3D::_gather_active_bodies(const GodotSpace3D *p_space) {
+	active_bodies.clear();
+	const SelfList<GodotBody3D> *b = p_space->get_active_body_list().first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+
+	soft_bodies.clear();
+	const SelfList<GodotSoftBody3D> *sb = p_space->get_active_soft_body_list().first();
+	while (sb) {
+		soft_bodies.push_back(sb->self());
+		sb = sb->next();
+	}
+
+	if (p_space->is_deterministic()) {
+		// The order of the active lists depends on when bodies were woken up, sort them by creation order
+		// instead so islands are always built and solved in the same order for the same state.
+		active_bodies.sort_custom<CollisionObjectRIDComparator3D>();
+		soft_bodies.sort_custom<CollisionObjectRIDComparator3D>();
+	}
+}
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,6 +140,29 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_update_island_stats(GodotSpace3D *p_space, uint32_t p_island_count) const {
+	int largest_island_size = 0;
+	int island_size_count[GodotSpace3D::ISLAND_SIZE_MAX] = {};
+
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		int island_size = constraint_islands[island_index].size();
+		largest_island_size = MAX(largest_island_size, island_size);
+		if (island_size >= LARGE_ISLAND_CONSTRAINT_COUNT) {
+			island_size_count[GodotSpace3D::ISLAND_SIZE_LARGE]++;
+		} else if (island_size >= SMALL_ISLAND_CONSTRAINT_COUNT) {
+			island_size_count[GodotSpace3D::ISLAND_SIZE_MEDIUM]++;
+		} else {
+			island_size_count[GodotSpace3D::ISLAND_SIZE_SMALL]++;
+		}
+	}
+
+	p_space->set_constraint_count((int)all_constraints.size());
+	p_space->set_largest_island_size(largest_island_size);
+	for (int i = 0; i < GodotSpace3D::ISLAND_SIZE_MAX; i++) {
+		p_space->set_island_size_count(GodotSpace3D::IslandSize(i), island_size_count[i]);
+	}
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -131,6 +182,8 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 }
 
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
+	uint64_t solve_begtime = OS::get_singleton()->get_ticks_usec();
+
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
 	int current_priority = 1;
@@ -156,6 +209,141 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 		}
 		constraint_count = priority_constraint_count;
 	}
+
+	// Each thread only writes to its own entry.
+	thread_solve_time[WorkerThreadPool::get_singleton()->get_thread_index() + 1] += OS::get_singleton()->get_ticks_usec() - solve_begtime;
+}
+
+void GodotStep3D::_solve_small_island(uint32_t p_index, void *p_userdata) {
+	_solve_island(small_islands[p_index]);
+}
+
+void GodotStep3D::_color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	// Greedy graph coloring: constraints of the same color never share a dynamic body,
+	// so each color can be solved in parallel without changing the result.
+	body_color_masks.clear();
+	for (uint32_t color_index = 0; color_index < color_count; ++color_index) {
+		constraint_colors[color_index].clear();
+	}
+	color_count = 0;
+	uncolored_constraints.clear();
+
+	const GodotCollisionObject3D *constraint_bodies[CONSTRAINT_BODY_MAX];
+
+	uint32_t constraint_count = p_constraint_island.size();
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
+
+		if (constraint->get_body_count() + constraint->get_soft_body_count() > CONSTRAINT_BODY_MAX) {
+			uncolored_constraints.push_back(constraint);
+			continue;
+		}
+
+		int constraint_body_count = 0;
+		uint64_t used_colors = 0;
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			GodotBody3D *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				continue; // Only dynamic bodies are modified when solving.
+			}
+			constraint_bodies[constraint_body_count++] = body;
+		}
+		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+			constraint_bodies[constraint_body_count++] = constraint->get_soft_body_ptr(i);
+		}
+		for (int i = 0; i < constraint_body_count; i++) {
+			const uint64_t *body_colors = body_color_masks.getptr(constraint_bodies[i]);
+			if (body_colors) {
+				used_colors |= *body_colors;
+			}
+		}
+
+		uint32_t color = 0;
+		while (color < CONSTRAINT_COLOR_MAX && (used_colors & (uint64_t(1) << color))) {
+			++color;
+		}
+		if (color == CONSTRAINT_COLOR_MAX) {
+			// Solved after all colors on the calling thread.
+			uncolored_constraints.push_back(constraint);
+			continue;
+		}
+
+		for (int i = 0; i < constraint_body_count; i++) {
+			uint64_t *body_colors = body_color_masks.getptr(constraint_bodies[i]);
+			if (body_colors) {
+				*body_colors |= uint64_t(1) << color;
+			} else {
+				body_color_masks.insert(constraint_bodies[i], uint64_t(1) << color);
+			}
+		}
+
+		if (color >= color_count) {
+			color_count = color + 1;
+			if (constraint_colors.size() < color_count) {
+				constraint_colors.resize(color_count);
+			}
+		}
+		constraint_colors[color].push_back(constraint);
+	}
+}
+
+void GodotStep3D::_solve_constraint_color(uint32_t p_constraint_index, LocalVector<GodotConstraint3D *> *p_constraint_color) {
+	(*p_constraint_color)[p_constraint_index]->solve(delta);
+}
+
+void GodotStep3D::_solve_large_island(LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	_color_island(p_constraint_island);
+
+	int current_priority = 1;
+
+	uint32_t constraint_count = p_constraint_island.size();
+	while (constraint_count > 0) {
+		for (int i = 0; i < iterations; i++) {
+			// Go through all iterations, one color after the other.
+			for (uint32_t color_index = 0; color_index < color_count; ++color_index) {
+				LocalVector<GodotConstraint3D *> &constraint_color = constraint_colors[color_index];
+				if (constraint_color.size() < CONSTRAINT_COLOR_TASK_MIN_SIZE) {
+					for (GodotConstraint3D *constraint : constraint_color) {
+						constraint->solve(delta);
+					}
+				} else {
+					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_constraint_color, &constraint_color, constraint_color.size(), -1, true, SNAME("Physics3DConstraintSolveColor"));
+					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+				}
+			}
+			for (GodotConstraint3D *constraint : uncolored_constraints) {
+				constraint->solve(delta);
+			}
+		}
+
+		// Check priority to keep only higher priority constraints.
+		constraint_count = 0;
+		++current_priority;
+		for (uint32_t color_index = 0; color_index < color_count; ++color_index) {
+			LocalVector<GodotConstraint3D *> &constraint_color = constraint_colors[color_index];
+			uint32_t priority_constraint_count = 0;
+			for (GodotConstraint3D *constraint : constraint_color) {
+				if (constraint->get_priority() >= current_priority) {
+					// Keep this constraint for the next iteration.
+					constraint_color[priority_constraint_count++] = constraint;
+				}
+			}
+			constraint_color.resize(priority_constraint_count);
+			constraint_count += priority_constraint_count;
+		}
+		uint32_t priority_constraint_count = 0;
+		for (GodotConstraint3D *constraint : uncolored_constraints) {
+			if (constraint->get_priority() >= current_priority) {
+				uncolored_constraints[priority_constraint_count++] = constraint;
+			}
+		}
+		uncolored_constraints.resize(priority_constraint_count);
+		constraint_count += priority_constraint_count;
+	}
+}
+
+void GodotStep3D::_solve_soft_body(uint32_t p_index, void *p_userdata) {
+	soft_bodies[p_index]->solve_constraints(delta);
 }
 
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
@@ -221,12 +409,20 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	p_space->set_active_objects(active_count);
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
+	/* UPDATE BROADPHASE */
+
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_UPDATE_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -260,13 +456,11 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	_gather_active_bodies(p_space);
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody3D *body = b->self();
-
+	for (GodotBody3D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -294,15 +488,11 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		b = b->next();
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
-
+	for (GodotSoftBody3D *soft_body : soft_bodies) {
 		if (soft_body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -330,10 +520,10 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		sb = sb->next();
 	}
 
 	p_space->set_island_count((int)island_count);
+	_update_island_stats(p_space, island_count);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -362,10 +552,48 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	thread_solve_time.resize(WorkerThreadPool::get_singleton()->get_thread_count() + 1);
+	for (uint64_t &time : thread_solve_time) {
+		time = 0;
+	}
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	// Large islands are always solved by color, even without worker threads, so the solve order
+	// of their constraints doesn't depend on the thread count.
+	large_islands.clear();
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		if (constraint_islands[island_index].size() >= LARGE_ISLAND_CONSTRAINT_COUNT) {
+			large_islands.push_back(island_index);
+		}
+	}
+
+	if (large_islands.is_empty()) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		// A single large island would keep one thread busy for the whole solve,
+		// so its constraints are split by color and solved in parallel instead.
+		small_islands.clear();
+		uint32_t large_island_index = 0;
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			if (large_island_index < large_islands.size() && large_islands[large_island_index] == island_index) {
+				++large_island_index;
+			} else {
+				small_islands.push_back(island_index);
+			}
+		}
+
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_small_island, nullptr, small_islands.size(), -1, true, SNAME("Physics3DConstraintSolveIslands"));
+		uint64_t solve_begtime = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t island_index : large_islands) {
+			_solve_large_island(constraint_islands[island_index]);
+		}
+		thread_solve_time[WorkerThreadPool::get_singleton()->get_thread_index() + 1] += OS::get_singleton()->get_ticks_usec() - solve_begtime;
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	p_space->set_thread_solve_time(thread_solve_time);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -375,11 +603,12 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// Bodies can be activated while solving, and the order of integration determines the order in which
+	// new collision pairs are created on the next step.
+	_gather_active_bodies(p_space);
+
+	for (GodotBody3D *body : active_bodies) {
+		body->integrate_velocities(p_delta);
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -390,12 +619,31 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
+	// Solve soft bodies in parallel when there are enough of them to keep all threads busy,
+	// otherwise solve them one by one and let large soft bodies split their links across threads.
+	uint32_t thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	bool parallel_soft_bodies = soft_bodies.size() > 1;
+	if (parallel_soft_bodies && soft_bodies.size() < thread_count) {
+		for (GodotSoftBody3D *soft_body : soft_bodies) {
+			if (soft_body->has_parallel_links()) {
+				parallel_soft_bodies = false;
+				break;
+			}
+		}
+	}
+
+	if (parallel_soft_bodies) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body, nullptr, soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodySolve"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (GodotSoftBody3D *soft_body : soft_bodies) {
+			soft_body->solve_constraints(p_delta, thread_count > 1);
+		}
 	}
 
+	active_bodies.clear();
+	soft_bodies.clear();
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
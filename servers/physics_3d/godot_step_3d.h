@@ -33,6 +33,7 @@
 
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -45,11 +46,30 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	LocalVector<uint32_t> small_islands;
+	LocalVector<uint32_t> large_islands;
+	LocalVector<LocalVector<GodotConstraint3D *>> constraint_colors;
+	LocalVector<GodotConstraint3D *> uncolored_constraints;
+	HashMap<const GodotCollisionObject3D *, uint64_t> body_color_masks;
+	uint32_t color_count = 0;
+
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotSoftBody3D *> soft_bodies;
+
+	LocalVector<uint64_t> thread_solve_time;
+
+	void _gather_active_bodies(const GodotSpace3D *p_space);
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _update_island_stats(GodotSpace3D *p_space, uint32_t p_island_count) const;
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _solve_small_island(uint32_t p_index, void *p_userdata = nullptr);
+	void _color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_constraint_color(uint32_t p_constraint_index, LocalVector<GodotConstraint3D *> *p_constraint_color);
+	void _solve_large_island(LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_soft_body(uint32_t p_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
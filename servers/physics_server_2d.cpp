@@ -636,6 +636,8 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_get_snapshot", "space"), &PhysicsServer2D::space_get_snapshot);
+	ClassDB::bind_method(D_METHOD("space_set_snapshot", "space", "snapshot"), &PhysicsServer2D::space_set_snapshot);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
@@ -797,6 +799,7 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(SPACE_PARAM_BODY_TIME_TO_SLEEP);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_SOLVER_ITERATIONS);
+	BIND_ENUM_CONSTANT(SPACE_PARAM_CCD_MAX_SUBSTEPS);
 
 	BIND_ENUM_CONSTANT(SHAPE_WORLD_BOUNDARY);
 	BIND_ENUM_CONSTANT(SHAPE_SEPARATION_RAY);
@@ -876,6 +879,19 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_CONSTRAINT_COUNT);
+	BIND_ENUM_CONSTANT(INFO_LARGEST_ISLAND_SIZE);
+	BIND_ENUM_CONSTANT(INFO_SMALL_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_MEDIUM_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_LARGE_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_STEP_TIME);
+	BIND_ENUM_CONSTANT(INFO_INTEGRATE_FORCES_TIME);
+	BIND_ENUM_CONSTANT(INFO_UPDATE_BROADPHASE_TIME);
+	BIND_ENUM_CONSTANT(INFO_GENERATE_ISLANDS_TIME);
+	BIND_ENUM_CONSTANT(INFO_SETUP_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(INFO_SOLVE_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(INFO_INTEGRATE_VELOCITIES_TIME);
+	BIND_ENUM_CONSTANT(INFO_SOLVE_ITERATION_TIME);
 }
 
 PhysicsServer2D::PhysicsServer2D() {
@@ -892,6 +908,7 @@ PhysicsServer2D::PhysicsServer2D() {
 	GLOBAL_DEF("physics/2d/sleep_threshold_angular", Math::deg_to_rad(8.0));
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 0.5);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/2d/solver/solver_iterations", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), 16);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/2d/solver/ccd_max_substeps", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), 1);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_recycle_radius", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), 1.0);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), 1.5);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.01,10,0.01,or_greater"), 0.3);
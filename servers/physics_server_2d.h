@@ -264,6 +264,7 @@ public:
 		SPACE_PARAM_BODY_TIME_TO_SLEEP,
 		SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS,
 		SPACE_PARAM_SOLVER_ITERATIONS,
+		SPACE_PARAM_CCD_MAX_SUBSTEPS,
 	};
 
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
@@ -276,6 +277,9 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const = 0;
+	virtual void space_set_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -593,7 +597,20 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_CONSTRAINT_COUNT,
+		INFO_LARGEST_ISLAND_SIZE,
+		INFO_SMALL_ISLAND_COUNT,
+		INFO_MEDIUM_ISLAND_COUNT,
+		INFO_LARGE_ISLAND_COUNT,
+		INFO_STEP_TIME,
+		INFO_INTEGRATE_FORCES_TIME,
+		INFO_UPDATE_BROADPHASE_TIME,
+		INFO_GENERATE_ISLANDS_TIME,
+		INFO_SETUP_CONSTRAINTS_TIME,
+		INFO_SOLVE_CONSTRAINTS_TIME,
+		INFO_INTEGRATE_VELOCITIES_TIME,
+		INFO_SOLVE_ITERATION_TIME
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -125,6 +125,9 @@ public:
 		return physics_server_2d->space_get_contact_count(p_space);
 	}
 
+	FUNC1RC(Vector<uint8_t>, space_get_snapshot, RID);
+	FUNC2(space_set_snapshot, RID, const Vector<uint8_t> &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -123,6 +123,7 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(const Ref<PhysicsRayQueryParameters3D> &p_ray_query);
+	Dictionary _intersect_ray_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
@@ -159,6 +160,10 @@ public:
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
 
+	// Casts many rays sharing the same parameters (except from and to) at once, r_hits tells which rays hit.
+	// The default implementation calls intersect_ray() for each ray, so it is not thread-safe unless the physics server's intersect_ray() is.
+	virtual int intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits);
+
 	struct ShapeResult {
 		RID rid;
 		ObjectID collider_id;
@@ -294,6 +299,7 @@ public:
 		SPACE_PARAM_BODY_ANGULAR_VELOCITY_SLEEP_THRESHOLD,
 		SPACE_PARAM_BODY_TIME_TO_SLEEP,
 		SPACE_PARAM_SOLVER_ITERATIONS,
+		SPACE_PARAM_SOLVER_DETERMINISTIC,
 	};
 
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
@@ -306,6 +312,11 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const = 0;
+	virtual void space_set_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) = 0;
+
+	virtual uint32_t space_get_state_hash(RID p_space) const = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -805,7 +816,20 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_CONSTRAINT_COUNT,
+		INFO_LARGEST_ISLAND_SIZE,
+		INFO_SMALL_ISLAND_COUNT,
+		INFO_MEDIUM_ISLAND_COUNT,
+		INFO_LARGE_ISLAND_COUNT,
+		INFO_STEP_TIME,
+		INFO_INTEGRATE_FORCES_TIME,
+		INFO_UPDATE_BROADPHASE_TIME,
+		INFO_GENERATE_ISLANDS_TIME,
+		INFO_SETUP_CONSTRAINTS_TIME,
+		INFO_SOLVE_CONSTRAINTS_TIME,
+		INFO_INTEGRATE_VELOCITIES_TIME,
+		INFO_SOLVE_ITERATION_TIME
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
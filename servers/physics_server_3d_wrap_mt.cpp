@@ -36,11 +36,43 @@ void PhysicsServer3DWrapMT::thread_exit() {
 	exit = true;
 }
 
-void PhysicsServer3DWrapMT::thread_step(real_t p_delta) {
+void PhysicsServer3DWrapMT::thread_step(real_t p_delta, const Vector<RID> &p_read_bodies) {
 	physics_server_3d->step(p_delta);
+	_update_body_state_back(p_read_bodies);
 	step_sem.post();
 }
 
+void PhysicsServer3DWrapMT::_update_body_state_back(const Vector<RID> &p_bodies) {
+	body_state_back->clear();
+
+	for (const RID &body : p_bodies) {
+		BodyStateCache &state = body_state_back->insert(body, BodyStateCache())->value;
+		state.transform = physics_server_3d->body_get_state(body, BODY_STATE_TRANSFORM);
+		state.linear_velocity = physics_server_3d->body_get_state(body, BODY_STATE_LINEAR_VELOCITY);
+		state.angular_velocity = physics_server_3d->body_get_state(body, BODY_STATE_ANGULAR_VELOCITY);
+		state.sleeping = physics_server_3d->body_get_state(body, BODY_STATE_SLEEPING);
+		state.can_sleep = physics_server_3d->body_get_state(body, BODY_STATE_CAN_SLEEP);
+	}
+}
+
+void PhysicsServer3DWrapMT::_invalidate_body_state(RID p_body) {
+	// The front buffer is only used from the main thread, other threads always read from the server.
+	if (create_thread && Thread::get_caller_id() == main_thread) {
+		body_state_front->erase(p_body);
+		body_state_invalidated.insert(p_body);
+	}
+}
+
+void PhysicsServer3DWrapMT::_track_body_state_callback(RID p_body, const Callable &p_callable) {
+	if (create_thread && Thread::get_caller_id() == main_thread) {
+		// Only forgotten when the body is freed, in case it still has the other callback.
+		if (p_callable.is_valid()) {
+			body_state_callback_bodies.insert(p_body);
+		}
+		_invalidate_body_state(p_body);
+	}
+}
+
 void PhysicsServer3DWrapMT::_thread_callback(void *_instance) {
 	PhysicsServer3DWrapMT *vsmt = reinterpret_cast<PhysicsServer3DWrapMT *>(_instance);
 
@@ -64,11 +96,90 @@ void PhysicsServer3DWrapMT::thread_loop() {
 	physics_server_3d->finish();
 }
 
+/* BODY STATE */
+
+Variant PhysicsServer3DWrapMT::body_get_state(RID p_body, BodyState p_state) const {
+	if (Thread::get_caller_id() == server_thread) {
+		command_queue.flush_if_pending();
+		return physics_server_3d->body_get_state(p_body, p_state);
+	}
+
+	if (Thread::get_caller_id() == main_thread && !body_state_direct_access) {
+		const BodyStateCache *state = body_state_front->getptr(p_body);
+		if (state) {
+			body_state_read.insert(p_body);
+			switch (p_state) {
+				case BODY_STATE_TRANSFORM:
+					return state->transform;
+				case BODY_STATE_LINEAR_VELOCITY:
+					return state->linear_velocity;
+				case BODY_STATE_ANGULAR_VELOCITY:
+					return state->angular_velocity;
+				case BODY_STATE_SLEEPING:
+					return state->sleeping;
+				case BODY_STATE_CAN_SLEEP:
+					return state->can_sleep;
+			}
+		}
+	}
+
+	Variant ret;
+	command_queue.push_and_ret(physics_server_3d, &PhysicsServer3D::body_get_state, p_body, p_state, &ret);
+
+	if (Thread::get_caller_id() == main_thread && ret.get_type() != Variant::NIL) {
+		// Keep the state of this body after the next step, so the next reads don't have to wait.
+		body_state_read.insert(p_body);
+	}
+
+	return ret;
+}
+
+void PhysicsServer3DWrapMT::space_set_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	if (create_thread && Thread::get_caller_id() == main_thread) {
+		body_state_front->clear();
+		body_state_invalidated_all = true;
+	}
+
+	if (Thread::get_caller_id() != server_thread) {
+		command_queue.push(physics_server_3d, &PhysicsServer3D::space_set_snapshot, p_space, p_snapshot);
+	} else {
+		command_queue.flush_if_pending();
+		physics_server_3d->space_set_snapshot(p_space, p_snapshot);
+	}
+}
+
+void PhysicsServer3DWrapMT::free(RID p_rid) {
+	_invalidate_body_state(p_rid);
+	if (create_thread && Thread::get_caller_id() == main_thread) {
+		body_state_read.erase(p_rid);
+		body_state_callback_bodies.erase(p_rid);
+	}
+
+	if (Thread::get_caller_id() != server_thread) {
+		command_queue.push(physics_server_3d, &PhysicsServer3D::free, p_rid);
+	} else {
+		command_queue.flush_if_pending();
+		physics_server_3d->free(p_rid);
+	}
+}
+
 /* EVENT QUEUING */
 
 void PhysicsServer3DWrapMT::step(real_t p_step) {
 	if (create_thread) {
-		command_queue.push(this, &PhysicsServer3DWrapMT::thread_step, p_step);
+		// The changes made until now are run before this step, so its body states include them.
+		body_state_invalidated.clear();
+		body_state_invalidated_all = false;
+
+		Vector<RID> read_bodies;
+		read_bodies.resize(body_state_read.size());
+		int i = 0;
+		for (const RID &body : body_state_read) {
+			read_bodies.write[i++] = body;
+		}
+		body_state_read.clear();
+
+		command_queue.push(this, &PhysicsServer3DWrapMT::thread_step, p_step, read_bodies);
 	} else {
 		command_queue.flush_all(); //flush all pending from other threads
 		physics_server_3d->step(p_step);
@@ -81,13 +192,28 @@ void PhysicsServer3DWrapMT::sync() {
 			first_frame = false;
 		} else {
 			step_sem.wait(); //must not wait if a step was not issued
+			SWAP(body_state_front, body_state_back);
+		}
+
+		if (body_state_invalidated_all) {
+			body_state_front->clear();
+		} else {
+			for (const RID &body : body_state_invalidated) {
+				body_state_front->erase(body);
+			}
 		}
 	}
 	physics_server_3d->sync();
 }
 
 void PhysicsServer3DWrapMT::flush_queries() {
+	body_state_direct_access = true;
 	physics_server_3d->flush_queries();
+	body_state_direct_access = false;
+
+	for (const RID &body : body_state_callback_bodies) {
+		_invalidate_body_state(body);
+	}
 }
 
 void PhysicsServer3DWrapMT::end_sync() {
@@ -116,7 +242,7 @@ void PhysicsServer3DWrapMT::finish() {
 }
 
 PhysicsServer3DWrapMT::PhysicsServer3DWrapMT(PhysicsServer3D *p_contained, bool p_create_thread) :
-		command_queue(p_create_thread) {
+		command_queue(p_create_thread, true) {
 	physics_server_3d = p_contained;
 	create_thread = p_create_thread;
 
@@ -34,6 +34,8 @@
 #include "core/config/project_settings.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 #include "servers/physics_server_3d.h"
 
 #ifdef DEBUG_SYNC
@@ -58,7 +60,7 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	bool create_thread = false;
 
 	Semaphore step_sem;
-	void thread_step(real_t p_delta);
+	void thread_step(real_t p_delta, const Vector<RID> &p_read_bodies);
 
 	void thread_exit();
 
@@ -67,6 +69,40 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	Mutex alloc_mutex;
 	int pool_max_size = 0;
 
+	struct BodyStateCache {
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		bool sleeping = false;
+		bool can_sleep = false;
+	};
+
+	// Bodies whose state was read from the main thread since the last step was issued. Only the state of these
+	// bodies is kept after the next step, so bodies that are no longer read stop being copied.
+	mutable HashSet<RID> body_state_read;
+
+	// State of those bodies after the last completed step, so reading it doesn't have to wait for the
+	// server thread. The back buffer is written by the server thread at the end of each step, and swapped
+	// with the front one in sync(), once that step is known to be done.
+	HashMap<RID, BodyStateCache> body_state_buffers[2];
+	HashMap<RID, BodyStateCache> *body_state_front = &body_state_buffers[0];
+	HashMap<RID, BodyStateCache> *body_state_back = &body_state_buffers[1];
+
+	// Bodies changed or freed from the main thread after the last step was issued. That step fills the back
+	// buffer with their old state, so they are removed from the new front buffer in sync() as well.
+	HashSet<RID> body_state_invalidated;
+	bool body_state_invalidated_all = false;
+
+	// Bodies with a state sync or force integration callback. Those get the direct state of the body
+	// in flush_queries() and can change it, so their kept state is dropped afterwards.
+	HashSet<RID> body_state_callback_bodies;
+	// Set during flush_queries(), the kept state is not used while direct states can be changed.
+	bool body_state_direct_access = false;
+
+	void _update_body_state_back(const Vector<RID> &p_bodies);
+	void _invalidate_body_state(RID p_body);
+	void _track_body_state_callback(RID p_body, const Callable &p_callable);
+
 public:
 #define ServerName PhysicsServer3D
 #define ServerNameWrapMT PhysicsServer3DWrapMT
@@ -75,6 +111,29 @@ public:
 
 #include "servers/server_wrap_mt_common.h"
 
+// Like FUNC2 and FUNC3, for setters that change the state of the body right away.
+#define FUNC2BS(m_type, m_arg1, m_arg2)                                   \
+	virtual void m_type(m_arg1 p1, m_arg2 p2) override {                  \
+		_invalidate_body_state(p1);                                       \
+		if (Thread::get_caller_id() != server_thread) {                   \
+			command_queue.push(server_name, &ServerName::m_type, p1, p2); \
+		} else {                                                          \
+			command_queue.flush_if_pending();                             \
+			server_name->m_type(p1, p2);                                  \
+		}                                                                 \
+	}
+
+#define FUNC3BS(m_type, m_arg1, m_arg2, m_arg3)                               \
+	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) override {           \
+		_invalidate_body_state(p1);                                           \
+		if (Thread::get_caller_id() != server_thread) {                       \
+			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3); \
+		} else {                                                              \
+			command_queue.flush_if_pending();                                 \
+			server_name->m_type(p1, p2, p3);                                  \
+		}                                                                     \
+	}
+
 	//FUNC1RID(shape,ShapeType); todo fix
 	FUNCRID(world_boundary_shape)
 	FUNCRID(separation_ray_shape)
@@ -129,6 +188,11 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	FUNC1RC(Vector<uint8_t>, space_get_snapshot, RID);
+	virtual void space_set_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override;
+
+	FUNC1RC(uint32_t, space_get_state_hash, RID);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -174,10 +238,10 @@ public:
 	//FUNC2RID(body,BodyMode,bool);
 	FUNCRID(body)
 
-	FUNC2(body_set_space, RID, RID);
+	FUNC2BS(body_set_space, RID, RID);
 	FUNC1RC(RID, body_get_space, RID);
 
-	FUNC2(body_set_mode, RID, BodyMode);
+	FUNC2BS(body_set_mode, RID, BodyMode);
 	FUNC1RC(BodyMode, body_get_mode, RID);
 
 	FUNC4(body_add_shape, RID, RID, const Transform3D &, bool);
@@ -216,12 +280,12 @@ public:
 
 	FUNC1(body_reset_mass_properties, RID);
 
-	FUNC3(body_set_state, RID, BodyState, const Variant &);
-	FUNC2RC(Variant, body_get_state, RID, BodyState);
+	FUNC3BS(body_set_state, RID, BodyState, const Variant &);
+	virtual Variant body_get_state(RID p_body, BodyState p_state) const override;
 
-	FUNC2(body_apply_torque_impulse, RID, const Vector3 &);
-	FUNC2(body_apply_central_impulse, RID, const Vector3 &);
-	FUNC3(body_apply_impulse, RID, const Vector3 &, const Vector3 &);
+	FUNC2BS(body_apply_torque_impulse, RID, const Vector3 &);
+	FUNC2BS(body_apply_central_impulse, RID, const Vector3 &);
+	FUNC3BS(body_apply_impulse, RID, const Vector3 &, const Vector3 &);
 
 	FUNC2(body_apply_central_force, RID, const Vector3 &);
 	FUNC3(body_apply_force, RID, const Vector3 &, const Vector3 &);
@@ -237,9 +301,9 @@ public:
 	FUNC2(body_set_constant_torque, RID, const Vector3 &);
 	FUNC1RC(Vector3, body_get_constant_torque, RID);
 
-	FUNC2(body_set_axis_velocity, RID, const Vector3 &);
+	FUNC2BS(body_set_axis_velocity, RID, const Vector3 &);
 
-	FUNC3(body_set_axis_lock, RID, BodyAxis, bool);
+	FUNC3BS(body_set_axis_lock, RID, BodyAxis, bool);
 	FUNC2RC(bool, body_is_axis_locked, RID, BodyAxis);
 
 	FUNC2(body_add_collision_exception, RID, RID);
@@ -255,8 +319,25 @@ public:
 	FUNC2(body_set_omit_force_integration, RID, bool);
 	FUNC1RC(bool, body_is_omitting_force_integration, RID);
 
-	FUNC2(body_set_state_sync_callback, RID, const Callable &);
-	FUNC3(body_set_force_integration_callback, RID, const Callable &, const Variant &);
+	virtual void body_set_state_sync_callback(RID p_body, const Callable &p_callable) override {
+		_track_body_state_callback(p_body, p_callable);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_state_sync_callback, p_body, p_callable);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_set_state_sync_callback(p_body, p_callable);
+		}
+	}
+
+	virtual void body_set_force_integration_callback(RID p_body, const Callable &p_callable, const Variant &p_udata = Variant()) override {
+		_track_body_state_callback(p_body, p_callable);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_force_integration_callback, p_body, p_callable, p_udata);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_set_force_integration_callback(p_body, p_callable, p_udata);
+		}
+	}
 
 	FUNC2(body_set_ray_pickable, RID, bool);
 
@@ -268,6 +349,8 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), nullptr);
+		// The body can be changed through its direct state.
+		_invalidate_body_state(p_body);
 		return physics_server_3d->body_get_direct_state(p_body);
 	}
 
@@ -380,7 +463,7 @@ public:
 
 	/* MISC */
 
-	FUNC1(free, RID);
+	virtual void free(RID p_rid) override;
 	FUNC1(set_active, bool);
 
 	virtual void init() override;
@@ -401,6 +484,8 @@ public:
 	PhysicsServer3DWrapMT(PhysicsServer3D *p_contained, bool p_create_thread);
 	~PhysicsServer3DWrapMT();
 
+#undef FUNC2BS
+#undef FUNC3BS
 #undef ServerNameWrapMT
 #undef ServerName
 #undef server_name
@@ -31,6 +31,7 @@
 #include "renderer_canvas_cull.h"
 
 #include "core/math/geometry_2d.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -42,8 +43,25 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, canvas_cull_mask);
+	if (p_child_item_count >= CULL_THREAD_MIN_ITEMS && !cull_threaded) {
+		LocalVector<Item *> items;
+		items.resize(p_child_item_count);
+		for (int i = 0; i < p_child_item_count; i++) {
+			items[i] = p_child_items[i].item;
+		}
+
+		CullThreadData td;
+		td.items = items.ptr();
+		td.item_count = items.size();
+		td.transform = p_transform;
+		td.clip_rect = p_clip_rect;
+		td.modulate = Color(1, 1, 1, 1);
+		td.canvas_cull_mask = canvas_cull_mask;
+		_cull_canvas_items_threaded(td, z_list, z_last_list);
+	} else {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, canvas_cull_mask);
+		}
 	}
 	if (p_canvas_item) {
 		_cull_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, canvas_cull_mask);
@@ -213,7 +231,9 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
+				visibility_notifier_list_lock.lock();
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+				visibility_notifier_list_lock.unlock();
 				ci->visibility_notifier->just_visible = true;
 			}
 
@@ -238,7 +258,8 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		ci->children_order_dirty = false;
 	}
 
-	Rect2 rect = ci->get_rect();
+	// While culling on worker threads, rects that depend on the storage were already refreshed by _update_canvas_item_storage_rects().
+	Rect2 rect = (storage_rects_updated && ci->storage_rect_element.in_list()) ? ci->rect : ci->get_rect();
 
 	if (ci->visibility_notifier) {
 		if (ci->visibility_notifier->area.size != Vector2()) {
@@ -316,8 +337,21 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			SortArray<Item *, ItemPtrSort> sorter;
 			sorter.sort(child_items, child_item_count);
 
-			for (i = 0; i < child_item_count; i++) {
-				_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, canvas_cull_mask);
+			if (child_item_count >= CULL_THREAD_MIN_ITEMS && !cull_threaded) {
+				CullThreadData td;
+				td.items = child_items;
+				td.item_count = child_item_count;
+				td.transform = xform;
+				td.clip_rect = p_clip_rect;
+				td.modulate = modulate;
+				td.canvas_clip = (Item *)ci->final_clip_owner;
+				td.y_sorted = true;
+				td.canvas_cull_mask = canvas_cull_mask;
+				_cull_canvas_items_threaded(td, r_z_list, r_z_last_list);
+			} else {
+				for (i = 0; i < child_item_count; i++) {
+					_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, canvas_cull_mask);
+				}
 			}
 		} else {
 			RendererCanvasRender::Item *canvas_group_from = nullptr;
@@ -344,11 +378,97 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, canvas_cull_mask);
 		}
 		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from, xform);
-		for (int i = 0; i < child_item_count; i++) {
-			if (child_items[i]->behind || use_canvas_group) {
+		if (!use_canvas_group && child_item_count >= CULL_THREAD_MIN_ITEMS && !cull_threaded) {
+			CullThreadData td;
+			td.items = child_items;
+			td.item_count = child_item_count;
+			td.transform = xform;
+			td.clip_rect = p_clip_rect;
+			td.modulate = modulate;
+			td.z = p_z;
+			td.canvas_clip = (Item *)ci->final_clip_owner;
+			td.material_owner = p_material_owner;
+			td.skip_behind = true;
+			td.canvas_cull_mask = canvas_cull_mask;
+			_cull_canvas_items_threaded(td, r_z_list, r_z_last_list);
+		} else {
+			for (int i = 0; i < child_item_count; i++) {
+				if (child_items[i]->behind || use_canvas_group) {
+					continue;
+				}
+				_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, canvas_cull_mask);
+			}
+		}
+	}
+}
+
+void RendererCanvasCull::_update_canvas_item_storage_rects() {
+	// Only these rects read the mesh, multimesh or particles storage, the others are computed from their commands alone.
+	for (SelfList<Item> *E = storage_rect_list.first(); E; E = E->next()) {
+		E->self()->get_rect();
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_items_chunk(uint32_t p_chunk, CullThreadData *p_data) {
+	RendererCanvasRender::Item **chunk_z_list = &thread_z_lists[p_chunk * z_range * 2];
+	RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+	memset(chunk_z_list, 0, z_range * 2 * sizeof(RendererCanvasRender::Item *));
+
+	uint32_t from = p_chunk * p_data->item_count / p_data->chunk_count;
+	uint32_t to = (p_chunk + 1 == p_data->chunk_count) ? p_data->item_count : ((p_chunk + 1) * p_data->item_count / p_data->chunk_count);
+
+	for (uint32_t i = from; i < to; i++) {
+		Item *item = p_data->items[i];
+		if (p_data->y_sorted) {
+			_cull_canvas_item(item, p_data->transform * item->ysort_xform, p_data->clip_rect, p_data->modulate * item->ysort_modulate, item->ysort_parent_abs_z_index, chunk_z_list, chunk_z_last_list, p_data->canvas_clip, (Item *)item->material_owner, false, p_data->canvas_cull_mask);
+		} else if (!p_data->skip_behind || !item->behind) {
+			_cull_canvas_item(item, p_data->transform, p_data->clip_rect, p_data->modulate, p_data->z, chunk_z_list, chunk_z_last_list, p_data->canvas_clip, p_data->material_owner, true, p_data->canvas_cull_mask);
+		}
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_items_threaded(CullThreadData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+	// Each chunk of siblings is culled into its own z lists, which are then appended in order,
+	// so the result is exactly the same as culling the siblings one after another.
+	// Rects that depend on the mesh, multimesh or particles storage are refreshed here first,
+	// as reading the storage isn't thread-safe.
+	p_data.chunk_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), p_data.item_count / CULL_THREAD_ITEMS_PER_CHUNK);
+	if (p_data.chunk_count < 2) {
+		p_data.chunk_count = 1;
+	}
+
+	if (thread_z_lists.size() < p_data.chunk_count * z_range * 2) {
+		thread_z_lists.resize(p_data.chunk_count * z_range * 2);
+	}
+
+	// Subtrees of items culled on a worker thread are always culled serially.
+	cull_threaded = true;
+	if (p_data.chunk_count > 1) {
+		_update_canvas_item_storage_rects();
+		storage_rects_updated = true;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_items_chunk, &p_data, p_data.chunk_count, -1, true, SNAME("RenderCanvasCull"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		storage_rects_updated = false;
+	} else {
+		_cull_canvas_items_chunk(0, &p_data);
+	}
+	cull_threaded = false;
+
+	for (uint32_t i = 0; i < p_data.chunk_count; i++) {
+		RendererCanvasRender::Item **chunk_z_list = &thread_z_lists[i * z_range * 2];
+		RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+
+		for (int j = 0; j < z_range; j++) {
+			if (!chunk_z_list[j]) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, canvas_cull_mask);
+
+			if (r_z_last_list[j]) {
+				r_z_last_list[j]->next = chunk_z_list[j];
+			} else {
+				r_z_list[j] = chunk_z_list[j];
+			}
+			r_z_last_list[j] = chunk_z_last_list[j];
 		}
 	}
 }
@@ -1433,6 +1553,8 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 
 	m->transform = p_transform;
 	m->modulate = p_modulate;
+
+	_canvas_item_track_storage_rect(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture) {
@@ -1445,6 +1567,8 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 
 	part->texture = p_texture;
 
+	_canvas_item_track_storage_rect(canvas_item);
+
 	//take the chance and request processing for them, at least once until they become visible again
 	RSG::particles_storage->particles_request_process(p_particles);
 }
@@ -1458,6 +1582,8 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 	mm->multimesh = p_mesh;
 
 	mm->texture = p_texture;
+
+	_canvas_item_track_storage_rect(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
@@ -1557,6 +1683,9 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->clear();
+	if (canvas_item->storage_rect_element.in_list()) {
+		storage_rect_list.remove(&canvas_item->storage_rect_element);
+	}
 }
 
 void RendererCanvasCull::canvas_item_set_draw_index(RID p_item, int p_index) {
@@ -31,6 +31,8 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
@@ -72,7 +74,10 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
-		Item() {
+		SelfList<Item> storage_rect_element; // In the list while the item has commands whose rect comes from the storage.
+
+		Item() :
+				storage_rect_element(this) {
 			children_order_dirty = true;
 			E = nullptr;
 			z_index = 0;
@@ -176,6 +181,7 @@ public:
 
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
+	SpinLock visibility_notifier_list_lock;
 
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &xform, const Rect2 &p_clip_rect, Rect2 global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *canvas_group_from, const Transform2D &p_xform);
 
@@ -188,6 +194,41 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	enum {
+		CULL_THREAD_MIN_ITEMS = 256, // Minimum amount of sibling items for their subtrees to be culled in parallel.
+		CULL_THREAD_ITEMS_PER_CHUNK = 64,
+	};
+
+	struct CullThreadData {
+		Item **items = nullptr;
+		uint32_t item_count = 0;
+		uint32_t chunk_count = 0;
+		Transform2D transform;
+		Rect2 clip_rect;
+		Color modulate;
+		int z = 0;
+		Item *canvas_clip = nullptr;
+		Item *material_owner = nullptr;
+		bool y_sorted = false;
+		bool skip_behind = false;
+		uint32_t canvas_cull_mask = 0;
+	};
+
+	bool cull_threaded = false;
+	bool storage_rects_updated = false;
+	LocalVector<RendererCanvasRender::Item *> thread_z_lists;
+	SelfList<Item>::List storage_rect_list;
+
+	_FORCE_INLINE_ void _canvas_item_track_storage_rect(Item *p_canvas_item) {
+		if (!p_canvas_item->storage_rect_element.in_list()) {
+			storage_rect_list.add(&p_canvas_item->storage_rect_element);
+		}
+	}
+
+	void _update_canvas_item_storage_rects();
+	void _cull_canvas_items_chunk(uint32_t p_chunk, CullThreadData *p_data);
+	void _cull_canvas_items_threaded(CullThreadData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list);
+
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask);
 
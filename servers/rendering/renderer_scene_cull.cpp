@@ -141,6 +141,7 @@ void RendererSceneCull::_instance_pair(Instance *p_A, Instance *p_B) {
 
 		geom->lights.insert(B);
 		light->geometries.insert(A);
+		light->shadow_casters_dirty = true;
 
 		if (geom->can_cast_shadows) {
 			light->shadow_dirty = true;
@@ -248,6 +249,7 @@ void RendererSceneCull::_instance_unpair(Instance *p_A, Instance *p_B) {
 
 		geom->lights.erase(B);
 		light->geometries.erase(A);
+		light->shadow_casters_dirty = true; // Don't keep a pointer to the geometry.
 
 		if (geom->can_cast_shadows) {
 			light->shadow_dirty = true;
@@ -1551,6 +1553,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		RSG::light_storage->light_instance_set_transform(light->instance, p_instance->transform);
 		RSG::light_storage->light_instance_set_aabb(light->instance, p_instance->transform.xform(p_instance->aabb));
 		light->shadow_dirty = true;
+		light->shadow_casters_dirty = true;
 
 		RS::LightBakeMode bake_mode = RSG::light_storage->light_get_bake_mode(p_instance->base);
 		if (RSG::light_storage->light_get_type(p_instance->base) != RS::LIGHT_DIRECTIONAL && bake_mode != light->bake_mode) {
@@ -1636,6 +1639,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			for (const Instance *E : geom->lights) {
 				InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
 				light->shadow_dirty = true;
+				light->shadow_casters_dirty = true;
 			}
 		}
 
@@ -2276,6 +2280,42 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
+const LocalVector<RendererSceneCull::Instance *> &RendererSceneCull::_light_instance_cull_shadow_casters(InstanceLightData *p_light, uint32_t p_pass, Scenario *p_scenario, const Vector<Plane> &p_planes) {
+	LocalVector<Instance *> &shadow_casters = p_light->shadow_casters[p_pass];
+	if (!p_light->shadow_casters_dirty) {
+		return shadow_casters;
+	}
+
+	shadow_casters.clear();
+
+	Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&p_planes[0], p_planes.size());
+
+	struct CullConvex {
+		LocalVector<Instance *> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			result->push_back(p_instance);
+			return false;
+		}
+	};
+
+	CullConvex cull_convex;
+	cull_convex.result = &shadow_casters;
+
+	p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(p_planes.ptr(), p_planes.size(), points.ptr(), points.size(), cull_convex);
+
+	// Pairing uses the scaled light transform and its cull mask, the shadow frustums don't.
+	// Geometry found outside of the pairs could be freed without notice, so the result is not kept.
+	for (Instance *instance : shadow_casters) {
+		if (!p_light->geometries.has(instance)) {
+			p_light->shadow_casters_unpaired = true;
+			break;
+		}
+	}
+
+	return shadow_casters;
+}
+
 bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
@@ -2310,28 +2350,12 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+					const LocalVector<Instance *> &shadow_casters = _light_instance_cull_shadow_casters(light, i, p_scenario, planes);
 
 					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
 
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
+					for (uint32_t j = 0; j < shadow_casters.size(); j++) {
+						Instance *instance = shadow_casters[j];
 						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
 							continue;
 						} else {
@@ -2388,28 +2412,12 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+					const LocalVector<Instance *> &shadow_casters = _light_instance_cull_shadow_casters(light, i, p_scenario, planes);
 
 					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
 
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
+					for (uint32_t j = 0; j < shadow_casters.size(); j++) {
+						Instance *instance = shadow_casters[j];
 						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
 							continue;
 						} else {
@@ -2451,28 +2459,12 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
 
-			instance_shadow_cull_result.clear();
-
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
-
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
-
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+			const LocalVector<Instance *> &shadow_casters = _light_instance_cull_shadow_casters(light, 0, p_scenario, planes);
 
 			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
 
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
+			for (uint32_t j = 0; j < shadow_casters.size(); j++) {
+				Instance *instance = shadow_casters[j];
 				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
 					continue;
 				} else {
@@ -2496,6 +2488,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 		} break;
 	}
 
+	light->shadow_casters_dirty = light->shadow_casters_unpaired;
+	light->shadow_casters_unpaired = false;
+
 	return animated_material_found;
 }
 
@@ -2695,6 +2690,82 @@ void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_d
 	_scene_cull(*cull_data, scene_cull_result_threads[p_thread], cull_from, cull_to);
 }
 
+void RendererSceneCull::_cull_block_frustum(const Frustum &p_frustum, const real_t (*p_bounds)[CULL_BLOCK_SIZE], uint32_t p_count, uint8_t *r_inside) {
+	// Same test as InstanceBounds::in_frustum(), but one plane at a time over the whole block,
+	// without branches, so the inner loop can be vectorized.
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_inside[i] = 1;
+	}
+
+	for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const PlaneSign &sign = p_frustum.plane_signs_ptr[i];
+		const real_t *min_x = p_bounds[sign.signs[0]];
+		const real_t *min_y = p_bounds[sign.signs[1]];
+		const real_t *min_z = p_bounds[sign.signs[2]];
+
+		for (uint32_t j = 0; j < p_count; j++) {
+			real_t distance = plane.normal.x * min_x[j] + plane.normal.y * min_y[j] + plane.normal.z * min_z[j] - plane.d;
+			r_inside[j] &= uint8_t(distance < 0.0);
+		}
+	}
+}
+
+uint32_t RendererSceneCull::_scene_cull_block(const CullData &cull_data, uint64_t p_from, uint32_t p_count, uint32_t *r_candidates) {
+	// Find the instances of the block which can end up in any of the cull results, so that
+	// _scene_cull() only runs its per-instance logic on those. The bounds are copied to
+	// one array per component so the frustum planes can be tested on the whole block at once.
+	real_t bounds[6][CULL_BLOCK_SIZE];
+	uint8_t layer_visible[CULL_BLOCK_SIZE];
+	uint8_t ignore_culling[CULL_BLOCK_SIZE];
+	uint8_t candidate[CULL_BLOCK_SIZE];
+	uint8_t inside[CULL_BLOCK_SIZE];
+
+	const PagedArray<InstanceBounds> &instance_aabbs = cull_data.scenario->instance_aabbs;
+	const PagedArray<InstanceData> &instance_data = cull_data.scenario->instance_data;
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		const InstanceBounds &instance_bounds = instance_aabbs[p_from + i];
+		for (uint32_t j = 0; j < 6; j++) {
+			bounds[j][i] = instance_bounds.bounds[j];
+		}
+
+		const InstanceData &idata = instance_data[p_from + i];
+		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
+		bool hidden = visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN;
+		layer_visible[i] = uint8_t(!hidden && (cull_data.visible_layers & idata.layer_mask));
+		ignore_culling[i] = uint8_t(!hidden && (idata.flags & InstanceData::FLAG_IGNORE_ALL_CULLING));
+	}
+
+	_cull_block_frustum(cull_data.cull->frustum, bounds, p_count, inside);
+	for (uint32_t i = 0; i < p_count; i++) {
+		candidate[i] = (layer_visible[i] & inside[i]) | ignore_culling[i];
+	}
+
+	for (uint32_t i = 0; i < cull_data.cull->shadow_count; i++) {
+		for (uint32_t j = 0; j < cull_data.cull->shadows[i].cascade_count; j++) {
+			_cull_block_frustum(cull_data.cull->shadows[i].cascades[j].frustum, bounds, p_count, inside);
+			for (uint32_t k = 0; k < p_count; k++) {
+				candidate[k] |= layer_visible[k] & inside[k];
+			}
+		}
+	}
+
+	// SDFGI regions are rare and ignore the visibility dependencies, test them as before.
+	for (uint32_t i = 0; i < cull_data.cull->sdfgi.region_count; i++) {
+		for (uint32_t j = 0; j < p_count; j++) {
+			candidate[j] |= uint8_t(instance_aabbs[p_from + j].in_aabb(cull_data.cull->sdfgi.region_aabb[i]));
+		}
+	}
+
+	uint32_t candidate_count = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_candidates[candidate_count] = i;
+		candidate_count += candidate[i];
+	}
+	return candidate_count;
+}
+
 void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to) {
 	uint64_t frame_number = RSG::rasterizer->get_frame_number();
 	float lightmap_probe_update_speed = RSG::light_storage->lightmap_get_probe_capture_update_speed() * RSG::rasterizer->get_frame_delta_time();
@@ -2707,12 +2778,18 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
-	for (uint64_t i = p_from; i < p_to; i++) {
-		bool mesh_visible = false;
+	uint32_t candidates[CULL_BLOCK_SIZE];
+	for (uint64_t block_from = p_from; block_from < p_to; block_from += CULL_BLOCK_SIZE) {
+		uint32_t block_count = MIN(p_to - block_from, (uint64_t)CULL_BLOCK_SIZE);
+		uint32_t candidate_count = _scene_cull_block(cull_data, block_from, block_count, candidates);
 
-		InstanceData &idata = cull_data.scenario->instance_data[i];
-		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
-		int32_t visibility_check = -1;
+		for (uint32_t candidate_index = 0; candidate_index < candidate_count; candidate_index++) {
+			uint64_t i = block_from + candidates[candidate_index];
+			bool mesh_visible = false;
+
+			InstanceData &idata = cull_data.scenario->instance_data[i];
+			uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
+			int32_t visibility_check = -1;
 
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
@@ -2722,210 +2799,210 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
 
-		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
-				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
-				if (base_type == RS::INSTANCE_LIGHT) {
-					cull_result.lights.push_back(idata.instance);
-					cull_result.light_instances.push_back(RID::from_uint64(idata.instance_data_rid));
-					if (cull_data.shadow_atlas.is_valid() && RSG::light_storage->light_has_shadow(idata.base_rid)) {
-						RSG::light_storage->light_instance_mark_visible(RID::from_uint64(idata.instance_data_rid)); //mark it visible for shadow allocation later
-					}
+			if (!HIDDEN_BY_VISIBILITY_CHECKS) {
+				if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+					uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
+					if (base_type == RS::INSTANCE_LIGHT) {
+						cull_result.lights.push_back(idata.instance);
+						cull_result.light_instances.push_back(RID::from_uint64(idata.instance_data_rid));
+						if (cull_data.shadow_atlas.is_valid() && RSG::light_storage->light_has_shadow(idata.base_rid)) {
+							RSG::light_storage->light_instance_mark_visible(RID::from_uint64(idata.instance_data_rid)); //mark it visible for shadow allocation later
+						}
 
-				} else if (base_type == RS::INSTANCE_REFLECTION_PROBE) {
-					if (cull_data.render_reflection_probe != idata.instance) {
-						//avoid entering The Matrix
+					} else if (base_type == RS::INSTANCE_REFLECTION_PROBE) {
+						if (cull_data.render_reflection_probe != idata.instance) {
+							//avoid entering The Matrix
 
-						if ((idata.flags & InstanceData::FLAG_REFLECTION_PROBE_DIRTY) || RSG::light_storage->reflection_probe_instance_needs_redraw(RID::from_uint64(idata.instance_data_rid))) {
-							InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(idata.instance->base_data);
-							cull_data.cull->lock.lock();
-							if (!reflection_probe->update_list.in_list()) {
-								reflection_probe->render_step = 0;
-								reflection_probe_render_list.add_last(&reflection_probe->update_list);
+							if ((idata.flags & InstanceData::FLAG_REFLECTION_PROBE_DIRTY) || RSG::light_storage->reflection_probe_instance_needs_redraw(RID::from_uint64(idata.instance_data_rid))) {
+								InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(idata.instance->base_data);
+								cull_data.cull->lock.lock();
+								if (!reflection_probe->update_list.in_list()) {
+									reflection_probe->render_step = 0;
+									reflection_probe_render_list.add_last(&reflection_probe->update_list);
+								}
+								cull_data.cull->lock.unlock();
+
+								idata.flags &= ~uint32_t(InstanceData::FLAG_REFLECTION_PROBE_DIRTY);
 							}
-							cull_data.cull->lock.unlock();
 
-							idata.flags &= ~uint32_t(InstanceData::FLAG_REFLECTION_PROBE_DIRTY);
+							if (RSG::light_storage->reflection_probe_instance_has_reflection(RID::from_uint64(idata.instance_data_rid))) {
+								cull_result.reflections.push_back(RID::from_uint64(idata.instance_data_rid));
+							}
 						}
+					} else if (base_type == RS::INSTANCE_DECAL) {
+						cull_result.decals.push_back(RID::from_uint64(idata.instance_data_rid));
 
-						if (RSG::light_storage->reflection_probe_instance_has_reflection(RID::from_uint64(idata.instance_data_rid))) {
-							cull_result.reflections.push_back(RID::from_uint64(idata.instance_data_rid));
+					} else if (base_type == RS::INSTANCE_VOXEL_GI) {
+						InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(idata.instance->base_data);
+						cull_data.cull->lock.lock();
+						if (!voxel_gi->update_element.in_list()) {
+							voxel_gi_update_list.add(&voxel_gi->update_element);
 						}
-					}
-				} else if (base_type == RS::INSTANCE_DECAL) {
-					cull_result.decals.push_back(RID::from_uint64(idata.instance_data_rid));
-
-				} else if (base_type == RS::INSTANCE_VOXEL_GI) {
-					InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(idata.instance->base_data);
-					cull_data.cull->lock.lock();
-					if (!voxel_gi->update_element.in_list()) {
-						voxel_gi_update_list.add(&voxel_gi->update_element);
-					}
-					cull_data.cull->lock.unlock();
-					cull_result.voxel_gi_instances.push_back(RID::from_uint64(idata.instance_data_rid));
-
-				} else if (base_type == RS::INSTANCE_LIGHTMAP) {
-					cull_result.lightmaps.push_back(RID::from_uint64(idata.instance_data_rid));
-				} else if (base_type == RS::INSTANCE_FOG_VOLUME) {
-					cull_result.fog_volumes.push_back(RID::from_uint64(idata.instance_data_rid));
-				} else if (base_type == RS::INSTANCE_VISIBLITY_NOTIFIER) {
-					InstanceVisibilityNotifierData *vnd = idata.visibility_notifier;
-					if (!vnd->list_element.in_list()) {
-						visible_notifier_list_lock.lock();
-						visible_notifier_list.add(&vnd->list_element);
-						visible_notifier_list_lock.unlock();
-						vnd->just_visible = true;
-					}
-					vnd->visible_in_frame = RSG::rasterizer->get_frame_number();
-				} else if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && !(idata.flags & InstanceData::FLAG_CAST_SHADOWS_ONLY)) {
-					bool keep = true;
-
-					if (idata.flags & InstanceData::FLAG_REDRAW_IF_VISIBLE) {
-						RenderingServerDefault::redraw_request();
-					}
+						cull_data.cull->lock.unlock();
+						cull_result.voxel_gi_instances.push_back(RID::from_uint64(idata.instance_data_rid));
+
+					} else if (base_type == RS::INSTANCE_LIGHTMAP) {
+						cull_result.lightmaps.push_back(RID::from_uint64(idata.instance_data_rid));
+					} else if (base_type == RS::INSTANCE_FOG_VOLUME) {
+						cull_result.fog_volumes.push_back(RID::from_uint64(idata.instance_data_rid));
+					} else if (base_type == RS::INSTANCE_VISIBLITY_NOTIFIER) {
+						InstanceVisibilityNotifierData *vnd = idata.visibility_notifier;
+						if (!vnd->list_element.in_list()) {
+							visible_notifier_list_lock.lock();
+							visible_notifier_list.add(&vnd->list_element);
+							visible_notifier_list_lock.unlock();
+							vnd->just_visible = true;
+						}
+						vnd->visible_in_frame = RSG::rasterizer->get_frame_number();
+					} else if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && !(idata.flags & InstanceData::FLAG_CAST_SHADOWS_ONLY)) {
+						bool keep = true;
 
-					if (base_type == RS::INSTANCE_MESH) {
-						mesh_visible = true;
-					} else if (base_type == RS::INSTANCE_PARTICLES) {
-						//particles visible? process them
-						if (RSG::particles_storage->particles_is_inactive(idata.base_rid)) {
-							//but if nothing is going on, don't do it.
-							keep = false;
-						} else {
-							cull_data.cull->lock.lock();
-							RSG::particles_storage->particles_request_process(idata.base_rid);
-							cull_data.cull->lock.unlock();
-							RSG::particles_storage->particles_set_view_axis(idata.base_rid, -cull_data.cam_transform.basis.get_column(2).normalized(), cull_data.cam_transform.basis.get_column(1).normalized());
-							//particles visible? request redraw
+						if (idata.flags & InstanceData::FLAG_REDRAW_IF_VISIBLE) {
 							RenderingServerDefault::redraw_request();
 						}
-					}
 
-					if (idata.parent_array_index != -1) {
-						float fade = 1.0f;
-						const uint32_t &parent_flags = cull_data.scenario->instance_data[idata.parent_array_index].flags;
-						if (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN) {
-							const int32_t &parent_idx = cull_data.scenario->instance_data[idata.parent_array_index].visibility_index;
-							fade = cull_data.scenario->instance_visibility[parent_idx].children_fade_alpha;
+						if (base_type == RS::INSTANCE_MESH) {
+							mesh_visible = true;
+						} else if (base_type == RS::INSTANCE_PARTICLES) {
+							//particles visible? process them
+							if (RSG::particles_storage->particles_is_inactive(idata.base_rid)) {
+								//but if nothing is going on, don't do it.
+								keep = false;
+							} else {
+								cull_data.cull->lock.lock();
+								RSG::particles_storage->particles_request_process(idata.base_rid);
+								cull_data.cull->lock.unlock();
+								RSG::particles_storage->particles_set_view_axis(idata.base_rid, -cull_data.cam_transform.basis.get_column(2).normalized(), cull_data.cam_transform.basis.get_column(1).normalized());
+								//particles visible? request redraw
+								RenderingServerDefault::redraw_request();
+							}
 						}
-						idata.instance_geometry->set_parent_fade_alpha(fade);
-					}
-
-					if (geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT) && (idata.flags & InstanceData::FLAG_GEOM_LIGHTING_DIRTY)) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						uint32_t idx = 0;
 
-						for (const Instance *E : geom->lights) {
-							InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
-							instance_pair_buffer[idx++] = light->instance;
-							if (idx == MAX_INSTANCE_PAIRS) {
-								break;
+						if (idata.parent_array_index != -1) {
+							float fade = 1.0f;
+							const uint32_t &parent_flags = cull_data.scenario->instance_data[idata.parent_array_index].flags;
+							if (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN) {
+								const int32_t &parent_idx = cull_data.scenario->instance_data[idata.parent_array_index].visibility_index;
+								fade = cull_data.scenario->instance_visibility[parent_idx].children_fade_alpha;
 							}
+							idata.instance_geometry->set_parent_fade_alpha(fade);
 						}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						geom->geometry_instance->pair_light_instances(instance_pair_buffer, idx);
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_LIGHTING_DIRTY);
-					}
+						if (geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT) && (idata.flags & InstanceData::FLAG_GEOM_LIGHTING_DIRTY)) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							uint32_t idx = 0;
 
-					if (idata.flags & InstanceData::FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							for (const Instance *E : geom->lights) {
+								InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
+								instance_pair_buffer[idx++] = light->instance;
+								if (idx == MAX_INSTANCE_PAIRS) {
+									break;
+								}
+							}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						cull_data.cull->lock.lock();
-						geom->geometry_instance->set_softshadow_projector_pairing(geom->softshadow_count > 0, geom->projector_count > 0);
-						cull_data.cull->lock.unlock();
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY);
-					}
+							ERR_FAIL_NULL(geom->geometry_instance);
+							geom->geometry_instance->pair_light_instances(instance_pair_buffer, idx);
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_LIGHTING_DIRTY);
+						}
 
-					if (geometry_instance_pair_mask & (1 << RS::INSTANCE_REFLECTION_PROBE) && (idata.flags & InstanceData::FLAG_GEOM_REFLECTION_DIRTY)) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						uint32_t idx = 0;
+						if (idata.flags & InstanceData::FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
 
-						for (const Instance *E : geom->reflection_probes) {
-							InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->base_data);
+							ERR_FAIL_NULL(geom->geometry_instance);
+							cull_data.cull->lock.lock();
+							geom->geometry_instance->set_softshadow_projector_pairing(geom->softshadow_count > 0, geom->projector_count > 0);
+							cull_data.cull->lock.unlock();
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY);
+						}
+
+						if (geometry_instance_pair_mask & (1 << RS::INSTANCE_REFLECTION_PROBE) && (idata.flags & InstanceData::FLAG_GEOM_REFLECTION_DIRTY)) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							uint32_t idx = 0;
 
-							instance_pair_buffer[idx++] = reflection_probe->instance;
-							if (idx == MAX_INSTANCE_PAIRS) {
-								break;
+							for (const Instance *E : geom->reflection_probes) {
+								InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->base_data);
+
+								instance_pair_buffer[idx++] = reflection_probe->instance;
+								if (idx == MAX_INSTANCE_PAIRS) {
+									break;
+								}
 							}
-						}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						geom->geometry_instance->pair_reflection_probe_instances(instance_pair_buffer, idx);
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_REFLECTION_DIRTY);
-					}
+							ERR_FAIL_NULL(geom->geometry_instance);
+							geom->geometry_instance->pair_reflection_probe_instances(instance_pair_buffer, idx);
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_REFLECTION_DIRTY);
+						}
 
-					if (geometry_instance_pair_mask & (1 << RS::INSTANCE_DECAL) && (idata.flags & InstanceData::FLAG_GEOM_DECAL_DIRTY)) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						uint32_t idx = 0;
+						if (geometry_instance_pair_mask & (1 << RS::INSTANCE_DECAL) && (idata.flags & InstanceData::FLAG_GEOM_DECAL_DIRTY)) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							uint32_t idx = 0;
 
-						for (const Instance *E : geom->decals) {
-							InstanceDecalData *decal = static_cast<InstanceDecalData *>(E->base_data);
+							for (const Instance *E : geom->decals) {
+								InstanceDecalData *decal = static_cast<InstanceDecalData *>(E->base_data);
 
-							instance_pair_buffer[idx++] = decal->instance;
-							if (idx == MAX_INSTANCE_PAIRS) {
-								break;
+								instance_pair_buffer[idx++] = decal->instance;
+								if (idx == MAX_INSTANCE_PAIRS) {
+									break;
+								}
 							}
-						}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						geom->geometry_instance->pair_decal_instances(instance_pair_buffer, idx);
+							ERR_FAIL_NULL(geom->geometry_instance);
+							geom->geometry_instance->pair_decal_instances(instance_pair_buffer, idx);
 
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_DECAL_DIRTY);
-					}
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_DECAL_DIRTY);
+						}
 
-					if (idata.flags & InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						uint32_t idx = 0;
-						for (const Instance *E : geom->voxel_gi_instances) {
-							InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(E->base_data);
+						if (idata.flags & InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							uint32_t idx = 0;
+							for (const Instance *E : geom->voxel_gi_instances) {
+								InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(E->base_data);
 
-							instance_pair_buffer[idx++] = voxel_gi->probe_instance;
-							if (idx == MAX_INSTANCE_PAIRS) {
-								break;
+								instance_pair_buffer[idx++] = voxel_gi->probe_instance;
+								if (idx == MAX_INSTANCE_PAIRS) {
+									break;
+								}
 							}
-						}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						geom->geometry_instance->pair_voxel_gi_instances(instance_pair_buffer, idx);
+							ERR_FAIL_NULL(geom->geometry_instance);
+							geom->geometry_instance->pair_voxel_gi_instances(instance_pair_buffer, idx);
 
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY);
-					}
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY);
+						}
 
-					if ((idata.flags & InstanceData::FLAG_LIGHTMAP_CAPTURE) && idata.instance->last_frame_pass != frame_number && !idata.instance->lightmap_target_sh.is_empty() && !idata.instance->lightmap_sh.is_empty()) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						Color *sh = idata.instance->lightmap_sh.ptrw();
-						const Color *target_sh = idata.instance->lightmap_target_sh.ptr();
-						for (uint32_t j = 0; j < 9; j++) {
-							sh[j] = sh[j].lerp(target_sh[j], MIN(1.0, lightmap_probe_update_speed));
+						if ((idata.flags & InstanceData::FLAG_LIGHTMAP_CAPTURE) && idata.instance->last_frame_pass != frame_number && !idata.instance->lightmap_target_sh.is_empty() && !idata.instance->lightmap_sh.is_empty()) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							Color *sh = idata.instance->lightmap_sh.ptrw();
+							const Color *target_sh = idata.instance->lightmap_target_sh.ptr();
+							for (uint32_t j = 0; j < 9; j++) {
+								sh[j] = sh[j].lerp(target_sh[j], MIN(1.0, lightmap_probe_update_speed));
+							}
+							ERR_FAIL_NULL(geom->geometry_instance);
+							cull_data.cull->lock.lock();
+							geom->geometry_instance->set_lightmap_capture(sh);
+							cull_data.cull->lock.unlock();
+							idata.instance->last_frame_pass = frame_number;
 						}
-						ERR_FAIL_NULL(geom->geometry_instance);
-						cull_data.cull->lock.lock();
-						geom->geometry_instance->set_lightmap_capture(sh);
-						cull_data.cull->lock.unlock();
-						idata.instance->last_frame_pass = frame_number;
-					}
 
-					if (keep) {
-						cull_result.geometry_instances.push_back(idata.instance_geometry);
+						if (keep) {
+							cull_result.geometry_instances.push_back(idata.instance_geometry);
+						}
 					}
 				}
-			}
 
-			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
-				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
-						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
+				for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+					for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+						if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
+							uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
-						if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS && LAYER_CHECK) {
-							cull_result.directional_shadows[j].cascade_geometry_instances[k].push_back(idata.instance_geometry);
-							mesh_visible = true;
+							if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS && LAYER_CHECK) {
+								cull_result.directional_shadows[j].cascade_geometry_instances[k].push_back(idata.instance_geometry);
+								mesh_visible = true;
+							}
 						}
 					}
 				}
 			}
-		}
 
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
@@ -2935,30 +3012,31 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #undef VIS_CHECK
 #undef OCCLUSION_CULLED
 
-		for (uint32_t j = 0; j < cull_data.cull->sdfgi.region_count; j++) {
-			if (cull_data.scenario->instance_aabbs[i].in_aabb(cull_data.cull->sdfgi.region_aabb[j])) {
-				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
-
-				if (base_type == RS::INSTANCE_LIGHT) {
-					InstanceLightData *instance_light = (InstanceLightData *)idata.instance->base_data;
-					if (instance_light->bake_mode == RS::LIGHT_BAKE_STATIC && cull_data.cull->sdfgi.region_cascade[j] <= instance_light->max_sdfgi_cascade) {
-						if (sdfgi_last_light_index != i || sdfgi_last_light_cascade != cull_data.cull->sdfgi.region_cascade[j]) {
-							sdfgi_last_light_index = i;
-							sdfgi_last_light_cascade = cull_data.cull->sdfgi.region_cascade[j];
-							cull_result.sdfgi_cascade_lights[sdfgi_last_light_cascade].push_back(instance_light->instance);
+			for (uint32_t j = 0; j < cull_data.cull->sdfgi.region_count; j++) {
+				if (cull_data.scenario->instance_aabbs[i].in_aabb(cull_data.cull->sdfgi.region_aabb[j])) {
+					uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
+
+					if (base_type == RS::INSTANCE_LIGHT) {
+						InstanceLightData *instance_light = (InstanceLightData *)idata.instance->base_data;
+						if (instance_light->bake_mode == RS::LIGHT_BAKE_STATIC && cull_data.cull->sdfgi.region_cascade[j] <= instance_light->max_sdfgi_cascade) {
+							if (sdfgi_last_light_index != i || sdfgi_last_light_cascade != cull_data.cull->sdfgi.region_cascade[j]) {
+								sdfgi_last_light_index = i;
+								sdfgi_last_light_cascade = cull_data.cull->sdfgi.region_cascade[j];
+								cull_result.sdfgi_cascade_lights[sdfgi_last_light_cascade].push_back(instance_light->instance);
+							}
+						}
+					} else if ((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+						if (idata.flags & InstanceData::FLAG_USES_BAKED_LIGHT) {
+							cull_result.sdfgi_region_geometry_instances[j].push_back(idata.instance_geometry);
+							mesh_visible = true;
 						}
-					}
-				} else if ((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-					if (idata.flags & InstanceData::FLAG_USES_BAKED_LIGHT) {
-						cull_result.sdfgi_region_geometry_instances[j].push_back(idata.instance_geometry);
-						mesh_visible = true;
 					}
 				}
 			}
-		}
 
-		if (mesh_visible && cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_USES_MESH_INSTANCE) {
-			cull_result.mesh_instances.push_back(cull_data.scenario->instance_data[i].instance->mesh_instance);
+			if (mesh_visible && cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_USES_MESH_INSTANCE) {
+				cull_result.mesh_instances.push_back(cull_data.scenario->instance_data[i].instance->mesh_instance);
+			}
 		}
 	}
 }
@@ -3928,6 +4006,7 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 				for (const Instance *E : geom->lights) {
 					InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
 					light->shadow_dirty = true;
+					light->shadow_casters_dirty = true;
 				}
 
 				geom->can_cast_shadows = can_cast_shadows;
@@ -4129,7 +4208,6 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -4159,7 +4237,6 @@ RendererSceneCull::RendererSceneCull() {
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
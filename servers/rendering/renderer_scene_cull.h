@@ -54,7 +54,8 @@ public:
 		SDFGI_MAX_CASCADES = 8,
 		SDFGI_MAX_REGIONS_PER_CASCADE = 3,
 		MAX_INSTANCE_PAIRS = 32,
-		MAX_UPDATE_SHADOWS = 512
+		MAX_UPDATE_SHADOWS = 512,
+		CULL_BLOCK_SIZE = 256
 	};
 
 	uint64_t render_pass;
@@ -682,6 +683,13 @@ public:
 
 		HashSet<Instance *> geometries;
 
+		// Geometry found in each shadow pass (omni sides or the spot frustum) the last time it was culled.
+		// Kept until the light or a geometry paired with it changes, so unchanged shadows are not culled again.
+		LocalVector<Instance *> shadow_casters[6];
+		bool shadow_casters_dirty = true;
+		// Set when a pass found geometry not paired with the light, whose changes and removal are not reported to it.
+		bool shadow_casters_unpaired = false;
+
 		Instance *baked_light = nullptr;
 
 		RS::LightBakeMode bake_mode;
@@ -814,7 +822,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
@@ -1011,6 +1018,7 @@ public:
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
+	const LocalVector<Instance *> &_light_instance_cull_shadow_casters(InstanceLightData *p_light, uint32_t p_pass, Scenario *p_scenario, const Vector<Plane> &p_planes);
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
@@ -1079,6 +1087,8 @@ public:
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
+	static void _cull_block_frustum(const Frustum &p_frustum, const real_t (*p_bounds)[CULL_BLOCK_SIZE], uint32_t p_count, uint8_t *r_inside);
+	uint32_t _scene_cull_block(const CullData &cull_data, uint64_t p_from, uint32_t p_count, uint32_t *r_candidates);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
 
@@ -40,7 +40,7 @@
 
 // careful, these may run in different threads than the rendering server
 
-int RenderingServerDefault::changes = 0;
+SafeNumeric<int> RenderingServerDefault::changes;
 
 /* FREE */
 
@@ -72,7 +72,7 @@ void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
 	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
 
-	changes = 0;
+	changes.set(0);
 
 	RSG::rasterizer->begin_frame(frame_step);
 
@@ -202,7 +202,7 @@ double RenderingServerDefault::get_frame_setup_time_cpu() const {
 }
 
 bool RenderingServerDefault::has_changed() const {
-	return changes > 0;
+	return changes.get() > 0;
 }
 
 void RenderingServerDefault::_init() {
@@ -34,6 +34,7 @@
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
 #include "renderer_canvas_cull.h"
 #include "renderer_scene_cull.h"
 #include "renderer_viewport.h"
@@ -55,7 +56,7 @@ class RenderingServerDefault : public RenderingServer {
 
 	};
 
-	static int changes;
+	static SafeNumeric<int> changes;
 	RID test_cube;
 
 	List<Callable> frame_drawn_callbacks;
@@ -103,17 +104,17 @@ public:
 
 #ifdef DEBUG_CHANGES
 	_FORCE_INLINE_ static void redraw_request() {
-		changes++;
+		changes.increment();
 		_changes_changed();
 	}
 
-#define DISPLAY_CHANGED \
-	changes++;          \
+#define DISPLAY_CHANGED  \
+	changes.increment(); \
 	_changes_changed();
 
 #else
 	_FORCE_INLINE_ static void redraw_request() {
-		changes++;
+		changes.increment();
 	}
 #endif
 
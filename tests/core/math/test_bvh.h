@@ -0,0 +1,212 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_number_generator.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct PairTestItem {
+	uint32_t index = 0;
+};
+
+class PairTestFunction {
+public:
+	static bool user_pair_check(const PairTestItem *p_a, const PairTestItem *p_b) {
+		// Only pair items of different parity, to also check the pair test function is used.
+		return (p_a->index & 1) != (p_b->index & 1);
+	}
+};
+
+class CullTestFunction {
+public:
+	static bool user_cull_check(const PairTestItem *p_a, const PairTestItem *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<PairTestItem, 1, true, 8, PairTestFunction, CullTestFunction> PairTestBVH;
+
+static uint64_t pair_key(const PairTestItem *p_a, const PairTestItem *p_b) {
+	return (uint64_t(MIN(p_a->index, p_b->index)) << 32) | MAX(p_a->index, p_b->index);
+}
+
+static void *pair_callback(void *p_pairs, uint32_t p_id_a, PairTestItem *p_item_a, int p_subindex_a, uint32_t p_id_b, PairTestItem *p_item_b, int p_subindex_b) {
+	static_cast<HashSet<uint64_t> *>(p_pairs)->insert(pair_key(p_item_a, p_item_b));
+	return nullptr;
+}
+
+static void unpair_callback(void *p_pairs, uint32_t p_id_a, PairTestItem *p_item_a, int p_subindex_a, uint32_t p_id_b, PairTestItem *p_item_b, int p_subindex_b, void *p_pair_data) {
+	static_cast<HashSet<uint64_t> *>(p_pairs)->erase(pair_key(p_item_a, p_item_b));
+}
+
+static void parallel_for_callback(void *p_userdata, void (*p_function)(void *, uint32_t), void *p_function_userdata, uint32_t p_count) {
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(p_function, p_function_userdata, p_count, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+static bool pairs_match(const HashSet<uint64_t> &p_pairs_a, const HashSet<uint64_t> &p_pairs_b) {
+	if (p_pairs_a.size() != p_pairs_b.size()) {
+		return false;
+	}
+	for (const uint64_t pair : p_pairs_a) {
+		if (!p_pairs_b.has(pair)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[BVH] Parallel pairing should find the same pairs as serial pairing") {
+	const uint32_t item_count = 256;
+	PairTestItem items[item_count];
+
+	PairTestBVH serial_bvh;
+	HashSet<uint64_t> serial_pairs;
+	serial_bvh.set_pair_callback(pair_callback, &serial_pairs);
+	serial_bvh.set_unpair_callback(unpair_callback, &serial_pairs);
+
+	PairTestBVH parallel_bvh;
+	HashSet<uint64_t> parallel_pairs;
+	parallel_bvh.set_pair_callback(pair_callback, &parallel_pairs);
+	parallel_bvh.set_unpair_callback(unpair_callback, &parallel_pairs);
+	parallel_bvh.params_set_parallel_pairing(parallel_for_callback, nullptr);
+	parallel_bvh.params_set_parallel_pairing_min_items(16);
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(0);
+
+	uint32_t serial_handles[item_count];
+	uint32_t parallel_handles[item_count];
+	for (uint32_t i = 0; i < item_count; i++) {
+		items[i].index = i;
+		const AABB aabb(Vector3(rng->randf_range(0, 20), rng->randf_range(0, 20), rng->randf_range(0, 20)), Vector3(1, 1, 1));
+		serial_handles[i] = serial_bvh.create(&items[i], true, 0, 1, aabb);
+		parallel_handles[i] = parallel_bvh.create(&items[i], true, 0, 1, aabb);
+	}
+	serial_bvh.update();
+	parallel_bvh.update();
+	REQUIRE_FALSE(serial_pairs.is_empty());
+	CHECK(pairs_match(serial_pairs, parallel_pairs));
+
+	// Moving most items at once creates and removes pairs from the parallel queries.
+	for (int step = 0; step < 4; step++) {
+		for (uint32_t i = 0; i < item_count; i++) {
+			if (rng->randf() < 0.25) {
+				continue;
+			}
+			const AABB aabb(Vector3(rng->randf_range(0, 20), rng->randf_range(0, 20), rng->randf_range(0, 20)), Vector3(1, 1, 1));
+			serial_bvh.move(serial_handles[i], aabb);
+			parallel_bvh.move(parallel_handles[i], aabb);
+		}
+		serial_bvh.update();
+		parallel_bvh.update();
+		CHECK(pairs_match(serial_pairs, parallel_pairs));
+	}
+
+	for (uint32_t i = 0; i < item_count; i++) {
+		serial_bvh.erase(serial_handles[i]);
+		parallel_bvh.erase(parallel_handles[i]);
+	}
+	CHECK(serial_pairs.is_empty());
+	CHECK(parallel_pairs.is_empty());
+}
+
+TEST_CASE("[BVH] Segment packets should find the same items as single segments") {
+	const uint32_t item_count = 256;
+	PairTestItem items[item_count];
+
+	BVH_Manager<PairTestItem, 1, false, 8, PairTestFunction, CullTestFunction> bvh;
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(0);
+
+	for (uint32_t i = 0; i < item_count; i++) {
+		items[i].index = i;
+		const Vector3 size = Vector3(rng->randf_range(0.1, 2), rng->randf_range(0.1, 2), rng->randf_range(0.1, 2));
+		bvh.create(&items[i], true, 0, 1, AABB(Vector3(rng->randf_range(0, 20), rng->randf_range(0, 20), rng->randf_range(0, 20)), size), i);
+	}
+	bvh.update();
+
+	// Not a multiple of the packet size, so the last packet is partially used.
+	const int segment_count = 101;
+	Vector3 from[segment_count];
+	Vector3 to[segment_count];
+	for (int i = 0; i < segment_count; i++) {
+		from[i] = Vector3(rng->randf_range(-5, 25), rng->randf_range(-5, 25), rng->randf_range(-5, 25));
+		to[i] = Vector3(rng->randf_range(-5, 25), rng->randf_range(-5, 25), rng->randf_range(-5, 25));
+		if (i % 4 == 0) {
+			// Axis aligned segments have no direction on the other axes.
+			to[i] = from[i];
+			to[i][i % 3] += 30;
+		}
+	}
+
+	const int result_max = item_count;
+	LocalVector<PairTestItem *> results;
+	LocalVector<int> subindex_results;
+	int result_counts[segment_count];
+	results.resize(segment_count * result_max);
+	subindex_results.resize(segment_count * result_max);
+	bvh.cull_segments(from, to, segment_count, results.ptr(), result_counts, result_max, nullptr, 0xFFFFFFFF, subindex_results.ptr());
+
+	int total_hit_count = 0;
+	PairTestItem *segment_results[result_max];
+	int segment_subindex_results[result_max];
+	for (int i = 0; i < segment_count; i++) {
+		const int hit_count = bvh.cull_segment(from[i], to[i], segment_results, result_max, nullptr, 0xFFFFFFFF, segment_subindex_results);
+		REQUIRE_EQ(result_counts[i], hit_count);
+		total_hit_count += hit_count;
+
+		HashSet<uint32_t> hits;
+		for (int j = 0; j < hit_count; j++) {
+			CHECK_EQ(segment_subindex_results[j], int(segment_results[j]->index));
+			hits.insert(segment_results[j]->index);
+		}
+		for (int j = 0; j < hit_count; j++) {
+			const int result_index = i * result_max + j;
+			CHECK(hits.has(results[result_index]->index));
+			CHECK_EQ(subindex_results[result_index], int(results[result_index]->index));
+		}
+	}
+	CHECK_GT(total_hit_count, 0);
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
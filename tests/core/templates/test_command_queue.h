@@ -381,6 +381,63 @@ TEST_CASE("[CommandQueue] Test Queue Lapping") {
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
 
+class ReentrantPusher {
+public:
+	CommandQueueMT command_queue;
+	int outer_count = 0;
+	int inner_count = 0;
+	int inner_count_after_flush = 0;
+
+	void inner() {
+		inner_count++;
+	}
+	void outer() {
+		outer_count++;
+		command_queue.push(this, &ReentrantPusher::inner);
+		command_queue.flush_all();
+		inner_count_after_flush = inner_count;
+	}
+
+	ReentrantPusher(bool p_defer_nested_flush) :
+			command_queue(false, p_defer_nested_flush) {}
+};
+
+TEST_CASE("[CommandQueue] Test pushing while flushing") {
+	// Used by the rendering server.
+	ReentrantPusher pusher(false);
+
+	pusher.command_queue.push(&pusher, &ReentrantPusher::outer);
+	pusher.command_queue.flush_all();
+	CHECK_MESSAGE(pusher.outer_count == 1,
+			"Flush should have run the pushed command once");
+	CHECK_MESSAGE(pusher.inner_count_after_flush == 1,
+			"Commands pushed while flushing should run in the nested flush");
+
+	pusher.command_queue.flush_all();
+	CHECK_MESSAGE(pusher.outer_count == 1,
+			"Flush should not run the first command again");
+	CHECK_MESSAGE(pusher.inner_count == 1,
+			"Flush should not run the nested command again");
+}
+
+TEST_CASE("[CommandQueue] Test pushing while flushing with deferred nested flushes") {
+	// Used by the 3D physics server, so a step doesn't run commands pushed after it.
+	ReentrantPusher pusher(true);
+
+	pusher.command_queue.push(&pusher, &ReentrantPusher::outer);
+	pusher.command_queue.flush_all();
+	CHECK_MESSAGE(pusher.outer_count == 1,
+			"Flush should have run the pushed command once");
+	CHECK_MESSAGE(pusher.inner_count == 0,
+			"Commands pushed while flushing should not run in the same flush");
+
+	pusher.command_queue.flush_all();
+	CHECK_MESSAGE(pusher.outer_count == 1,
+			"Flush should not run the first command again");
+	CHECK_MESSAGE(pusher.inner_count == 1,
+			"Commands pushed while flushing should run in the next flush");
+}
+
 TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	const char *COMMAND_QUEUE_SETTING = "memory/limits/command_queue/multithreading_queue_size_kb";
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING, 1);
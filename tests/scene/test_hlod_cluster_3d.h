@@ -0,0 +1,255 @@
+/**************************************************************************/
+/*  test_hlod_cluster_3d.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_HLOD_CLUSTER_3D_H
+#define TEST_HLOD_CLUSTER_3D_H
+
+#include "scene/3d/hlod_cluster_3d.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/material.h"
+#include "scene/resources/primitive_meshes.h"
+#include "scene/resources/skin.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestHLODCluster3D {
+
+static MeshInstance3D *add_member(HLODCluster3D *p_cluster, const Ref<Mesh> &p_mesh, const Ref<Material> &p_material) {
+	MeshInstance3D *member = memnew(MeshInstance3D);
+	member->set_mesh(p_mesh);
+	member->set_material_override(p_material);
+	p_cluster->add_child(member);
+	return member;
+}
+
+static int find_proxy_surface(const Ref<Mesh> &p_proxy_mesh, const Ref<Material> &p_material) {
+	for (int i = 0; i < p_proxy_mesh->get_surface_count(); i++) {
+		if (p_proxy_mesh->surface_get_material(i) == p_material) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Instance set as the visibility parent of the instance of `p_geometry` in the rendering server.
+static RID get_instance_visibility_parent(GeometryInstance3D *p_geometry) {
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	RendererSceneCull::Instance *instance = scene_cull->instance_owner.get_or_null(p_geometry->get_instance());
+	if (!instance || !instance->visibility_parent) {
+		return RID();
+	}
+	return instance->visibility_parent->self;
+}
+
+TEST_CASE("[SceneTree][HLODCluster3D] Baking the proxy mesh") {
+	HLODCluster3D *cluster = memnew(HLODCluster3D);
+	SceneTree::get_singleton()->get_root()->add_child(cluster);
+
+	Ref<BoxMesh> box;
+	box.instantiate();
+	const int box_vertex_count = box->surface_get_array_len(0);
+	const int box_index_count = box->surface_get_array_index_len(0);
+
+	Ref<StandardMaterial3D> material_a;
+	material_a.instantiate();
+	Ref<StandardMaterial3D> material_b;
+	material_b.instantiate();
+
+	SUBCASE("Members should be merged into one surface per material") {
+		add_member(cluster, box, material_a)->set_position(Vector3(-2, 0, 0));
+		add_member(cluster, box, material_a)->set_position(Vector3(2, 0, 0));
+		add_member(cluster, box, material_b);
+		cluster->bake_proxy_mesh();
+
+		Ref<Mesh> proxy_mesh = cluster->get_proxy_mesh();
+		REQUIRE(proxy_mesh.is_valid());
+		CHECK_EQ(proxy_mesh->get_surface_count(), 2);
+		const int surface_a = find_proxy_surface(proxy_mesh, material_a);
+		const int surface_b = find_proxy_surface(proxy_mesh, material_b);
+		REQUIRE_GE(surface_a, 0);
+		REQUIRE_GE(surface_b, 0);
+		CHECK_EQ(proxy_mesh->surface_get_array_len(surface_a), box_vertex_count * 2);
+		CHECK_EQ(proxy_mesh->surface_get_array_len(surface_b), box_vertex_count);
+		CHECK(proxy_mesh->get_aabb().is_equal_approx(AABB(Vector3(-2.5, -0.5, -0.5), Vector3(5, 1, 1))));
+		CHECK(cluster->get_aabb().is_equal_approx(proxy_mesh->get_aabb()));
+	}
+
+	SUBCASE("Skinned members should be skipped") {
+		add_member(cluster, box, material_a);
+		Ref<Skin> skin;
+		skin.instantiate();
+		add_member(cluster, box, material_b)->set_skin(skin);
+		cluster->bake_proxy_mesh();
+
+		Ref<Mesh> proxy_mesh = cluster->get_proxy_mesh();
+		REQUIRE(proxy_mesh.is_valid());
+		CHECK_EQ(proxy_mesh->get_surface_count(), 1);
+		CHECK_EQ(find_proxy_surface(proxy_mesh, material_a), 0);
+	}
+
+	SUBCASE("Members with their own visibility parent should be skipped") {
+		MeshInstance3D *other_parent = memnew(MeshInstance3D);
+		SceneTree::get_singleton()->get_root()->add_child(other_parent);
+
+		add_member(cluster, box, material_a);
+		MeshInstance3D *member = add_member(cluster, box, material_b);
+		member->set_visibility_parent(member->get_path_to(other_parent));
+		// Its children inherit the same visibility parent.
+		MeshInstance3D *child = memnew(MeshInstance3D);
+		child->set_mesh(box);
+		child->set_material_override(material_b);
+		member->add_child(child);
+		cluster->bake_proxy_mesh();
+
+		Ref<Mesh> proxy_mesh = cluster->get_proxy_mesh();
+		REQUIRE(proxy_mesh.is_valid());
+		CHECK_EQ(proxy_mesh->get_surface_count(), 1);
+		CHECK_EQ(find_proxy_surface(proxy_mesh, material_a), 0);
+
+		member->set_visibility_parent(NodePath());
+		memdelete(other_parent);
+	}
+
+	SUBCASE("Members hidden before the proxy appears should be skipped") {
+		cluster->set_visibility_range_begin(50.0);
+		add_member(cluster, box, material_a)->set_visibility_range_end(100.0);
+		add_member(cluster, box, material_b)->set_visibility_range_end(10.0);
+		cluster->bake_proxy_mesh();
+
+		Ref<Mesh> proxy_mesh = cluster->get_proxy_mesh();
+		REQUIRE(proxy_mesh.is_valid());
+		CHECK_EQ(proxy_mesh->get_surface_count(), 1);
+		CHECK_EQ(find_proxy_surface(proxy_mesh, material_a), 0);
+	}
+
+	SUBCASE("Surfaces without indices should be merged with indexed ones") {
+		PackedVector3Array vertices;
+		vertices.push_back(Vector3(0, 0, 0));
+		vertices.push_back(Vector3(1, 0, 0));
+		vertices.push_back(Vector3(0, 0, 1));
+		Array arrays;
+		arrays.resize(Mesh::ARRAY_MAX);
+		arrays[Mesh::ARRAY_VERTEX] = vertices;
+		Ref<ArrayMesh> triangle;
+		triangle.instantiate();
+		triangle->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+
+		add_member(cluster, box, material_a);
+		add_member(cluster, triangle, material_a);
+		cluster->bake_proxy_mesh();
+
+		Ref<Mesh> proxy_mesh = cluster->get_proxy_mesh();
+		REQUIRE(proxy_mesh.is_valid());
+		CHECK_EQ(proxy_mesh->get_surface_count(), 1);
+		CHECK_EQ(proxy_mesh->surface_get_array_len(0), box_vertex_count + 3);
+		CHECK_EQ(proxy_mesh->surface_get_array_index_len(0), box_index_count + 3);
+	}
+
+	SUBCASE("Baking should fail when the members use too many materials") {
+		for (int i = 0; i < RS::MAX_MESH_SURFACES + 1; i++) {
+			Ref<StandardMaterial3D> material;
+			material.instantiate();
+			add_member(cluster, box, material);
+		}
+		ERR_PRINT_OFF;
+		cluster->bake_proxy_mesh();
+		ERR_PRINT_ON;
+
+		CHECK(cluster->get_proxy_mesh().is_null());
+	}
+
+	memdelete(cluster);
+}
+
+TEST_CASE("[SceneTree][HLODCluster3D] Members should use the proxy as their visibility parent") {
+	HLODCluster3D *cluster = memnew(HLODCluster3D);
+	SceneTree::get_singleton()->get_root()->add_child(cluster);
+
+	Ref<BoxMesh> box;
+	box.instantiate();
+	Ref<StandardMaterial3D> material;
+	material.instantiate();
+
+	MeshInstance3D *member = add_member(cluster, box, material);
+	Node3D *group = memnew(Node3D);
+	cluster->add_child(group);
+	MeshInstance3D *nested_member = memnew(MeshInstance3D);
+	group->add_child(nested_member);
+
+	MeshInstance3D *other_parent = memnew(MeshInstance3D);
+	SceneTree::get_singleton()->get_root()->add_child(other_parent);
+	MeshInstance3D *independent_member = add_member(cluster, box, material);
+	independent_member->set_visibility_parent(independent_member->get_path_to(other_parent));
+	MeshInstance3D *independent_child = memnew(MeshInstance3D);
+	independent_member->add_child(independent_child);
+
+	SUBCASE("Members should have no visibility parent without a proxy mesh") {
+		CHECK_EQ(get_instance_visibility_parent(member), RID());
+		CHECK_EQ(get_instance_visibility_parent(nested_member), RID());
+		CHECK_EQ(get_instance_visibility_parent(independent_member), other_parent->get_instance());
+		CHECK_EQ(get_instance_visibility_parent(independent_child), other_parent->get_instance());
+	}
+
+	SUBCASE("Members should follow the proxy mesh being set and cleared") {
+		cluster->bake_proxy_mesh();
+		REQUIRE(cluster->get_proxy_mesh().is_valid());
+		CHECK_EQ(get_instance_visibility_parent(member), cluster->get_instance());
+		CHECK_EQ(get_instance_visibility_parent(nested_member), cluster->get_instance());
+		CHECK_EQ(get_instance_visibility_parent(independent_member), other_parent->get_instance());
+		CHECK_EQ(get_instance_visibility_parent(independent_child), other_parent->get_instance());
+
+		cluster->set_proxy_mesh(Ref<Mesh>());
+		CHECK_EQ(get_instance_visibility_parent(member), RID());
+		CHECK_EQ(get_instance_visibility_parent(nested_member), RID());
+		CHECK_EQ(get_instance_visibility_parent(independent_member), other_parent->get_instance());
+	}
+
+	SUBCASE("Members added after the proxy mesh should use it") {
+		cluster->bake_proxy_mesh();
+		MeshInstance3D *new_member = add_member(cluster, box, material);
+		CHECK_EQ(get_instance_visibility_parent(new_member), cluster->get_instance());
+
+		// Moved out of the cluster, it's no longer swapped with the proxy.
+		cluster->remove_child(new_member);
+		SceneTree::get_singleton()->get_root()->add_child(new_member);
+		CHECK_EQ(get_instance_visibility_parent(new_member), RID());
+		memdelete(new_member);
+	}
+
+	memdelete(cluster);
+	memdelete(other_parent);
+}
+
+} // namespace TestHLODCluster3D
+
+#endif // TEST_HLOD_CLUSTER_3D_H
@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  test_tile_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TILE_MAP_H
+#define TEST_TILE_MAP_H
+
+#include "core/math/geometry_2d.h"
+#include "scene/2d/tile_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTileMap {
+
+static Vector<Vector2> make_square(const Vector2 &p_origin) {
+	Vector<Vector2> square;
+	square.push_back(p_origin);
+	square.push_back(p_origin + Vector2(1, 0));
+	square.push_back(p_origin + Vector2(1, 1));
+	square.push_back(p_origin + Vector2(0, 1));
+	return square;
+}
+
+TEST_CASE("[TileMap] Merging convex polygon pairs") {
+	Vector<Vector2> merged;
+
+	SUBCASE("Adjacent squares should merge into one rectangle without the shared vertices") {
+		// The edge 1 -> 2 of the first square is the edge 3 -> 0 of the second one.
+		CHECK(TileMap::merge_convex_polygon_pair(make_square(Vector2(0, 0)), 1, make_square(Vector2(1, 0)), merged));
+
+		Vector<Vector2> rectangle;
+		rectangle.push_back(Vector2(0, 1));
+		rectangle.push_back(Vector2(0, 0));
+		rectangle.push_back(Vector2(2, 0));
+		rectangle.push_back(Vector2(2, 1));
+		CHECK_EQ(merged, rectangle);
+	}
+
+	SUBCASE("A merge creating a reflex vertex should be rejected") {
+		// Joined along x = 1, the vertex at (1, 1) would turn clockwise.
+		Vector<Vector2> triangle;
+		triangle.push_back(Vector2(1, 1));
+		triangle.push_back(Vector2(1, 0));
+		triangle.push_back(Vector2(2, 2));
+		CHECK_FALSE(TileMap::merge_convex_polygon_pair(make_square(Vector2(0, 0)), 1, triangle, merged));
+	}
+
+	SUBCASE("Polygons not sharing the edge should not be merged") {
+		CHECK_FALSE(TileMap::merge_convex_polygon_pair(make_square(Vector2(0, 0)), 1, make_square(Vector2(1, 1)), merged));
+	}
+}
+
+TEST_CASE("[TileMap] Merging convex polygons") {
+	LocalVector<Vector<Vector2>> polygons;
+
+	SUBCASE("A grid of squares should merge into one rectangle") {
+		for (int y = 0; y < 2; y++) {
+			for (int x = 0; x < 3; x++) {
+				polygons.push_back(make_square(Vector2(x, y)));
+			}
+		}
+		TileMap::merge_convex_polygons(polygons);
+
+		REQUIRE_EQ(polygons.size(), 1u);
+		const Vector<Vector2> &rectangle = polygons[0];
+		CHECK_EQ(rectangle.size(), 4);
+		CHECK(rectangle.has(Vector2(0, 0)));
+		CHECK(rectangle.has(Vector2(3, 0)));
+		CHECK(rectangle.has(Vector2(3, 2)));
+		CHECK(rectangle.has(Vector2(0, 2)));
+	}
+
+	SUBCASE("Collinear vertices should be removed") {
+		// A row of squares, whose shared vertices all end up on the long edges.
+		for (int x = 0; x < 4; x++) {
+			polygons.push_back(make_square(Vector2(x, 0)));
+		}
+		TileMap::merge_convex_polygons(polygons);
+
+		REQUIRE_EQ(polygons.size(), 1u);
+		CHECK_EQ(polygons[0].size(), 4);
+		for (int x = 1; x < 4; x++) {
+			CHECK_FALSE(polygons[0].has(Vector2(x, 0)));
+			CHECK_FALSE(polygons[0].has(Vector2(x, 1)));
+		}
+	}
+
+	SUBCASE("Clockwise polygons should be merged as well") {
+		for (int x = 0; x < 2; x++) {
+			Vector<Vector2> square = make_square(Vector2(x, 0));
+			square.reverse();
+			polygons.push_back(square);
+		}
+		TileMap::merge_convex_polygons(polygons);
+
+		REQUIRE_EQ(polygons.size(), 1u);
+		CHECK_EQ(polygons[0].size(), 4);
+	}
+
+	SUBCASE("Merges creating a reflex vertex should be rejected") {
+		// An L shape can't be a single convex polygon.
+		polygons.push_back(make_square(Vector2(0, 0)));
+		polygons.push_back(make_square(Vector2(1, 0)));
+		polygons.push_back(make_square(Vector2(0, 1)));
+		TileMap::merge_convex_polygons(polygons);
+
+		CHECK_EQ(polygons.size(), 2u);
+		for (const Vector<Vector2> &polygon : polygons) {
+			CHECK_FALSE(Geometry2D::is_polygon_clockwise(polygon));
+			for (int i = 0; i < polygon.size(); i++) {
+				const Vector2 &prev = polygon[(i + polygon.size() - 1) % polygon.size()];
+				const Vector2 &next = polygon[(i + 1) % polygon.size()];
+				CHECK_MESSAGE((polygon[i] - prev).cross(next - polygon[i]) > 0, "The merged polygons should stay convex.");
+			}
+		}
+	}
+}
+
+} // namespace TestTileMap
+
+#endif // TEST_TILE_MAP_H
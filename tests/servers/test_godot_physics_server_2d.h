@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  test_godot_physics_server_2d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_PHYSICS_SERVER_2D_H
+#define TEST_GODOT_PHYSICS_SERVER_2D_H
+
+#include "servers/physics_2d/godot_physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysicsServer2D {
+
+// Vertical wall of 2 pixels at X = 100.
+static RID create_thin_wall(PhysicsServer2D *p_physics_server, RID p_space, RID p_wall_shape, PhysicsServer2D::BodyMode p_mode) {
+	RID wall = p_physics_server->body_create();
+	p_physics_server->body_set_mode(wall, p_mode);
+	p_physics_server->body_add_shape(wall, p_wall_shape);
+	p_physics_server->body_set_param(wall, PhysicsServer2D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	p_physics_server->body_set_state(wall, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(100, 0)));
+	p_physics_server->body_set_space(wall, p_space);
+	return wall;
+}
+
+// Ball of radius 5 at the origin, moving towards the wall by 200 pixels per step.
+static RID create_fast_ball(PhysicsServer2D *p_physics_server, RID p_space, RID p_ball_shape) {
+	RID ball = p_physics_server->body_create();
+	p_physics_server->body_set_mode(ball, PhysicsServer2D::BODY_MODE_RIGID);
+	p_physics_server->body_add_shape(ball, p_ball_shape);
+	p_physics_server->body_set_param(ball, PhysicsServer2D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	p_physics_server->body_set_continuous_collision_detection_mode(ball, PhysicsServer2D::CCD_MODE_CAST_RAY);
+	p_physics_server->body_set_state(ball, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(0, 0)));
+	p_physics_server->body_set_state(ball, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2(200 * 60, 0));
+	p_physics_server->body_set_space(ball, p_space);
+	return ball;
+}
+
+static void step_physics(PhysicsServer2D *p_physics_server, int p_step_count) {
+	for (int i = 0; i < p_step_count; i++) {
+		p_physics_server->step(1.0 / 60.0);
+	}
+}
+
+TEST_CASE("[GodotPhysicsServer2D] Sub-stepped CCD bodies should not tunnel through bodies they collide with") {
+	PhysicsServer2D *physics_server = memnew(GodotPhysicsServer2D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->space_set_param(space, PhysicsServer2D::SPACE_PARAM_CCD_MAX_SUBSTEPS, 16);
+
+	RID wall_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(wall_shape, Vector2(1, 50));
+	RID ball_shape = physics_server->circle_shape_create();
+	physics_server->shape_set_data(ball_shape, 5.0);
+
+	SUBCASE("The ball's mask matches a static wall") {
+		RID wall = create_thin_wall(physics_server, space, wall_shape, PhysicsServer2D::BODY_MODE_STATIC);
+		RID ball = create_fast_ball(physics_server, space, ball_shape);
+
+		step_physics(physics_server, 2);
+
+		Transform2D ball_xform = physics_server->body_get_state(ball, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(ball_xform.get_origin().x < 100, "The ball should stop in front of the wall.");
+
+		physics_server->free(ball);
+		physics_server->free(wall);
+	}
+
+	SUBCASE("Only the wall's mask matches the ball") {
+		RID wall = create_thin_wall(physics_server, space, wall_shape, PhysicsServer2D::BODY_MODE_RIGID);
+		physics_server->body_set_collision_layer(wall, 2);
+		physics_server->body_set_collision_mask(wall, 1);
+		RID ball = create_fast_ball(physics_server, space, ball_shape);
+		physics_server->body_set_collision_layer(ball, 1);
+		physics_server->body_set_collision_mask(ball, 0);
+
+		step_physics(physics_server, 3);
+
+		// The ball doesn't respond to the wall, but the wall is pushed by the ball instead of being skipped over.
+		Vector2 wall_velocity = physics_server->body_get_state(wall, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK_MESSAGE(wall_velocity.x > 0, "The wall should be pushed by the ball.");
+
+		physics_server->free(ball);
+		physics_server->free(wall);
+	}
+
+	SUBCASE("Neither mask matches") {
+		RID wall = create_thin_wall(physics_server, space, wall_shape, PhysicsServer2D::BODY_MODE_RIGID);
+		physics_server->body_set_collision_layer(wall, 2);
+		physics_server->body_set_collision_mask(wall, 2);
+		RID ball = create_fast_ball(physics_server, space, ball_shape);
+		physics_server->body_set_collision_layer(ball, 1);
+		physics_server->body_set_collision_mask(ball, 1);
+
+		step_physics(physics_server, 2);
+
+		Transform2D ball_xform = physics_server->body_get_state(ball, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(ball_xform.get_origin().x > 100, "The ball should go through the wall.");
+		Vector2 wall_velocity = physics_server->body_get_state(wall, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK_EQ(wall_velocity, Vector2());
+
+		physics_server->free(ball);
+		physics_server->free(wall);
+	}
+
+	physics_server->free(ball_shape);
+	physics_server->free(wall_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+} // namespace TestGodotPhysicsServer2D
+
+#endif // TEST_GODOT_PHYSICS_SERVER_2D_H
@@ -0,0 +1,817 @@
+/**************************************************************************/
+/*  test_godot_physics_server_3d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_PHYSICS_SERVER_3D_H
+#define TEST_GODOT_PHYSICS_SERVER_3D_H
+
+#include "core/math/random_number_generator.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+#include "servers/physics_3d/godot_soft_body_3d.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysicsServer3D {
+
+static RID create_floor(PhysicsServer3D *p_physics_server, RID p_space, RID &r_floor_shape) {
+	r_floor_shape = p_physics_server->world_boundary_shape_create();
+	p_physics_server->shape_set_data(r_floor_shape, Plane(Vector3(0, 1, 0), 0));
+	RID floor = p_physics_server->body_create();
+	p_physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	p_physics_server->body_add_shape(floor, r_floor_shape);
+	p_physics_server->body_set_space(floor, p_space);
+	return floor;
+}
+
+// Boxes of size 1 resting on the floor along the X axis, each overlapping the next one by `p_overlap`.
+static void create_box_row(PhysicsServer3D *p_physics_server, RID p_space, RID p_box_shape, int p_box_count, real_t p_overlap, LocalVector<RID> &r_boxes) {
+	for (int i = 0; i < p_box_count; i++) {
+		RID box = p_physics_server->body_create();
+		p_physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		p_physics_server->body_add_shape(box, p_box_shape);
+		p_physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * (1.0 - p_overlap), 0.5, 0)));
+		p_physics_server->body_set_space(box, p_space);
+		r_boxes.push_back(box);
+	}
+}
+
+static void step_physics(PhysicsServer3D *p_physics_server, int p_step_count) {
+	for (int i = 0; i < p_step_count; i++) {
+		p_physics_server->step(1.0 / 60.0);
+	}
+}
+
+// Flat grid of `p_size` by `p_size` vertices in the XZ plane, with a spacing of 1.
+static RID create_grid_mesh(int p_size) {
+	PackedVector3Array vertices;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	PackedInt32Array indices;
+	for (int z = 0; z < p_size - 1; z++) {
+		for (int x = 0; x < p_size - 1; x++) {
+			int i = z * p_size + x;
+			indices.push_back(i);
+			indices.push_back(i + 1);
+			indices.push_back(i + p_size);
+			indices.push_back(i + 1);
+			indices.push_back(i + p_size + 1);
+			indices.push_back(i + p_size);
+		}
+	}
+
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = vertices;
+	arrays[RS::ARRAY_INDEX] = indices;
+	RID mesh = RS::get_singleton()->mesh_create();
+	RS::get_singleton()->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+	return mesh;
+}
+
+static void stretch_soft_body(GodotSoftBody3D *p_soft_body, int p_vertex_count, real_t p_scale) {
+	for (int i = 0; i < p_vertex_count; i++) {
+		Vector3 position = p_soft_body->get_vertex_position(i) * p_scale;
+		// Twice, so the previous position is stretched as well and the body starts at rest.
+		p_soft_body->set_vertex_position(i, position);
+		p_soft_body->set_vertex_position(i, position);
+	}
+}
+
+// Sum of the lengths of the grid edges along X, at rest it's `p_size * (p_size - 1)`.
+static real_t get_grid_edge_length(GodotSoftBody3D *p_soft_body, int p_size) {
+	real_t length = 0.0;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size - 1; x++) {
+			int i = z * p_size + x;
+			length += p_soft_body->get_vertex_position(i).distance_to(p_soft_body->get_vertex_position(i + 1));
+		}
+	}
+	return length;
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Large constraint islands should be solved like small ones") {
+	PhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID floor_shape;
+	RID floor = create_floor(physics_server, space, floor_shape);
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// A row of touching boxes is one island with far more constraints than the ones solved in a
+	// single task, while the boxes of a spread out row are all separate islands.
+	LocalVector<RID> row_boxes;
+	create_box_row(physics_server, space, box_shape, 300, 0.01, row_boxes);
+	LocalVector<RID> spread_boxes;
+	for (int i = 0; i < 16; i++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * 3.0, 0.5, 10)));
+		physics_server->body_set_space(box, space);
+		spread_boxes.push_back(box);
+	}
+
+	step_physics(physics_server, 60);
+
+	const real_t spread_height = Transform3D(physics_server->body_get_state(spread_boxes[0], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin.y;
+	CHECK(spread_height > 0.4);
+	CHECK(spread_height < 0.6);
+	for (const RID &box : row_boxes) {
+		const Transform3D transform = physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(Math::abs(transform.origin.y - spread_height) < 0.05, "The boxes of the large island should rest on the floor.");
+		CHECK(transform.basis.get_column(1).dot(Vector3(0, 1, 0)) > 0.99);
+	}
+
+	for (const RID &box : row_boxes) {
+		physics_server->free(box);
+	}
+	for (const RID &box : spread_boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(floor);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[GodotPhysicsServer3D] 'ProcessInfo' should report the islands and constraints of the last step") {
+	PhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	SUBCASE("'ProcessInfo' should report all counters empty before stepping") {
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_CONSTRAINT_COUNT), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_LARGEST_ISLAND_SIZE), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_SMALL_ISLAND_COUNT), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_MEDIUM_ISLAND_COUNT), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_LARGE_ISLAND_COUNT), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_STEP_TIME), 0);
+	}
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID floor_shape;
+	RID floor = create_floor(physics_server, space, floor_shape);
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// A row of 8 boxes has a constraint with the floor for each box and one between each neighbor,
+	// so 15 in one medium island. The lone box is a small island with a single constraint.
+	LocalVector<RID> boxes;
+	create_box_row(physics_server, space, box_shape, 8, 0.1, boxes);
+	RID lone_box = physics_server->body_create();
+	physics_server->body_set_mode(lone_box, PhysicsServer3D::BODY_MODE_RIGID);
+	physics_server->body_add_shape(lone_box, box_shape);
+	physics_server->body_set_state(lone_box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.5, 10)));
+	physics_server->body_set_space(lone_box, space);
+	boxes.push_back(lone_box);
+
+	step_physics(physics_server, 2);
+
+	SUBCASE("'ProcessInfo' should report the islands by size") {
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT), 2);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_CONSTRAINT_COUNT), 16);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_LARGEST_ISLAND_SIZE), 15);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_SMALL_ISLAND_COUNT), 1);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_MEDIUM_ISLAND_COUNT), 1);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_LARGE_ISLAND_COUNT), 0);
+	}
+
+	SUBCASE("'ProcessInfo' should report a step time made of the phase times") {
+		const PhysicsServer3D::ProcessInfo phases[] = {
+			PhysicsServer3D::INFO_INTEGRATE_FORCES_TIME,
+			PhysicsServer3D::INFO_UPDATE_BROADPHASE_TIME,
+			PhysicsServer3D::INFO_GENERATE_ISLANDS_TIME,
+			PhysicsServer3D::INFO_SETUP_CONSTRAINTS_TIME,
+			PhysicsServer3D::INFO_SOLVE_CONSTRAINTS_TIME,
+			PhysicsServer3D::INFO_INTEGRATE_VELOCITIES_TIME,
+		};
+		int phase_time_sum = 0;
+		for (PhysicsServer3D::ProcessInfo phase : phases) {
+			int phase_time = physics_server->get_process_info(phase);
+			CHECK(phase_time >= 0);
+			phase_time_sum += phase_time;
+		}
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_STEP_TIME), phase_time_sum);
+		CHECK(physics_server->get_process_info(PhysicsServer3D::INFO_SOLVE_ITERATION_TIME) <= physics_server->get_process_info(PhysicsServer3D::INFO_SOLVE_CONSTRAINTS_TIME));
+	}
+
+	SUBCASE("'ProcessInfo' should not report removed bodies") {
+		for (const RID &box : boxes) {
+			physics_server->free(box);
+		}
+		boxes.clear();
+		step_physics(physics_server, 1);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_CONSTRAINT_COUNT), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_LARGEST_ISLAND_SIZE), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_SMALL_ISLAND_COUNT), 0);
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_MEDIUM_ISLAND_COUNT), 0);
+	}
+
+	for (const RID &box : boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(floor);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Dormant sleeping bodies should still collide with awake bodies") {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/sleeping_bodies_dormant", true);
+	PhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID floor_shape;
+	RID floor = create_floor(physics_server, space, floor_shape);
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	LocalVector<RID> boxes;
+	create_box_row(physics_server, space, box_shape, 1, 0.0, boxes);
+	RID bottom_box = boxes[0];
+	step_physics(physics_server, 180);
+	REQUIRE_MESSAGE(bool(physics_server->body_get_state(bottom_box, PhysicsServer3D::BODY_STATE_SLEEPING)), "A box resting on the floor should fall asleep.");
+
+	// Dropped on the dormant box, the new box must pair with it, wake it and rest on it.
+	RID top_box = physics_server->body_create();
+	physics_server->body_set_mode(top_box, PhysicsServer3D::BODY_MODE_RIGID);
+	physics_server->body_add_shape(top_box, box_shape);
+	physics_server->body_set_state(top_box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 3, 0)));
+	physics_server->body_set_space(top_box, space);
+
+	bool bottom_box_woken = false;
+	for (int i = 0; i < 120; i++) {
+		step_physics(physics_server, 1);
+		bottom_box_woken = bottom_box_woken || !bool(physics_server->body_get_state(bottom_box, PhysicsServer3D::BODY_STATE_SLEEPING));
+	}
+	CHECK(bottom_box_woken);
+	const Transform3D bottom_transform = physics_server->body_get_state(bottom_box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	const Transform3D top_transform = physics_server->body_get_state(top_box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK(Math::abs(bottom_transform.origin.y - 0.5) < 0.1);
+	CHECK_MESSAGE(Math::abs(top_transform.origin.y - 1.5) < 0.1, "The dropped box should rest on the dormant box.");
+
+	physics_server->free(top_box);
+	physics_server->free(bottom_box);
+	physics_server->free(floor);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/sleeping_bodies_dormant", false);
+}
+
+struct SolverContacts {
+	int count = 0;
+	real_t depth = 0.0;
+};
+
+static void record_solver_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+	SolverContacts *contacts = static_cast<SolverContacts *>(p_userdata);
+	contacts->count++;
+	contacts->depth = MAX(contacts->depth, p_point_A.distance_to(p_point_B));
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Convex polygon collisions should match the same boxes") {
+	// The convex polygon test transforms the edges and vertices of the shapes up front, it must find
+	// the same separating axes and penetration as the box test does for the same geometry.
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(0);
+
+	const Vector3 half_extents[2] = { Vector3(0.5, 0.5, 0.5), Vector3(0.3, 0.7, 0.4) };
+	GodotBoxShape3D *boxes[2];
+	GodotConvexPolygonShape3D *convex_boxes[2];
+	for (int i = 0; i < 2; i++) {
+		boxes[i] = memnew(GodotBoxShape3D);
+		boxes[i]->set_data(half_extents[i]);
+
+		Vector<Vector3> points;
+		for (int j = 0; j < 8; j++) {
+			points.push_back(Vector3((j & 1) ? 1 : -1, (j & 2) ? 1 : -1, (j & 4) ? 1 : -1) * half_extents[i]);
+		}
+		convex_boxes[i] = memnew(GodotConvexPolygonShape3D);
+		convex_boxes[i]->set_data(points);
+	}
+
+	int collision_count = 0;
+	for (int i = 0; i < 200; i++) {
+		Transform3D transforms[2];
+		for (int j = 0; j < 2; j++) {
+			const Vector3 axis = Vector3(rng->randf_range(-1, 1), rng->randf_range(-1, 1), rng->randf_range(-1, 1)).normalized();
+			const Vector3 origin = Vector3(rng->randf_range(-0.8, 0.8), rng->randf_range(-0.8, 0.8), rng->randf_range(-0.8, 0.8));
+			transforms[j] = Transform3D(Basis(axis.is_zero_approx() ? Vector3(0, 1, 0) : axis, rng->randf_range(0, Math_TAU)), origin);
+		}
+		// Half of the tests use margins, which test the vertices and edges of both shapes as well.
+		const real_t margin = (i & 1) ? 0.04 : 0.0;
+
+		SolverContacts box_contacts;
+		const bool box_collided = GodotCollisionSolver3D::solve_static(boxes[0], transforms[0], boxes[1], transforms[1], record_solver_contact, &box_contacts, nullptr, margin, margin);
+		SolverContacts convex_contacts;
+		const bool convex_collided = GodotCollisionSolver3D::solve_static(convex_boxes[0], transforms[0], convex_boxes[1], transforms[1], record_solver_contact, &convex_contacts, nullptr, margin, margin);
+
+		CHECK_EQ(convex_collided, box_collided);
+		if (box_collided && convex_collided) {
+			collision_count++;
+			CHECK(convex_contacts.count > 0);
+			CHECK_MESSAGE(Math::abs(convex_contacts.depth - box_contacts.depth) < 0.01, "The penetration should be the same for both shapes.");
+		}
+	}
+	// Both outcomes should be covered.
+	CHECK(collision_count > 0);
+	CHECK(collision_count < 200);
+
+	for (int i = 0; i < 2; i++) {
+		memdelete(boxes[i]);
+		memdelete(convex_boxes[i]);
+	}
+}
+
+static bool record_culled_face(void *p_faces, GodotShape3D *p_face) {
+	const GodotFaceShape3D *face = static_cast<GodotFaceShape3D *>(p_face);
+	static_cast<LocalVector<Face3> *>(p_faces)->push_back(Face3(face->vertex[0], face->vertex[1], face->vertex[2]));
+	return false;
+}
+
+static bool has_face(const LocalVector<Face3> &p_faces, const Face3 &p_face) {
+	for (const Face3 &face : p_faces) {
+		if (face.vertex[0] == p_face.vertex[0] && face.vertex[1] == p_face.vertex[1] && face.vertex[2] == p_face.vertex[2]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Deterministic spaces should have the same state hash after the same steps") {
+	PhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	RID spaces[2];
+	RID floor_shapes[2];
+	RID floors[2];
+	LocalVector<RID> boxes[2];
+	for (int i = 0; i < 2; i++) {
+		spaces[i] = physics_server->space_create();
+		physics_server->space_set_active(spaces[i], true);
+		physics_server->space_set_param(spaces[i], PhysicsServer3D::SPACE_PARAM_SOLVER_DETERMINISTIC, 1);
+		floors[i] = create_floor(physics_server, spaces[i], floor_shapes[i]);
+		// Overlapping boxes, with one more falling on them.
+		create_box_row(physics_server, spaces[i], box_shape, 16, 0.2, boxes[i]);
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(1, 1, 0).normalized(), 0.3), Vector3(5.2, 3, 0.1)));
+		physics_server->body_set_space(box, spaces[i]);
+		boxes[i].push_back(box);
+
+		for (const RID &body : boxes[i]) {
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_SLEEPING, true);
+		}
+	}
+
+	// Wake up the bodies in a different order in each space.
+	for (uint32_t i = 0; i < boxes[0].size(); i++) {
+		physics_server->body_set_state(boxes[0][i], PhysicsServer3D::BODY_STATE_SLEEPING, false);
+		physics_server->body_set_state(boxes[1][boxes[1].size() - i - 1], PhysicsServer3D::BODY_STATE_SLEEPING, false);
+	}
+
+	const uint32_t initial_hash = physics_server->space_get_state_hash(spaces[0]);
+	CHECK_EQ(initial_hash, physics_server->space_get_state_hash(spaces[1]));
+
+	for (int i = 0; i < 4; i++) {
+		step_physics(physics_server, 30);
+		CHECK_EQ(physics_server->space_get_state_hash(spaces[0]), physics_server->space_get_state_hash(spaces[1]));
+	}
+	CHECK_NE(physics_server->space_get_state_hash(spaces[0]), initial_hash);
+
+	for (int i = 0; i < 2; i++) {
+		for (const RID &box : boxes[i]) {
+			physics_server->free(box);
+		}
+		physics_server->free(floors[i]);
+		physics_server->free(floor_shapes[i]);
+		physics_server->free(spaces[i]);
+	}
+	physics_server->free(box_shape);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Restoring a space snapshot should replay the same steps") {
+	PhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->space_set_param(space, PhysicsServer3D::SPACE_PARAM_SOLVER_DETERMINISTIC, 1);
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	SUBCASE("Contacts") {
+		RID floor_shape;
+		RID floor = create_floor(physics_server, space, floor_shape);
+		// A tilted box falling on the edge of another one, so it's still rolling over when the snapshot is taken.
+		LocalVector<RID> boxes;
+		create_box_row(physics_server, space, box_shape, 1, 0.0, boxes);
+		RID top_box = physics_server->body_create();
+		physics_server->body_set_mode(top_box, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(top_box, box_shape);
+		physics_server->body_set_state(top_box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 0, 1), 0.2), Vector3(0.1, 3.0, 0)));
+		physics_server->body_set_space(top_box, space);
+		boxes.push_back(top_box);
+
+		step_physics(physics_server, 45);
+		const Vector<uint8_t> snapshot = physics_server->space_get_snapshot(space);
+		const uint32_t snapshot_hash = physics_server->space_get_state_hash(space);
+
+		step_physics(physics_server, 30);
+		const uint32_t hash = physics_server->space_get_state_hash(space);
+		const Transform3D transform = physics_server->body_get_state(top_box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_NE(hash, snapshot_hash);
+
+		physics_server->space_set_snapshot(space, snapshot);
+		CHECK_EQ(physics_server->space_get_state_hash(space), snapshot_hash);
+
+		step_physics(physics_server, 30);
+		CHECK_EQ(physics_server->space_get_state_hash(space), hash);
+		CHECK_EQ(Transform3D(physics_server->body_get_state(top_box, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform);
+
+		for (const RID &box : boxes) {
+			physics_server->free(box);
+		}
+		physics_server->free(floor);
+		physics_server->free(floor_shape);
+	}
+
+	SUBCASE("Area overlaps") {
+		// Zero gravity inside the area, the body leaves it after the snapshot and starts falling.
+		RID area_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(area_shape, Vector3(2, 2, 2));
+		RID area = physics_server->area_create();
+		physics_server->area_add_shape(area, area_shape);
+		physics_server->area_set_param(area, PhysicsServer3D::AREA_PARAM_GRAVITY_OVERRIDE_MODE, PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE);
+		physics_server->area_set_param(area, PhysicsServer3D::AREA_PARAM_GRAVITY, 0.0);
+		physics_server->area_set_space(area, space);
+
+		RID sphere_shape = physics_server->sphere_shape_create();
+		physics_server->shape_set_data(sphere_shape, 0.5);
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(body, sphere_shape);
+		physics_server->body_set_space(body, space);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(6, 0, 0));
+
+		step_physics(physics_server, 5);
+		const Vector<uint8_t> snapshot = physics_server->space_get_snapshot(space);
+		const uint32_t snapshot_hash = physics_server->space_get_state_hash(space);
+
+		step_physics(physics_server, 60);
+		const uint32_t hash = physics_server->space_get_state_hash(space);
+		const Transform3D transform = physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK(transform.origin.y < -1.0);
+
+		physics_server->space_set_snapshot(space, snapshot);
+		CHECK_EQ(physics_server->space_get_state_hash(space), snapshot_hash);
+
+		step_physics(physics_server, 60);
+		CHECK_EQ(physics_server->space_get_state_hash(space), hash);
+		CHECK_EQ(Transform3D(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform);
+
+		physics_server->free(body);
+		physics_server->free(sphere_shape);
+		physics_server->free(area);
+		physics_server->free(area_shape);
+	}
+
+	SUBCASE("Invalid snapshots are ignored") {
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(body, box_shape);
+		physics_server->body_set_space(body, space);
+
+		step_physics(physics_server, 5);
+		Vector<uint8_t> snapshot = physics_server->space_get_snapshot(space);
+		step_physics(physics_server, 5);
+		const uint32_t hash = physics_server->space_get_state_hash(space);
+
+		ERR_PRINT_OFF;
+		physics_server->space_set_snapshot(space, Vector<uint8_t>());
+		Vector<uint8_t> truncated_snapshot = snapshot;
+		truncated_snapshot.resize(snapshot.size() - 1);
+		physics_server->space_set_snapshot(space, truncated_snapshot);
+		Vector<uint8_t> wrong_version_snapshot = snapshot;
+		wrong_version_snapshot.write[4]++;
+		physics_server->space_set_snapshot(space, wrong_version_snapshot);
+		ERR_PRINT_ON;
+		CHECK_EQ(physics_server->space_get_state_hash(space), hash);
+
+		physics_server->free(body);
+	}
+
+	physics_server->free(box_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[GodotPhysicsServer3D] State hash should not depend on the bodies removed from the space") {
+	PhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// The first space gets an extra body before the others, which is removed afterwards.
+	RID spaces[2];
+	LocalVector<RID> boxes[2];
+	for (int i = 0; i < 2; i++) {
+		spaces[i] = physics_server->space_create();
+		const int box_count = i == 0 ? 4 : 3;
+		for (int j = 0; j < box_count; j++) {
+			RID box = physics_server->body_create();
+			physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+			physics_server->body_add_shape(box, box_shape);
+			physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(j - (box_count - 3), 0, 0) * 2));
+			physics_server->body_set_space(box, spaces[i]);
+			boxes[i].push_back(box);
+		}
+	}
+	physics_server->free(boxes[0][0]);
+	boxes[0].remove_at(0);
+
+	CHECK_EQ(physics_server->space_get_state_hash(spaces[0]), physics_server->space_get_state_hash(spaces[1]));
+
+	for (int i = 0; i < 2; i++) {
+		for (const RID &box : boxes[i]) {
+			physics_server->free(box);
+		}
+		physics_server->free(spaces[i]);
+	}
+	physics_server->free(box_shape);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Concave polygon shape queries should match testing every face") {
+	// A noisy grid of triangles sharing their vertices, with a few random triangles on top.
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(0);
+	Vector<Vector3> faces;
+	for (int z = 0; z < 12; z++) {
+		for (int x = 0; x < 12; x++) {
+			Vector3 corners[4];
+			for (int i = 0; i < 4; i++) {
+				const int corner_x = x + (i & 1);
+				const int corner_z = z + (i >> 1);
+				corners[i] = Vector3(corner_x, Math::sin(corner_x * 0.7) + Math::cos(corner_z * 1.3), corner_z);
+			}
+			faces.push_back(corners[0]);
+			faces.push_back(corners[1]);
+			faces.push_back(corners[2]);
+			faces.push_back(corners[1]);
+			faces.push_back(corners[3]);
+			faces.push_back(corners[2]);
+		}
+	}
+	for (int i = 0; i < 30; i++) {
+		for (int j = 0; j < 3; j++) {
+			faces.push_back(Vector3(rng->randf_range(0, 12), rng->randf_range(-2, 4), rng->randf_range(0, 12)));
+		}
+	}
+	// A signed zero must not be shared with a positive zero.
+	faces.push_back(Vector3(-0.0, 5, 0));
+	faces.push_back(Vector3(1, 5, 0));
+	faces.push_back(Vector3(0, 5, 1));
+	faces.push_back(Vector3(0.0, 5, 0));
+	faces.push_back(Vector3(0, 5, 1));
+	faces.push_back(Vector3(1, 5, 0));
+	const int face_count = faces.size() / 3;
+
+	GodotConcavePolygonShape3D *shape = memnew(GodotConcavePolygonShape3D);
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = false;
+	shape->set_data(data);
+
+	SUBCASE("The faces should be returned as they were set") {
+		const Vector<Vector3> shape_faces = Dictionary(shape->get_data())["faces"];
+		REQUIRE_EQ(shape_faces.size(), faces.size());
+		CHECK(memcmp(shape_faces.ptr(), faces.ptr(), faces.size() * sizeof(Vector3)) == 0);
+	}
+
+	SUBCASE("Segments should hit the closest face") {
+		for (int i = 0; i < 200; i++) {
+			const Vector3 begin = Vector3(rng->randf_range(-1, 13), rng->randf_range(-3, 6), rng->randf_range(-1, 13));
+			const Vector3 end = Vector3(rng->randf_range(-1, 13), rng->randf_range(-3, 6), rng->randf_range(-1, 13));
+
+			bool expected_hit = false;
+			real_t expected_distance = 1e20;
+			Vector3 expected_result;
+			for (int j = 0; j < face_count; j++) {
+				GodotFaceShape3D face;
+				face.vertex[0] = faces[j * 3 + 0];
+				face.vertex[1] = faces[j * 3 + 1];
+				face.vertex[2] = faces[j * 3 + 2];
+				face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+				Vector3 face_result;
+				Vector3 face_normal;
+				if (face.intersect_segment(begin, end, face_result, face_normal, true)) {
+					const real_t distance = begin.distance_to(face_result);
+					if (distance > 0 && distance < expected_distance) {
+						expected_hit = true;
+						expected_distance = distance;
+						expected_result = face_result;
+					}
+				}
+			}
+
+			Vector3 result;
+			Vector3 normal;
+			const bool hit = shape->intersect_segment(begin, end, result, normal, false);
+			REQUIRE_EQ(hit, expected_hit);
+			if (hit) {
+				CHECK(result.is_equal_approx(expected_result));
+			}
+		}
+	}
+
+	SUBCASE("Culling should report the faces overlapping the AABB") {
+		for (int i = 0; i < 100; i++) {
+			const AABB aabb(Vector3(rng->randf_range(-1, 12), rng->randf_range(-3, 5), rng->randf_range(-1, 12)), Vector3(rng->randf_range(0, 3), rng->randf_range(0, 3), rng->randf_range(0, 3)));
+
+			LocalVector<Face3> culled_faces;
+			shape->cull(aabb, record_culled_face, &culled_faces, false);
+
+			int expected_count = 0;
+			for (int j = 0; j < face_count; j++) {
+				const Face3 face(faces[j * 3 + 0], faces[j * 3 + 1], faces[j * 3 + 2]);
+				if (aabb.intersects(face.get_aabb())) {
+					expected_count++;
+					CHECK(has_face(culled_faces, face));
+				}
+			}
+			CHECK_EQ(int(culled_faces.size()), expected_count);
+		}
+	}
+
+	memdelete(shape);
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Height map culling should skip cells above or below the AABB") {
+	// Flat at 0 on the left half and at 10 on the right half, over several bounds chunks.
+	const int size = 48;
+	Vector<real_t> heights;
+	heights.resize(size * size);
+	for (int z = 0; z < size; z++) {
+		for (int x = 0; x < size; x++) {
+			heights.write[z * size + x] = x < size / 2 ? 0.0 : 10.0;
+		}
+	}
+
+	GodotHeightMapShape3D *shape = memnew(GodotHeightMapShape3D);
+	Dictionary data;
+	data["width"] = size;
+	data["depth"] = size;
+	data["heights"] = heights;
+	data["min_height"] = 0.0;
+	data["max_height"] = 10.0;
+	shape->set_data(data);
+
+	const int cell_rows = size - 1;
+	// The cells of the step between both halves reach both heights.
+	const int half_cells = size / 2;
+
+	LocalVector<Face3> culled_faces;
+	shape->cull(AABB(Vector3(-100, -1, -100), Vector3(200, 2, 200)), record_culled_face, &culled_faces, false);
+	CHECK_EQ(int(culled_faces.size()), half_cells * cell_rows * 2);
+	for (const Face3 &face : culled_faces) {
+		CHECK(face.get_aabb().position.y < 1);
+	}
+
+	culled_faces.clear();
+	shape->cull(AABB(Vector3(-100, 9, -100), Vector3(200, 2, 200)), record_culled_face, &culled_faces, false);
+	CHECK_EQ(int(culled_faces.size()), half_cells * cell_rows * 2);
+	for (const Face3 &face : culled_faces) {
+		CHECK(face.get_aabb().get_end().y > 9);
+	}
+
+	culled_faces.clear();
+	shape->cull(AABB(Vector3(-100, -1, -100), Vector3(200, 12, 200)), record_culled_face, &culled_faces, false);
+	CHECK_EQ(int(culled_faces.size()), cell_rows * cell_rows * 2);
+
+	culled_faces.clear();
+	shape->cull(AABB(Vector3(-100, 20, -100), Vector3(200, 1, 200)), record_culled_face, &culled_faces, false);
+	CHECK(culled_faces.is_empty());
+
+	memdelete(shape);
+}
+
+TEST_CASE("[SceneTree][GodotPhysicsServer3D] Soft body links should only be reordered for the parallel solve") {
+	const real_t delta = 1.0 / 60.0;
+
+	SUBCASE("Small soft bodies keep their serial solving order") {
+		const int size = 6;
+		RID mesh = create_grid_mesh(size);
+		GodotSoftBody3D *soft_body_a = memnew(GodotSoftBody3D);
+		GodotSoftBody3D *soft_body_b = memnew(GodotSoftBody3D);
+		soft_body_a->set_mesh(mesh);
+		soft_body_b->set_mesh(mesh);
+		REQUIRE_EQ(soft_body_a->get_node_count(), uint32_t(size * size));
+		CHECK_FALSE(soft_body_a->has_parallel_links());
+
+		stretch_soft_body(soft_body_a, size * size, 1.2);
+		stretch_soft_body(soft_body_b, size * size, 1.2);
+		for (int i = 0; i < 10; i++) {
+			soft_body_a->solve_constraints(delta, true);
+			soft_body_b->solve_constraints(delta, false);
+		}
+		for (int i = 0; i < size * size; i++) {
+			CHECK_EQ(soft_body_a->get_vertex_position(i), soft_body_b->get_vertex_position(i));
+		}
+
+		memdelete(soft_body_a);
+		memdelete(soft_body_b);
+		RS::get_singleton()->free(mesh);
+	}
+
+	SUBCASE("Large soft bodies are solved in color batches") {
+		const int size = 32;
+		RID mesh = create_grid_mesh(size);
+		GodotSoftBody3D *soft_body_a = memnew(GodotSoftBody3D);
+		GodotSoftBody3D *soft_body_b = memnew(GodotSoftBody3D);
+		soft_body_a->set_mesh(mesh);
+		soft_body_b->set_mesh(mesh);
+		REQUIRE_EQ(soft_body_a->get_node_count(), uint32_t(size * size));
+		CHECK(soft_body_a->has_parallel_links());
+
+		stretch_soft_body(soft_body_a, size * size, 1.2);
+		stretch_soft_body(soft_body_b, size * size, 1.2);
+		const real_t stretched_length = get_grid_edge_length(soft_body_a, size);
+		soft_body_a->solve_constraints(delta, true);
+		soft_body_b->solve_constraints(delta, false);
+
+		// Both orders pull the stretched grid back towards its rest shape.
+		const real_t rest_length = size * (size - 1);
+		const real_t parallel_length = get_grid_edge_length(soft_body_a, size);
+		const real_t serial_length = get_grid_edge_length(soft_body_b, size);
+		CHECK(Math::is_finite(parallel_length));
+		CHECK(parallel_length < stretched_length);
+		CHECK(parallel_length > rest_length * 0.9);
+		CHECK(serial_length < stretched_length);
+
+		memdelete(soft_body_a);
+		memdelete(soft_body_b);
+		RS::get_singleton()->free(mesh);
+	}
+}
+
+} // namespace TestGodotPhysicsServer3D
+
+#endif // TEST_GODOT_PHYSICS_SERVER_3D_H
@@ -31,11 +31,22 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/engine.h"
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
+#include "scene/resources/navigation_mesh.h"
+#include "scene/resources/navigation_mesh_source_geometry_data_3d.h"
 #include "servers/navigation_server_3d.h"
 
 #include "tests/test_macros.h"
 
 namespace TestNavigationServer3D {
+static int64_t path_query_batch_callback_id = 0;
+
+static void path_query_batch_callback(int64_t p_batch_id) {
+	path_query_batch_callback_id = p_batch_id;
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -108,6 +119,7 @@ TEST_SUITE("[Navigation]") {
 			navigation_server->map_set_cell_size(map, 0.55);
 			navigation_server->map_set_edge_connection_margin(map, 0.66);
 			navigation_server->map_set_link_connection_radius(map, 0.77);
+			navigation_server->map_set_path_cluster_size(map, 0.88);
 			navigation_server->map_set_up(map, Vector3(1, 0, 0));
 			bool initial_use_edge_connections = navigation_server->map_get_use_edge_connections(map);
 			navigation_server->map_set_use_edge_connections(map, !initial_use_edge_connections);
@@ -115,6 +127,7 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(navigation_server->map_get_cell_size(map), doctest::Approx(0.55));
 			CHECK_EQ(navigation_server->map_get_edge_connection_margin(map), doctest::Approx(0.66));
 			CHECK_EQ(navigation_server->map_get_link_connection_radius(map), doctest::Approx(0.77));
+			CHECK_EQ(navigation_server->map_get_path_cluster_size(map), doctest::Approx(0.88));
 			CHECK_EQ(navigation_server->map_get_up(map), Vector3(1, 0, 0));
 			CHECK_EQ(navigation_server->map_get_use_edge_connections(map), !initial_use_edge_connections);
 		}
@@ -144,6 +157,520 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to actually remove map.
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer3D] Server should answer map queries across regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		vertices.push_back(Vector3(0, 0, 0));
+		vertices.push_back(Vector3(10, 0, 0));
+		vertices.push_back(Vector3(10, 0, 10));
+		vertices.push_back(Vector3(0, 0, 10));
+		navigation_mesh->set_vertices(vertices);
+		Vector<int> polygon;
+		polygon.push_back(0);
+		polygon.push_back(1);
+		polygon.push_back(2);
+		polygon.push_back(3);
+		navigation_mesh->add_polygon(polygon);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID region_a = navigation_server->region_create();
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh);
+		RID region_b = navigation_server->region_create();
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(10, 0, 0)));
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Closest point queries should find the nearest region") {
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(5, 3, 5)).is_equal_approx(Vector3(5, 0, 5)));
+			CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(5, 3, 5)), region_a);
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(25, 3, 5)).is_equal_approx(Vector3(20, 0, 5)));
+			CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(25, 3, 5)), region_b);
+			CHECK(navigation_server->map_get_closest_point_normal(map, Vector3(15, 3, 5)).abs().is_equal_approx(Vector3(0, 1, 0)));
+		}
+
+		SUBCASE("Segment queries should use the nearest intersection") {
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(15, 5, 5), Vector3(15, -5, 5), true).is_equal_approx(Vector3(15, 0, 5)));
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(-5, 5, 5), Vector3(-5, 1, 5)).is_equal_approx(Vector3(0, 0, 5)));
+		}
+
+		SUBCASE("Paths should cross connected regions") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(19, 0, 5), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(Vector3(1, 0, 5)));
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(19, 0, 5)));
+
+			navigation_server->region_set_navigation_layers(region_b, 2);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(19, 0, 5), true, 1);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(10, 0, 5)));
+		}
+
+		SUBCASE("Paths should cross connected path clusters") {
+			navigation_server->map_set_path_cluster_size(map, 5.0);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(19, 0, 5), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(Vector3(1, 0, 5)));
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(19, 0, 5)));
+
+			navigation_server->region_set_navigation_layers(region_b, 2);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(19, 0, 5), true, 1);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(10, 0, 5)));
+		}
+
+		SUBCASE("Path query batches should match single path queries") {
+			// Completed batches are reported through the message queue.
+			MessageQueue *message_queue = MessageQueue::get_singleton() ? nullptr : memnew(MessageQueue);
+
+			TypedArray<NavigationPathQueryParameters3D> parameters;
+			TypedArray<NavigationPathQueryResult3D> results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(1, 0, 1 + i * 0.5));
+				query_parameters->set_target_position(Vector3(19, 0, 9 - i * 0.5));
+				parameters.push_back(query_parameters);
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				results.push_back(query_result);
+			}
+
+			path_query_batch_callback_id = 0;
+			int64_t batch_id = navigation_server->query_path_batch(parameters, results, callable_mp_static(&path_query_batch_callback));
+			CHECK_GT(batch_id, 0);
+			navigation_server->wait_for_path_query_batch_completion(batch_id);
+			CHECK(navigation_server->is_path_query_batch_completed(batch_id));
+			CHECK_MESSAGE(path_query_batch_callback_id == batch_id, "Waiting for a batch should call its callback.");
+
+			for (int i = 0; i < parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> expected_result;
+				expected_result.instantiate();
+				navigation_server->query_path(parameters[i], expected_result);
+				const Ref<NavigationPathQueryResult3D> query_result = results[i];
+				CHECK_GE(query_result->get_path().size(), 2);
+				CHECK(query_result->get_path() == expected_result->get_path());
+			}
+
+			// Without waiting, the callback is called from the message queue.
+			path_query_batch_callback_id = 0;
+			batch_id = navigation_server->query_path_batch(parameters, results, callable_mp_static(&path_query_batch_callback));
+			navigation_server->process(0.0); // Processing must not wait for the batch or invalidate it.
+			for (int i = 0; i < 5000 && path_query_batch_callback_id != batch_id; i++) {
+				OS::get_singleton()->delay_usec(1000);
+				MessageQueue::get_singleton()->flush();
+			}
+			CHECK(navigation_server->is_path_query_batch_completed(batch_id));
+			CHECK_MESSAGE(path_query_batch_callback_id == batch_id, "Completed batches should call their callback.");
+			const Ref<NavigationPathQueryResult3D> last_result = results[results.size() - 1];
+			CHECK(last_result->get_path()[last_result->get_path().size() - 1].is_equal_approx(Vector3(19, 0, 1.5)));
+
+			// Mismatched arrays are rejected.
+			ERR_PRINT_OFF;
+			CHECK_EQ(navigation_server->query_path_batch(parameters, TypedArray<NavigationPathQueryResult3D>()), 0);
+			ERR_PRINT_ON;
+
+			if (message_queue) {
+				message_queue->flush();
+				memdelete(message_queue);
+			}
+		}
+
+		navigation_server->free(region_b);
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Links should connect to polygons within the connection radius") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		vertices.push_back(Vector3(0, 0, 0));
+		vertices.push_back(Vector3(10, 0, 0));
+		vertices.push_back(Vector3(10, 0, 10));
+		vertices.push_back(Vector3(0, 0, 10));
+		navigation_mesh->set_vertices(vertices);
+		Vector<int> polygon;
+		polygon.push_back(0);
+		polygon.push_back(1);
+		polygon.push_back(2);
+		polygon.push_back(3);
+		navigation_mesh->add_polygon(polygon);
+
+		// Two regions with a gap between them, the link ends are exactly 1 above a corner of each region.
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID region_a = navigation_server->region_create();
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh);
+		RID region_b = navigation_server->region_create();
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(20, 0, 0)));
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh);
+		RID link = navigation_server->link_create();
+		navigation_server->link_set_map(link, map);
+		navigation_server->link_set_start_position(link, Vector3(0, 1, 0));
+		navigation_server->link_set_end_position(link, Vector3(20, 1, 0));
+
+		SUBCASE("Polygons at the connection radius should connect") {
+			navigation_server->map_set_link_connection_radius(map, 1.0);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(5, 0, 5), Vector3(25, 0, 5), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(25, 0, 5)));
+		}
+
+		SUBCASE("Polygons beyond the connection radius should not connect") {
+			navigation_server->map_set_link_connection_radius(map, 0.99);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(5, 0, 5), Vector3(25, 0, 5), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(10, 0, 5)));
+		}
+
+		navigation_server->free(link);
+		navigation_server->free(region_b);
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Path clusters should restrict path queries to the cluster route") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Start and end rooms joined by two corridors of the same length. The southern one is the shortest
+		// path, but it belongs to a region with a large room attached that moves its cluster center away.
+		const Vector3 polygons[][6] = {
+			{ Vector3(0, 0, 50), Vector3(10, 0, 50), Vector3(10, 0, 52), Vector3(10, 0, 58), Vector3(10, 0, 60), Vector3(0, 0, 60) },
+			{ Vector3(30, 0, 50), Vector3(40, 0, 50), Vector3(40, 0, 60), Vector3(30, 0, 60), Vector3(30, 0, 58), Vector3(30, 0, 52) },
+			{ Vector3(10, 0, 50), Vector3(30, 0, 50), Vector3(30, 0, 52), Vector3(10, 0, 52) },
+			{ Vector3(10, 0, 0), Vector3(30, 0, 0), Vector3(30, 0, 50), Vector3(10, 0, 50) },
+			{ Vector3(10, 0, 58), Vector3(30, 0, 58), Vector3(30, 0, 60), Vector3(10, 0, 60) },
+			{ Vector3(60, 0, 50), Vector3(70, 0, 50), Vector3(70, 0, 60), Vector3(60, 0, 60) },
+		};
+		const int polygon_sizes[] = { 6, 6, 4, 4, 4, 4 };
+		// Start room, end room, southern corridor with its room, northern corridor, unreachable room.
+		const int region_polygons[][2] = { { 0, 1 }, { 1, 2 }, { 2, 4 }, { 4, 5 }, { 5, 6 } };
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID regions[5];
+		for (int i = 0; i < 5; i++) {
+			Ref<NavigationMesh> navigation_mesh;
+			navigation_mesh.instantiate();
+			Vector<Vector3> vertices;
+			for (int j = region_polygons[i][0]; j < region_polygons[i][1]; j++) {
+				Vector<int> polygon;
+				for (int k = 0; k < polygon_sizes[j]; k++) {
+					polygon.push_back(vertices.size());
+					vertices.push_back(polygons[j][k]);
+				}
+				navigation_mesh->add_polygon(polygon);
+			}
+			navigation_mesh->set_vertices(vertices);
+
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start = Vector3(9, 0, 51);
+		const Vector3 end = Vector3(31, 0, 51);
+		const Vector3 unreachable_end = Vector3(65, 0, 59);
+
+		Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(end));
+		for (int i = 0; i < path.size(); i++) {
+			CHECK_MESSAGE(path[i].z < 52.1, "Without clusters the path should take the southern corridor.");
+		}
+		const Vector<Vector3> unreachable_path = navigation_server->map_get_path(map, start, unreachable_end, true);
+		REQUIRE_GE(unreachable_path.size(), 2);
+		CHECK(unreachable_path[unreachable_path.size() - 1].is_equal_approx(Vector3(40, 0, 59)));
+
+		// A single cluster cell, so each region is one cluster.
+		navigation_server->map_set_path_cluster_size(map, 1000.0);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths should follow the cluster route") {
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(start));
+			CHECK(path[path.size() - 1].is_equal_approx(end));
+			bool uses_northern_corridor = false;
+			for (int i = 0; i < path.size(); i++) {
+				uses_northern_corridor = uses_northern_corridor || path[i].z > 57.9;
+			}
+			CHECK_MESSAGE(uses_northern_corridor, "The northern corridor's cluster is the closest one, the path should be restricted to it.");
+		}
+
+		SUBCASE("Paths should fall back to the full search when there is no cluster route") {
+			path = navigation_server->map_get_path(map, start, unreachable_end, true);
+			CHECK(path == unreachable_path);
+		}
+
+		SUBCASE("Paths inside one cluster should not use the cluster route") {
+			path = navigation_server->map_get_path(map, Vector3(1, 0, 51), Vector3(9, 0, 59), true);
+			REQUIRE_EQ(path.size(), 2);
+			CHECK(path[1].is_equal_approx(Vector3(9, 0, 59)));
+		}
+
+		for (int i = 0; i < 5; i++) {
+			navigation_server->free(regions[i]);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Paths should take shortcuts through already visited polygons") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Irregular triangles where the search visits a polygon through a long way around before
+		// a shorter way to it is found, so its path must be updated after it was visited.
+		const Vector3 triangles[][3] = {
+			{ Vector3(5.4, 0, 4.0), Vector3(0.0, 0, 3.2), Vector3(0.6, 0, 0.0) },
+			{ Vector3(4.0, 0, 0.0), Vector3(5.4, 0, 4.0), Vector3(0.6, 0, 0.0) },
+			{ Vector3(3.1, 0, 7.2), Vector3(0.0, 0, 8.7), Vector3(0.0, 0, 3.2) },
+			{ Vector3(5.4, 0, 4.0), Vector3(3.1, 0, 7.2), Vector3(0.0, 0, 3.2) },
+			{ Vector3(8.0, 0, 9.4), Vector3(3.1, 0, 7.2), Vector3(5.4, 0, 4.0) },
+			{ Vector3(9.3, 0, 2.6), Vector3(8.0, 0, 9.4), Vector3(5.4, 0, 4.0) },
+			{ Vector3(11.0, 0, 2.6), Vector3(9.3, 0, 2.6), Vector3(8.0, 0, -1.2) },
+			{ Vector3(12.0, 0, 0.7), Vector3(11.0, 0, 2.6), Vector3(8.0, 0, -1.2) },
+			{ Vector3(11.0, 0, 2.6), Vector3(8.0, 0, 9.4), Vector3(9.3, 0, 2.6) },
+			{ Vector3(11.0, 0, 2.6), Vector3(13.0, 0, 8.0), Vector3(8.0, 0, 9.4) },
+			{ Vector3(17.1, 0, 4.7), Vector3(11.0, 0, 2.6), Vector3(12.0, 0, 0.7) },
+			{ Vector3(15.1, 0, 0.7), Vector3(17.1, 0, 4.7), Vector3(12.0, 0, 0.7) },
+			{ Vector3(16.0, 0, 7.4), Vector3(13.0, 0, 8.0), Vector3(11.0, 0, 2.6) },
+			{ Vector3(17.1, 0, 4.7), Vector3(16.0, 0, 7.4), Vector3(11.0, 0, 2.6) },
+		};
+
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		for (int i = 0; i < 14; i++) {
+			Vector<int> polygon;
+			for (int j = 0; j < 3; j++) {
+				int index = vertices.find(triangles[i][j]);
+				if (index == -1) {
+					index = vertices.size();
+					vertices.push_back(triangles[i][j]);
+				}
+				polygon.push_back(index);
+			}
+			navigation_mesh->add_polygon(polygon);
+		}
+		navigation_mesh->set_vertices(vertices);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID region = navigation_server->region_create();
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// The edge midpoints of the path found by the A* search before it used a heap.
+		const Vector3 expected_path[] = {
+			Vector3(14.73, 0, 2.03),
+			Vector3(14.55, 0, 2.7),
+			Vector3(11.5, 0, 1.65),
+			Vector3(9.5, 0, 0.7),
+			Vector3(10.15, 0, 2.6),
+			Vector3(8.65, 0, 6.0),
+			Vector3(6.7, 0, 6.7),
+			Vector3(5.5, 0, 6.87),
+		};
+		const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(14.73, 0, 2.03), Vector3(5.5, 0, 6.87), false);
+		REQUIRE_EQ(path.size(), 8);
+		for (int i = 0; i < 8; i++) {
+			CHECK(path[i].is_equal_approx(expected_path[i]));
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Region edge connections should follow region changes") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// The left edge of the region B is slanted, it is close enough to the right edge of the region A
+		// for A to connect to B, but not for B to connect to A.
+		// The thin region C is merged with A, the region D is only close enough to A once C is removed.
+		const Vector3 polygons[][4] = {
+			{ Vector3(0, 0, 0), Vector3(10, 0, 0), Vector3(10, 0, 10), Vector3(0, 0, 10) },
+			{ Vector3(10.25, 0, 0), Vector3(20, 0, 0), Vector3(20, 0, 8), Vector3(11, 0, 8) },
+			{ Vector3(10, 0, 0), Vector3(10.5, 0, 0), Vector3(10.5, 0, 10), Vector3(10, 0, 10) },
+			{ Vector3(10.75, 0, 0), Vector3(20, 0, 0), Vector3(20, 0, 10), Vector3(10.75, 0, 10) },
+		};
+		Ref<NavigationMesh> navigation_meshes[4];
+		for (int i = 0; i < 4; i++) {
+			navigation_meshes[i].instantiate();
+			Vector<Vector3> vertices;
+			Vector<int> polygon;
+			for (int j = 0; j < 4; j++) {
+				polygon.push_back(j);
+				vertices.push_back(polygons[i][j]);
+			}
+			navigation_meshes[i]->set_vertices(vertices);
+			navigation_meshes[i]->add_polygon(polygon);
+		}
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_edge_connection_margin(map, 1.0);
+		RID region_a = navigation_server->region_create();
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_meshes[0]);
+
+		SUBCASE("Edge connections should only be added in the directions within the margin") {
+			RID region_b = navigation_server->region_create();
+			navigation_server->region_set_map(region_b, map);
+			navigation_server->region_set_navigation_mesh(region_b, navigation_meshes[1]);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_b), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 1);
+			CHECK(navigation_server->region_get_connection_pathway_start(region_a, 0).is_equal_approx(Vector3(10.5, 0, 8)));
+			CHECK(navigation_server->region_get_connection_pathway_end(region_a, 0).is_equal_approx(Vector3(10.125, 0, 0)));
+
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(5, 0, 5), Vector3(15, 0, 4), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(15, 0, 4)));
+			path = navigation_server->map_get_path(map, Vector3(15, 0, 4), Vector3(5, 0, 5), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK_MESSAGE(path[path.size() - 1].x > 10.2, "The region B is not connected to the region A.");
+
+			SUBCASE("Removing and re-adding a region should update the connections") {
+				navigation_server->region_set_map(region_b, RID());
+				navigation_server->process(0.0); // Give server some cycles to commit.
+				CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+				CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 0);
+
+				navigation_server->region_set_map(region_b, map);
+				navigation_server->process(0.0); // Give server some cycles to commit.
+				CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+				CHECK_EQ(navigation_server->region_get_connections_count(region_b), 0);
+				CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 1);
+			}
+
+			SUBCASE("Changing a region should update the connections") {
+				navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(5, 0, 0)));
+				navigation_server->process(0.0); // Give server some cycles to commit.
+				CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+				CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 0);
+				path = navigation_server->map_get_path(map, Vector3(5, 0, 5), Vector3(20, 0, 4), true);
+				REQUIRE_GE(path.size(), 2);
+				CHECK(path[path.size() - 1].is_equal_approx(Vector3(10, 0, 4)));
+
+				navigation_server->region_set_transform(region_b, Transform3D());
+				navigation_server->process(0.0); // Give server some cycles to commit.
+				CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+				CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 1);
+			}
+
+			navigation_server->free(region_b);
+		}
+
+		SUBCASE("Edges freed by a removed region should connect to the near edges") {
+			RID region_c = navigation_server->region_create();
+			navigation_server->region_set_map(region_c, map);
+			navigation_server->region_set_navigation_mesh(region_c, navigation_meshes[2]);
+			RID region_d = navigation_server->region_create();
+			navigation_server->region_set_map(region_d, map);
+			navigation_server->region_set_navigation_mesh(region_d, navigation_meshes[3]);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(5, 0, 5), Vector3(15, 0, 5), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(15, 0, 5)));
+
+			navigation_server->region_set_map(region_c, RID());
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_d), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 2);
+			path = navigation_server->map_get_path(map, Vector3(5, 0, 5), Vector3(15, 0, 5), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(15, 0, 5)));
+
+			navigation_server->region_set_map(region_c, map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+
+			navigation_server->free(region_d);
+			navigation_server->free(region_c);
+		}
+
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Baked navigation mesh tiles should connect") {
+		Object *navigation_mesh_generator = Engine::get_singleton()->get_singleton_object("NavigationMeshGenerator");
+		if (navigation_mesh_generator == nullptr) {
+			return;
+		}
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+		source_geometry_data.instantiate();
+		PackedVector3Array faces;
+		faces.push_back(Vector3(0, 0, 0));
+		faces.push_back(Vector3(20, 0, 0));
+		faces.push_back(Vector3(20, 0, 10));
+		faces.push_back(Vector3(0, 0, 0));
+		faces.push_back(Vector3(20, 0, 10));
+		faces.push_back(Vector3(0, 0, 10));
+		source_geometry_data->add_faces(faces, Transform3D());
+
+		TypedArray<NavigationMesh> tiles;
+		for (int i = 0; i < 2; i++) {
+			Ref<NavigationMesh> tile;
+			tile.instantiate();
+			tile->set_filter_baking_aabb(AABB(Vector3(i * 10, -1, 0), Vector3(10, 2, 10)));
+			tile->set_border_size(1.0);
+			tiles.push_back(tile);
+		}
+		navigation_mesh_generator->call("bake_tiles_from_source_geometry_data", tiles, source_geometry_data);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID regions[2];
+		for (int i = 0; i < 2; i++) {
+			Ref<NavigationMesh> tile = tiles[i];
+			CHECK_GT(tile->get_polygon_count(), 0);
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_navigation_mesh(regions[i], tile);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(19, 0, 5), true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK_LT(path[path.size() - 1].distance_to(Vector3(19, 0, 5)), 0.5);
+
+		navigation_server->free(regions[1]);
+		navigation_server->free(regions[0]);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
 }
 } //namespace TestNavigationServer3D
 
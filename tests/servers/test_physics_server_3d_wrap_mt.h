@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  test_physics_server_3d_wrap_mt.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_WRAP_MT_H
+#define TEST_PHYSICS_SERVER_3D_WRAP_MT_H
+
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/physics_server_3d_wrap_mt.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3DWrapMT {
+
+TEST_CASE("[PhysicsServer3DWrapMT] Body state should follow the changes made during a step") {
+	PhysicsServer3D *physics_server = memnew(PhysicsServer3DWrapMT(memnew(GodotPhysicsServer3D(true)), true));
+	physics_server->init();
+
+	// First frame, no step was issued yet.
+	physics_server->sync();
+	physics_server->flush_queries();
+	physics_server->end_sync();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID body = physics_server->body_create();
+	physics_server->body_set_space(body, space);
+	physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+
+	const Transform3D transform_1 = Transform3D(Basis(), Vector3(1, 2, 3));
+	const Transform3D transform_2 = Transform3D(Basis(), Vector3(4, 5, 6));
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, transform_1);
+	CHECK_EQ(Transform3D(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform_1);
+
+	// The state kept after this step is read without waiting for the server thread.
+	physics_server->step(1.0 / 60.0);
+	physics_server->sync();
+	CHECK_EQ(Transform3D(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform_1);
+	physics_server->end_sync();
+
+	// Changed while the step is running, the state kept after this step is outdated.
+	physics_server->step(1.0 / 60.0);
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, transform_2);
+	physics_server->sync();
+	CHECK_EQ(Transform3D(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform_2);
+	physics_server->end_sync();
+
+	physics_server->step(1.0 / 60.0);
+	physics_server->sync();
+	CHECK_EQ(Transform3D(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform_2);
+	physics_server->end_sync();
+
+	// Freed while the step is running, the state kept after this step must not be returned.
+	physics_server->step(1.0 / 60.0);
+	physics_server->free(body);
+	physics_server->sync();
+	ERR_PRINT_OFF;
+	CHECK_EQ(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM).get_type(), Variant::NIL);
+	ERR_PRINT_ON;
+	physics_server->end_sync();
+
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+class DirectStateWriter : public Object {
+	GDCLASS(DirectStateWriter, Object);
+
+public:
+	Transform3D transform;
+	int call_count = 0;
+
+	void write(PhysicsDirectBodyState3D *p_state) {
+		p_state->set_transform(transform);
+		call_count++;
+	}
+};
+
+TEST_CASE("[PhysicsServer3DWrapMT] Body state should follow the changes made through direct states") {
+	PhysicsServer3D *physics_server = memnew(PhysicsServer3DWrapMT(memnew(GodotPhysicsServer3D(true)), true));
+	physics_server->init();
+
+	physics_server->sync();
+	physics_server->flush_queries();
+	physics_server->end_sync();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID body = physics_server->body_create();
+	physics_server->body_set_space(body, space);
+	physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+	physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(1, 0, 0));
+
+	const Transform3D transform_1 = Transform3D(Basis(), Vector3(1, 2, 3));
+	const Transform3D transform_2 = Transform3D(Basis(), Vector3(4, 5, 6));
+
+	SUBCASE("Direct state requested from the main thread") {
+		physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		physics_server->step(1.0 / 60.0);
+		physics_server->sync();
+		physics_server->flush_queries();
+		// Kept after the step.
+		physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+
+		physics_server->body_get_direct_state(body)->set_transform(transform_1);
+		CHECK_EQ(Transform3D(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform_1);
+		physics_server->end_sync();
+	}
+
+	SUBCASE("Direct state passed to the force integration callback") {
+		DirectStateWriter writer;
+		writer.transform = transform_2;
+		physics_server->body_set_force_integration_callback(body, callable_mp(&writer, &DirectStateWriter::write));
+
+		for (int i = 0; i < 3; i++) {
+			physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+			physics_server->step(1.0 / 60.0);
+			physics_server->sync();
+			physics_server->flush_queries();
+			physics_server->end_sync();
+		}
+
+		REQUIRE(writer.call_count > 0);
+		CHECK_EQ(Transform3D(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform_2);
+
+		physics_server->body_set_force_integration_callback(body, Callable());
+	}
+
+	physics_server->free(body);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+} // namespace TestPhysicsServer3DWrapMT
+
+#endif // TEST_PHYSICS_SERVER_3D_WRAP_MT_H
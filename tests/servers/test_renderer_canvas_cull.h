@@ -0,0 +1,191 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/dummy/rasterizer_canvas_dummy.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+// Keeps the items the canvas renderer is asked to draw, in order.
+class CanvasRenderRecorder : public RasterizerCanvasDummy {
+public:
+	LocalVector<const RendererCanvasRender::Item *> items;
+
+	void canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, Light *p_directional_list, const Transform2D &p_canvas_transform, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, bool &r_sdf_used) override {
+		for (const Item *ci = p_item_list; ci; ci = ci->next) {
+			items.push_back(ci);
+		}
+		r_sdf_used = false;
+	}
+};
+
+static RID create_item(RID p_parent, const Vector2 &p_position) {
+	RenderingServer *rendering_server = RS::get_singleton();
+	RID item = rendering_server->canvas_item_create();
+	rendering_server->canvas_item_set_parent(item, p_parent);
+	rendering_server->canvas_item_set_transform(item, Transform2D(0, p_position));
+	rendering_server->canvas_item_add_rect(item, Rect2(0, 0, 10, 10), Color(1, 1, 1));
+	return item;
+}
+
+// Adds a parent whose children are all drawn in the same z layers, with some of them hidden, off screen or drawn behind it,
+// and a y-sorted parent whose children are in reverse order of their y position. Both have enough children to be culled in parallel.
+static void create_items(RID p_canvas, RID p_mesh, LocalVector<RID> &r_items) {
+	RenderingServer *rendering_server = RS::get_singleton();
+	const int child_count = 600;
+
+	RID parent = create_item(p_canvas, Vector2());
+	r_items.push_back(parent);
+	for (int i = 0; i < child_count; i++) {
+		Vector2 position = (i % 11 == 0) ? Vector2(5000, 0) : Vector2((i % 50) * 10, (i / 50) * 10);
+		RID child = create_item(parent, position);
+		rendering_server->canvas_item_set_z_index(child, i % 5 - 2);
+		rendering_server->canvas_item_set_visible(child, i % 7 != 0);
+		rendering_server->canvas_item_set_draw_behind_parent(child, i % 13 == 0);
+		if (i % 17 == 0) {
+			// The rect of these items reads the mesh storage each time.
+			rendering_server->canvas_item_add_mesh(child, p_mesh);
+			rendering_server->canvas_item_set_update_when_visible(child, true);
+		}
+		r_items.push_back(child);
+
+		if (i % 100 == 0) {
+			RID grandchild = create_item(child, Vector2(1, 1));
+			rendering_server->canvas_item_set_z_index(grandchild, 1);
+			r_items.push_back(grandchild);
+		}
+	}
+
+	RID ysort_parent = create_item(p_canvas, Vector2(500, 0));
+	rendering_server->canvas_item_set_sort_children_by_y(ysort_parent, true);
+	r_items.push_back(ysort_parent);
+	for (int i = 0; i < child_count; i++) {
+		RID child = create_item(ysort_parent, Vector2((i % 40) * 10, (child_count - i) * 1.5));
+		rendering_server->canvas_item_set_z_index(child, i % 3 - 1);
+		r_items.push_back(child);
+	}
+}
+
+// Indices in `p_items` of the items drawn for the canvas, in draw order.
+static LocalVector<int> render_canvas(RID p_canvas, const LocalVector<RID> &p_items) {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+
+	HashMap<const RendererCanvasRender::Item *, int> item_indices;
+	for (uint32_t i = 0; i < p_items.size(); i++) {
+		item_indices[canvas_cull->canvas_item_owner.get_or_null(p_items[i])] = i;
+	}
+
+	RendererCanvasRender *canvas_render = RSG::canvas_render;
+	RendererCanvasRender *canvas_render_singleton = RendererCanvasRender::singleton;
+	CanvasRenderRecorder recorder;
+	RSG::canvas_render = &recorder;
+
+	RendererCanvasCull::Canvas *canvas = canvas_cull->canvas_owner.get_or_null(p_canvas);
+	canvas_cull->render_canvas(RID(), canvas, Transform2D(), nullptr, nullptr, Rect2(0, 0, 1000, 1000), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, false, false, 0xffffffff);
+
+	RSG::canvas_render = canvas_render;
+	RendererCanvasRender::singleton = canvas_render_singleton;
+
+	LocalVector<int> drawn;
+	for (const RendererCanvasRender::Item *item : recorder.items) {
+		const int *index = item_indices.getptr(item);
+		drawn.push_back(index ? *index : -1);
+	}
+	return drawn;
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Culling in parallel should keep the serial draw order") {
+	RenderingServer *rendering_server = RS::get_singleton();
+	RID mesh = rendering_server->mesh_create();
+
+	// The sibling lists of the parents are culled in parallel, as there are only two items at the top level.
+	RID canvas = rendering_server->canvas_create();
+	LocalVector<RID> items;
+	create_items(canvas, mesh, items);
+
+	// The top level is culled in parallel instead, so the same parents are culled serially on the worker threads.
+	// The extra items have nothing to draw.
+	RID threaded_canvas = rendering_server->canvas_create();
+	LocalVector<RID> threaded_items;
+	create_items(threaded_canvas, mesh, threaded_items);
+	for (int i = 0; i < 300; i++) {
+		RID empty = rendering_server->canvas_item_create();
+		rendering_server->canvas_item_set_parent(empty, threaded_canvas);
+		threaded_items.push_back(empty);
+	}
+
+	LocalVector<int> drawn = render_canvas(canvas, items);
+	LocalVector<int> threaded_drawn = render_canvas(threaded_canvas, threaded_items);
+
+	REQUIRE(drawn.size() > 0);
+	CHECK_MESSAGE(drawn.find(-1) == -1, "Only the items of the canvas should be drawn.");
+	CHECK_MESSAGE(drawn.size() < items.size(), "Hidden and off screen items shouldn't be drawn.");
+
+	REQUIRE(drawn.size() == threaded_drawn.size());
+	bool same_order = true;
+	for (uint32_t i = 0; i < drawn.size(); i++) {
+		if (drawn[i] != threaded_drawn[i]) {
+			same_order = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(same_order, "Items should be drawn in the same order whichever sibling list is culled in parallel.");
+
+	// Drawing again gives the same order.
+	LocalVector<int> drawn_again = render_canvas(canvas, items);
+	REQUIRE(drawn_again.size() == drawn.size());
+	for (uint32_t i = 0; i < drawn.size(); i++) {
+		if (drawn_again[i] != drawn[i]) {
+			same_order = false;
+			break;
+		}
+	}
+	CHECK(same_order);
+
+	for (const RID &item : items) {
+		rendering_server->free(item);
+	}
+	for (const RID &item : threaded_items) {
+		rendering_server->free(item);
+	}
+	rendering_server->free(canvas);
+	rendering_server->free(threaded_canvas);
+	rendering_server->free(mesh);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
@@ -0,0 +1,206 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering/storage/render_scene_buffers.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+// Instance of size 1 centered on `p_position`, the meshes of the dummy renderer have no AABB of their own.
+static RID create_instance(RID p_mesh, RID p_scenario, const Vector3 &p_position, uint32_t p_layer_mask = 1) {
+	RenderingServer *rendering_server = RS::get_singleton();
+	RID instance = rendering_server->instance_create2(p_mesh, p_scenario);
+	rendering_server->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+	rendering_server->instance_set_transform(instance, Transform3D(Basis(), p_position));
+	rendering_server->instance_set_layer_mask(instance, p_layer_mask);
+	return instance;
+}
+
+// Number of geometry instances the camera would draw.
+static int cull_camera(RID p_camera, RID p_scenario) {
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	scene_cull->update_dirty_instances();
+
+	Ref<RenderSceneBuffers> render_buffers;
+	render_buffers.instantiate();
+	Ref<XRInterface> xr_interface;
+	scene_cull->render_camera(render_buffers, p_camera, p_scenario, RID(), Size2(100, 100), false, 0.0, RID(), xr_interface, nullptr);
+	return scene_cull->scene_cull_result.geometry_instances.size();
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Camera culling should keep the instances in the frustum and layers") {
+	RenderingServer *rendering_server = RS::get_singleton();
+	RID scenario = rendering_server->scenario_create();
+	RID mesh = rendering_server->mesh_create();
+	// Looking towards -Z from the origin.
+	RID camera = rendering_server->camera_create();
+	rendering_server->camera_set_perspective(camera, 90.0, 0.1, 100.0);
+	rendering_server->camera_set_transform(camera, Transform3D());
+
+	LocalVector<RID> instances;
+
+	SUBCASE("Instances should be kept in front of the camera only") {
+		instances.push_back(create_instance(mesh, scenario, Vector3(0, 0, -10)));
+		instances.push_back(create_instance(mesh, scenario, Vector3(5, 0, -10)));
+		instances.push_back(create_instance(mesh, scenario, Vector3(0, 0, 10)));
+		instances.push_back(create_instance(mesh, scenario, Vector3(50, 0, -10)));
+		instances.push_back(create_instance(mesh, scenario, Vector3(0, 0, -200)));
+		CHECK_EQ(cull_camera(camera, scenario), 2);
+	}
+
+	SUBCASE("Instances crossing the frustum planes should be kept") {
+		// Straddling the near plane and the right plane.
+		instances.push_back(create_instance(mesh, scenario, Vector3(0, 0, 0)));
+		instances.push_back(create_instance(mesh, scenario, Vector3(10.4, 0, -10)));
+		CHECK_EQ(cull_camera(camera, scenario), 2);
+	}
+
+	SUBCASE("Instances should be kept on the visible layers only") {
+		instances.push_back(create_instance(mesh, scenario, Vector3(0, 0, -10), 1));
+		instances.push_back(create_instance(mesh, scenario, Vector3(0, 0, -10), 2));
+		instances.push_back(create_instance(mesh, scenario, Vector3(0, 0, -10), 3));
+		CHECK_EQ(cull_camera(camera, scenario), 3);
+
+		rendering_server->camera_set_cull_mask(camera, 2);
+		CHECK_EQ(cull_camera(camera, scenario), 2);
+	}
+
+	SUBCASE("Instances ignoring culling should always be kept") {
+		RID instance = create_instance(mesh, scenario, Vector3(0, 0, 10));
+		instances.push_back(instance);
+		CHECK_EQ(cull_camera(camera, scenario), 0);
+
+		rendering_server->instance_set_ignore_culling(instance, true);
+		CHECK_EQ(cull_camera(camera, scenario), 1);
+	}
+
+	SUBCASE("Every block of instances should be culled the same") {
+		// Enough instances for several blocks, alternating in front of and behind the camera.
+		const int instance_count = RendererSceneCull::CULL_BLOCK_SIZE * 3 + 7;
+		for (int i = 0; i < instance_count; i++) {
+			instances.push_back(create_instance(mesh, scenario, Vector3((i % 11) - 5, (i % 7) - 3, (i % 2) ? 20 : -20)));
+		}
+		CHECK_EQ(cull_camera(camera, scenario), (instance_count + 1) / 2);
+
+		// Hiding some of the visible ones.
+		for (int i = 0; i < instance_count; i += 4) {
+			rendering_server->instance_set_visible(instances[i], false);
+		}
+		CHECK_EQ(cull_camera(camera, scenario), (instance_count + 1) / 2 - (instance_count + 3) / 4);
+	}
+
+	for (const RID &instance : instances) {
+		rendering_server->free(instance);
+	}
+	rendering_server->free(camera);
+	rendering_server->free(mesh);
+	rendering_server->free(scenario);
+}
+
+static bool has_shadow_caster(const LocalVector<RendererSceneCull::Instance *> &p_casters, RendererSceneCull::Instance *p_instance) {
+	for (RendererSceneCull::Instance *caster : p_casters) {
+		if (caster == p_instance) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Shadow casters should be reused until the light is marked dirty") {
+	RenderingServer *rendering_server = RS::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	RID scenario = rendering_server->scenario_create();
+	RID mesh = rendering_server->mesh_create();
+
+	RID inside = create_instance(mesh, scenario, Vector3(0, 0, -10));
+	RID outside = create_instance(mesh, scenario, Vector3(0, 0, 10));
+	scene_cull->update_dirty_instances();
+
+	RendererSceneCull::Scenario *scenario_data = scene_cull->scenario_owner.get_or_null(scenario);
+	RendererSceneCull::Instance *inside_instance = scene_cull->instance_owner.get_or_null(inside);
+	RendererSceneCull::Instance *outside_instance = scene_cull->instance_owner.get_or_null(outside);
+
+	// A spot shadow frustum looking towards -Z from the origin, with both instances paired with the light.
+	Projection projection;
+	projection.set_perspective(90.0, 1.0, 0.1, 50.0);
+	const Vector<Plane> planes = projection.get_projection_planes(Transform3D());
+	RendererSceneCull::InstanceLightData light;
+	light.geometries.insert(inside_instance);
+	light.geometries.insert(outside_instance);
+
+	const LocalVector<RendererSceneCull::Instance *> &casters = scene_cull->_light_instance_cull_shadow_casters(&light, 0, scenario_data, planes);
+	CHECK_EQ(casters.size(), 1u);
+	CHECK(has_shadow_caster(casters, inside_instance));
+	CHECK_FALSE(light.shadow_casters_unpaired);
+
+	SUBCASE("Clean lights should reuse the previous casters") {
+		// As left by _light_instance_update_shadow() once every pass is done.
+		light.shadow_casters_dirty = false;
+
+		RID added = create_instance(mesh, scenario, Vector3(1, 0, -10));
+		scene_cull->update_dirty_instances();
+		const LocalVector<RendererSceneCull::Instance *> &cached_casters = scene_cull->_light_instance_cull_shadow_casters(&light, 0, scenario_data, planes);
+		CHECK_EQ(cached_casters.size(), 1u);
+
+		light.shadow_casters_dirty = true;
+		const LocalVector<RendererSceneCull::Instance *> &new_casters = scene_cull->_light_instance_cull_shadow_casters(&light, 0, scenario_data, planes);
+		CHECK_EQ(new_casters.size(), 2u);
+		CHECK(has_shadow_caster(new_casters, scene_cull->instance_owner.get_or_null(added)));
+		// Not paired with the light, so it must not be kept.
+		CHECK(light.shadow_casters_unpaired);
+
+		rendering_server->free(added);
+	}
+
+	SUBCASE("Each pass should keep its own casters") {
+		const Vector<Plane> back_planes = projection.get_projection_planes(Transform3D(Basis(Vector3(0, 1, 0), Math_PI), Vector3()));
+		const LocalVector<RendererSceneCull::Instance *> &back_casters = scene_cull->_light_instance_cull_shadow_casters(&light, 1, scenario_data, back_planes);
+		CHECK_EQ(back_casters.size(), 1u);
+		CHECK(has_shadow_caster(back_casters, outside_instance));
+
+		CHECK_EQ(light.shadow_casters[0].size(), 1u);
+		CHECK(has_shadow_caster(light.shadow_casters[0], inside_instance));
+	}
+
+	rendering_server->free(inside);
+	rendering_server->free(outside);
+	rendering_server->free(mesh);
+	rendering_server->free(scenario);
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H